@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+#include <ciel/circular_buffer.hpp>
+#include <ciel/inplace_circular_buffer.hpp>
+#include <cstddef>
+#include <deque>
+
+// A sliding window which keeps the last N samples. 1024 takes the mask path, 1000 doesn't.
+
+template<size_t N>
+static void circular_buffer_push_back(benchmark::State& state) {
+    ciel::circular_buffer<int> b(N);
+
+    int i = 0;
+    for (auto _ : state) {
+        b.push_back(i++);
+        benchmark::DoNotOptimize(b.back());
+    }
+}
+
+template<size_t N>
+static void inplace_circular_buffer_push_back(benchmark::State& state) {
+    ciel::inplace_circular_buffer<int, N> b;
+
+    int i = 0;
+    for (auto _ : state) {
+        b.push_back(i++);
+        benchmark::DoNotOptimize(b.back());
+    }
+}
+
+template<size_t N>
+static void std_deque_push_back(benchmark::State& state) {
+    std::deque<int> d;
+
+    int i = 0;
+    for (auto _ : state) {
+        if (d.size() == N) {
+            d.pop_front();
+        }
+        d.push_back(i++);
+        benchmark::DoNotOptimize(d.back());
+    }
+}
+
+BENCHMARK(circular_buffer_push_back<1024>);
+BENCHMARK(circular_buffer_push_back<1000>);
+BENCHMARK(inplace_circular_buffer_push_back<1024>);
+BENCHMARK(inplace_circular_buffer_push_back<1000>);
+BENCHMARK(std_deque_push_back<1024>);
+BENCHMARK(std_deque_push_back<1000>);
+
+// Sums a wrapped around window, by index, by iterator, and by the two spans.
+
+template<size_t N>
+static ciel::circular_buffer<int> make_window() {
+    ciel::circular_buffer<int> res(N);
+    for (size_t i = 0; i < N + N / 2; ++i) {
+        res.push_back(static_cast<int>(i));
+    }
+
+    return res;
+}
+
+template<size_t N>
+static void circular_buffer_index(benchmark::State& state) {
+    const auto b = make_window<N>();
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            sum += b[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<size_t N>
+static void circular_buffer_iterate(benchmark::State& state) {
+    const auto b = make_window<N>();
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (const int value : b) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<size_t N>
+static void circular_buffer_two_spans(benchmark::State& state) {
+    const auto b = make_window<N>();
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (const int value : b.array_one()) {
+            sum += value;
+        }
+        for (const int value : b.array_two()) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<size_t N>
+static void std_deque_iterate(benchmark::State& state) {
+    std::deque<int> d;
+    for (size_t i = N / 2; i < N + N / 2; ++i) {
+        d.push_back(static_cast<int>(i));
+    }
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (const int value : d) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(circular_buffer_index<1024>);
+BENCHMARK(circular_buffer_index<1000>);
+BENCHMARK(circular_buffer_iterate<1024>);
+BENCHMARK(circular_buffer_iterate<1000>);
+BENCHMARK(circular_buffer_two_spans<1024>);
+BENCHMARK(circular_buffer_two_spans<1000>);
+BENCHMARK(std_deque_iterate<1024>);
+BENCHMARK(std_deque_iterate<1000>);
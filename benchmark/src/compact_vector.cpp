@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <ciel/compact_vector.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+
+// emplace_back and iteration, where the 32-bit size and capacity should cost nothing.
+
+template<class Container>
+static void bench_emplace_back_impl(benchmark::State& state) {
+    for (auto _ : state) {
+        Container v;
+
+        for (int i = 0; i < state.range(0); ++i) {
+            v.emplace_back(i);
+        }
+
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+static void compact_vector_emplace_back(benchmark::State& state) {
+    bench_emplace_back_impl<ciel::compact_vector<int>>(state);
+}
+
+static void vector_emplace_back(benchmark::State& state) {
+    bench_emplace_back_impl<ciel::vector<int>>(state);
+}
+
+BENCHMARK(compact_vector_emplace_back)->Arg(16)->Arg(1000)->Arg(100000);
+BENCHMARK(vector_emplace_back)->Arg(16)->Arg(1000)->Arg(100000);
+
+template<class Container>
+static void bench_iterate_impl(benchmark::State& state) {
+    Container v;
+    for (int i = 0; i < state.range(0); ++i) {
+        v.emplace_back(i);
+    }
+
+    for (auto _ : state) {
+        int sum = 0;
+        for (const int value : v) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+static void compact_vector_iterate(benchmark::State& state) {
+    bench_iterate_impl<ciel::compact_vector<int>>(state);
+}
+
+static void vector_iterate(benchmark::State& state) {
+    bench_iterate_impl<ciel::vector<int>>(state);
+}
+
+BENCHMARK(compact_vector_iterate)->Arg(16)->Arg(100000);
+BENCHMARK(vector_iterate)->Arg(16)->Arg(100000);
+
+// 1M tiny vectors, where the header dominates the memory footprint.
+
+template<class Container>
+static void bench_many_small_impl(benchmark::State& state) {
+    constexpr size_t count = 1 << 20;
+
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        ciel::vector<Container> outer(count);
+
+        for (Container& inner : outer) {
+            for (int i = 0; i < state.range(0); ++i) {
+                inner.emplace_back(i);
+            }
+        }
+
+        bytes = sizeof(Container) * count;
+        for (const Container& inner : outer) {
+            bytes += inner.capacity() * sizeof(int);
+        }
+
+        benchmark::DoNotOptimize(outer.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["bytes_per_vector"] = static_cast<double>(bytes) / count;
+}
+
+static void compact_vector_many_small(benchmark::State& state) {
+    bench_many_small_impl<ciel::compact_vector<int>>(state);
+}
+
+static void vector_many_small(benchmark::State& state) {
+    bench_many_small_impl<ciel::vector<int>>(state);
+}
+
+BENCHMARK(compact_vector_many_small)->Arg(0)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+BENCHMARK(vector_many_small)->Arg(0)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
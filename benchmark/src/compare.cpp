@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/compare.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+
+// operator== and operator< on ciel::vector<int>, bytewise against element by element.
+// The second argument is where the first mismatch is, range(0) meaning equal inputs.
+
+namespace {
+
+struct bench_operands {
+    ciel::vector<int> lhs;
+    ciel::vector<int> rhs;
+
+    explicit bench_operands(const benchmark::State& state)
+        : lhs(static_cast<size_t>(state.range(0)), 1),
+          rhs(lhs) {
+        if (state.range(1) < state.range(0)) {
+            rhs[static_cast<size_t>(state.range(1))] = 2;
+        }
+    }
+
+}; // struct bench_operands
+
+} // namespace
+
+template<bool Bytewise>
+static void bench_equal_impl(benchmark::State& state) {
+    const bench_operands o(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ciel::detail::range_equal(o.lhs, o.rhs, std::integral_constant<bool, Bytewise>{}));
+    }
+}
+
+template<bool Bytewise>
+static void bench_less_impl(benchmark::State& state) {
+    const bench_operands o(state);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ciel::detail::range_less(o.lhs, o.rhs, std::integral_constant<bool, Bytewise>{}));
+    }
+}
+
+static void compare_equal_bytewise(benchmark::State& state) {
+    bench_equal_impl<true>(state);
+}
+
+static void compare_equal_elementwise(benchmark::State& state) {
+    bench_equal_impl<false>(state);
+}
+
+static void compare_less_bytewise(benchmark::State& state) {
+    bench_less_impl<true>(state);
+}
+
+static void compare_less_elementwise(benchmark::State& state) {
+    bench_less_impl<false>(state);
+}
+
+BENCHMARK(compare_equal_bytewise)->Args({16, 16})->Args({1000, 1000})->Args({100000, 100000})->Args({100000, 1});
+BENCHMARK(compare_equal_elementwise)->Args({16, 16})->Args({1000, 1000})->Args({100000, 100000})->Args({100000, 1});
+BENCHMARK(compare_less_bytewise)->Args({16, 16})->Args({1000, 1000})->Args({100000, 100000})->Args({100000, 1});
+BENCHMARK(compare_less_elementwise)->Args({16, 16})->Args({1000, 1000})->Args({100000, 100000})->Args({100000, 1});
+
+// Dedup keys sharing a long prefix by sort and unique.
+
+template<bool Bytewise>
+static void bench_dedup_impl(benchmark::State& state) {
+    using key_type = ciel::vector<uint32_t>;
+
+    std::mt19937 g(42);
+
+    ciel::vector<key_type> keys;
+    for (int i = 0; i < 100000; ++i) {
+        key_type key(32, 7);
+        key.back() = g() % 50000;
+        keys.emplace_back(std::move(key));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ciel::vector<key_type> v(keys);
+        state.ResumeTiming();
+
+        std::sort(v.begin(), v.end(), [](const key_type& lhs, const key_type& rhs) {
+            return ciel::detail::range_less(lhs, rhs, std::integral_constant<bool, Bytewise>{});
+        });
+        const auto it = std::unique(v.begin(), v.end(), [](const key_type& lhs, const key_type& rhs) {
+            return ciel::detail::range_equal(lhs, rhs, std::integral_constant<bool, Bytewise>{});
+        });
+        benchmark::DoNotOptimize(it);
+    }
+}
+
+static void compare_dedup_bytewise(benchmark::State& state) {
+    bench_dedup_impl<true>(state);
+}
+
+static void compare_dedup_elementwise(benchmark::State& state) {
+    bench_dedup_impl<false>(state);
+}
+
+BENCHMARK(compare_dedup_bytewise)->Unit(benchmark::kMillisecond);
+BENCHMARK(compare_dedup_elementwise)->Unit(benchmark::kMillisecond);
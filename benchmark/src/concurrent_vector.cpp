@@ -0,0 +1,113 @@
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <ciel/concurrent_vector.hpp>
+#include <ciel/core/spinlock.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+// Writer threads push 1M elements in total, while one reader keeps scanning what has been published.
+
+namespace {
+
+constexpr size_t total_elements = 1 << 20;
+
+class locked_vector {
+private:
+    ciel::vector<uint64_t> v_;
+    mutable ciel::spinlock lock_;
+
+public:
+    void push_back(const uint64_t value) {
+        with(lock_, [&] {
+            v_.push_back(value);
+        });
+    }
+
+    CIEL_NODISCARD uint64_t sum() const {
+        uint64_t res = 0;
+
+        // Elements may be relocated by writers, so readers have to hold the lock as well.
+        with(lock_, [&] {
+            for (const uint64_t value : v_) {
+                res += value;
+            }
+        });
+
+        return res;
+    }
+
+}; // class locked_vector
+
+class concurrent_vector {
+private:
+    ciel::concurrent_vector<uint64_t> v_;
+
+public:
+    void push_back(const uint64_t value) {
+        v_.push_back(value);
+    }
+
+    CIEL_NODISCARD uint64_t sum() const {
+        uint64_t res = 0;
+
+        for (const uint64_t value : v_) {
+            res += value;
+        }
+
+        return res;
+    }
+
+}; // class concurrent_vector
+
+template<class Container>
+void bench_push_read_impl(benchmark::State& state) {
+    const size_t writers_num = state.range(0);
+    const bool with_reader   = state.range(1) != 0;
+
+    for (auto _ : state) {
+        Container c;
+        std::atomic<bool> done{false};
+
+        std::thread reader([&] {
+            while (with_reader && !done.load(std::memory_order_relaxed)) {
+                benchmark::DoNotOptimize(c.sum());
+            }
+        });
+
+        ciel::vector<std::thread> writers(ciel::reserve_capacity, writers_num);
+        for (size_t i = 0; i < writers_num; ++i) {
+            writers.unchecked_emplace_back([&] {
+                for (size_t j = 0; j < total_elements / writers_num; ++j) {
+                    c.push_back(j);
+                }
+            });
+        }
+
+        for (auto& t : writers) {
+            t.join();
+        }
+
+        done = true;
+        reader.join();
+
+        benchmark::DoNotOptimize(c.sum());
+    }
+
+    state.SetItemsProcessed(state.iterations() * total_elements);
+}
+
+} // namespace
+
+static void concurrent_vector_push(benchmark::State& state) {
+    bench_push_read_impl<concurrent_vector>(state);
+}
+
+static void locked_vector_push(benchmark::State& state) {
+    bench_push_read_impl<locked_vector>(state);
+}
+
+// {writers, with_reader}
+BENCHMARK(concurrent_vector_push)->ArgsProduct({{1, 4}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(locked_vector_push)->ArgsProduct({{1, 4}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/dynamic_bitset.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t bits = 1 << 24;
+
+// Half of the bits set, from a fixed seed.
+template<class Bits>
+Bits make_bits(const unsigned seed) {
+    std::mt19937 g(seed);
+
+    Bits res(bits);
+    for (size_t i = 0; i < bits; ++i) {
+        res[i] = g() & 1;
+    }
+
+    return res;
+}
+
+} // namespace
+
+// count
+
+static void dynamic_bitset_count(benchmark::State& state) {
+    const auto b = make_bits<ciel::dynamic_bitset<>>(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(b.count());
+    }
+}
+
+static void std_vector_bool_count(benchmark::State& state) {
+    const auto b = make_bits<std::vector<bool>>(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(b.begin(), b.end(), true));
+    }
+}
+
+static void byte_vector_count(benchmark::State& state) {
+    const auto b = make_bits<ciel::vector<uint8_t>>(1);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(b.begin(), b.end(), 1));
+    }
+}
+
+BENCHMARK(dynamic_bitset_count);
+BENCHMARK(std_vector_bool_count);
+BENCHMARK(byte_vector_count);
+
+// a &= ~b, a filter applied to a bitmap
+
+static void dynamic_bitset_and_not(benchmark::State& state) {
+    auto a       = make_bits<ciel::dynamic_bitset<>>(1);
+    const auto b = make_bits<ciel::dynamic_bitset<>>(2);
+
+    for (auto _ : state) {
+        a.and_not(b);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void std_vector_bool_and_not(benchmark::State& state) {
+    auto a       = make_bits<std::vector<bool>>(1);
+    const auto b = make_bits<std::vector<bool>>(2);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < bits; ++i) {
+            a[i] = a[i] && !b[i];
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+static void byte_vector_and_not(benchmark::State& state) {
+    auto a       = make_bits<ciel::vector<uint8_t>>(1);
+    const auto b = make_bits<ciel::vector<uint8_t>>(2);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < bits; ++i) {
+            a[i] &= ~b[i] & 1;
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(dynamic_bitset_and_not);
+BENCHMARK(std_vector_bool_and_not);
+BENCHMARK(byte_vector_and_not);
+
+// rank and select, with and without the index
+
+static void dynamic_bitset_select(benchmark::State& state) {
+    const auto b      = make_bits<ciel::dynamic_bitset<>>(1);
+    const size_t ones = b.count();
+
+    size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(b.select(k));
+        k = (k + 104729) % ones;
+    }
+}
+
+static void bitset_rank_index_select(benchmark::State& state) {
+    const auto b = make_bits<ciel::dynamic_bitset<>>(1);
+    const ciel::bitset_rank_index<> index(b);
+    const size_t ones = index.count();
+
+    size_t k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.select(k));
+        k = (k + 104729) % ones;
+    }
+}
+
+static void bitset_rank_index_rank(benchmark::State& state) {
+    const auto b = make_bits<ciel::dynamic_bitset<>>(1);
+    const ciel::bitset_rank_index<> index(b);
+
+    size_t pos = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.rank(pos));
+        pos = (pos + 104729) % bits;
+    }
+}
+
+BENCHMARK(dynamic_bitset_select);
+BENCHMARK(bitset_rank_index_select);
+BENCHMARK(bitset_rank_index_rank);
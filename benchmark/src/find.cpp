@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/find.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Search for the last element, so that the whole range is scanned.
+// 16 KiB fits in L1 cache, 64 MiB is memory-resident.
+
+template<class T>
+static ciel::vector<T> make_haystack(const size_t bytes) {
+    ciel::vector<T> v(bytes / sizeof(T), T(1));
+    v.back() = T(2);
+    return v;
+}
+
+template<class T>
+static void bench_find_std_impl(benchmark::State& state) {
+    const auto v = make_haystack<T>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(v.begin(), v.end(), T(2)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template<class T>
+static void bench_find_ciel_impl(benchmark::State& state) {
+    const auto v = make_haystack<T>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ciel::find(v, T(2)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template<class T>
+static void bench_count_std_impl(benchmark::State& state) {
+    const auto v = make_haystack<T>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(v.begin(), v.end(), T(2)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template<class T>
+static void bench_count_ciel_impl(benchmark::State& state) {
+    const auto v = make_haystack<T>(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ciel::count(v, T(2)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void find_char_std(benchmark::State& state) {
+    bench_find_std_impl<char>(state);
+}
+
+static void find_char_ciel(benchmark::State& state) {
+    bench_find_ciel_impl<char>(state);
+}
+
+static void find_uint32_std(benchmark::State& state) {
+    bench_find_std_impl<uint32_t>(state);
+}
+
+static void find_uint32_ciel(benchmark::State& state) {
+    bench_find_ciel_impl<uint32_t>(state);
+}
+
+static void count_uint32_std(benchmark::State& state) {
+    bench_count_std_impl<uint32_t>(state);
+}
+
+static void count_uint32_ciel(benchmark::State& state) {
+    bench_count_ciel_impl<uint32_t>(state);
+}
+
+BENCHMARK(find_char_std)->Arg(16 << 10)->Arg(64 << 20);
+BENCHMARK(find_char_ciel)->Arg(16 << 10)->Arg(64 << 20);
+BENCHMARK(find_uint32_std)->Arg(16 << 10)->Arg(64 << 20);
+BENCHMARK(find_uint32_ciel)->Arg(16 << 10)->Arg(64 << 20);
+BENCHMARK(count_uint32_std)->Arg(16 << 10)->Arg(64 << 20);
+BENCHMARK(count_uint32_ciel)->Arg(16 << 10)->Arg(64 << 20);
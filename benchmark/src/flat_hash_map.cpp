@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/flat_hash_map.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+// Unique random keys in random order.
+ciel::vector<uint64_t> make_keys(const size_t n) {
+    std::mt19937_64 g(42);
+
+    ciel::vector<uint64_t> res(ciel::reserve_capacity, n);
+    for (size_t i = 0; i < n; ++i) {
+        res.unchecked_emplace_back(i * 2654435761u);
+    }
+
+    std::shuffle(res.begin(), res.end(), g);
+    return res;
+}
+
+template<class Map>
+void bench_insert(benchmark::State& state) {
+    const auto keys = make_keys(state.range(0));
+
+    for (auto _ : state) {
+        Map m;
+        for (const uint64_t key : keys) {
+            m.emplace(key, key);
+        }
+
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+template<class Map>
+void bench_find(benchmark::State& state) {
+    const auto keys = make_keys(state.range(0));
+
+    Map m;
+    for (const uint64_t key : keys) {
+        m.emplace(key, key);
+    }
+
+    // Half of the lookups miss.
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(keys[i] + (i & 1)) != m.end());
+
+        if (++i == keys.size()) {
+            i = 0;
+        }
+    }
+}
+
+template<class Map>
+void bench_erase(benchmark::State& state) {
+    const auto keys = make_keys(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Map m;
+        for (const uint64_t key : keys) {
+            m.emplace(key, key);
+        }
+        state.ResumeTiming();
+
+        for (const uint64_t key : keys) {
+            m.erase(key);
+        }
+
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+using flat_map_type = ciel::flat_hash_map<uint64_t, uint64_t>;
+using std_map_type  = std::unordered_map<uint64_t, uint64_t>;
+
+} // namespace
+
+static void flat_hash_map_insert(benchmark::State& state) {
+    bench_insert<flat_map_type>(state);
+}
+
+static void std_unordered_map_insert(benchmark::State& state) {
+    bench_insert<std_map_type>(state);
+}
+
+static void flat_hash_map_find(benchmark::State& state) {
+    bench_find<flat_map_type>(state);
+}
+
+static void std_unordered_map_find(benchmark::State& state) {
+    bench_find<std_map_type>(state);
+}
+
+static void flat_hash_map_erase(benchmark::State& state) {
+    bench_erase<flat_map_type>(state);
+}
+
+static void std_unordered_map_erase(benchmark::State& state) {
+    bench_erase<std_map_type>(state);
+}
+
+BENCHMARK(flat_hash_map_insert)->RangeMultiplier(100)->Range(1000, 100000000);
+BENCHMARK(std_unordered_map_insert)->RangeMultiplier(100)->Range(1000, 100000000);
+BENCHMARK(flat_hash_map_find)->RangeMultiplier(100)->Range(1000, 100000000);
+BENCHMARK(std_unordered_map_find)->RangeMultiplier(100)->Range(1000, 100000000);
+BENCHMARK(flat_hash_map_erase)->RangeMultiplier(100)->Range(1000, 100000000);
+BENCHMARK(std_unordered_map_erase)->RangeMultiplier(100)->Range(1000, 100000000);
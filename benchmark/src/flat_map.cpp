@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/core/avl_tree.hpp>
+#include <ciel/flat_map.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace {
+
+using entry = std::pair<uint64_t, uint64_t>;
+
+struct entry_less {
+    bool operator()(const entry& lhs, const entry& rhs) const noexcept {
+        return lhs.first < rhs.first;
+    }
+
+    bool operator()(const entry& lhs, const uint64_t rhs) const noexcept {
+        return lhs.first < rhs;
+    }
+
+    bool operator()(const uint64_t lhs, const entry& rhs) const noexcept {
+        return lhs < rhs.first;
+    }
+
+}; // struct entry_less
+
+// Unique random keys in random order.
+ciel::vector<entry> make_entries(const size_t n) {
+    std::mt19937_64 g(42);
+
+    ciel::vector<entry> res(ciel::reserve_capacity, n);
+    for (size_t i = 0; i < n; ++i) {
+        res.unchecked_emplace_back(i * 2654435761u, i);
+    }
+
+    std::shuffle(res.begin(), res.end(), g);
+    return res;
+}
+
+struct avl_map {
+    ciel::vector<ciel::avl_node<entry>> nodes;
+    ciel::avl_tree<entry, entry_less> tree;
+
+    explicit avl_map(const ciel::vector<entry>& entries)
+        : nodes(ciel::reserve_capacity, entries.size()) {
+        for (const entry& e : entries) {
+            nodes.unchecked_emplace_back(e);
+            tree.insert_node_unique(&nodes.back());
+        }
+    }
+
+}; // struct avl_map
+
+template<class Lookup>
+void bench_lookup_impl(benchmark::State& state, Lookup&& lookup) {
+    const ciel::vector<entry> entries = make_entries(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lookup(entries[i].first));
+
+        if (++i == entries.size()) {
+            i = 0;
+        }
+    }
+}
+
+} // namespace
+
+// lookup
+
+static void flat_map_lookup(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+    const ciel::flat_map<uint64_t, uint64_t> m(ciel::from_range, entries);
+
+    bench_lookup_impl(state, [&](const uint64_t key) {
+        return m.find(key)->second;
+    });
+}
+
+static void avl_tree_lookup(benchmark::State& state) {
+    const avl_map m(make_entries(state.range(0)));
+
+    bench_lookup_impl(state, [&](const uint64_t key) {
+        return m.tree.find(key)->second;
+    });
+}
+
+static void std_map_lookup(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+    const std::map<uint64_t, uint64_t> m(entries.begin(), entries.end());
+
+    bench_lookup_impl(state, [&](const uint64_t key) {
+        return m.find(key)->second;
+    });
+}
+
+BENCHMARK(flat_map_lookup)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(avl_tree_lookup)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(std_map_lookup)->Arg(1 << 10)->Arg(1 << 20);
+
+// bulk build
+
+static void flat_map_build(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+
+    for (auto _ : state) {
+        ciel::flat_map<uint64_t, uint64_t> m;
+        m.insert_range(entries);
+
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+static void avl_tree_build(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+
+    for (auto _ : state) {
+        avl_map m(entries);
+
+        benchmark::DoNotOptimize(m.tree.size());
+    }
+}
+
+static void std_map_build(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+
+    for (auto _ : state) {
+        std::map<uint64_t, uint64_t> m(entries.begin(), entries.end());
+
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+BENCHMARK(flat_map_build)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(avl_tree_build)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(std_map_build)->Arg(1 << 10)->Arg(1 << 20);
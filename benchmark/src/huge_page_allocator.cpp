@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <ciel/huge_page_allocator.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Random access over a large vector, which is dominated by TLB misses when backed by normal pages.
+
+template<class Allocator>
+static void bench_random_access_impl(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0)) * 1024 * 1024 / sizeof(uint64_t);
+
+    ciel::vector<uint64_t, Allocator> v;
+    v.resize(n, ciel::default_init);
+
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = i;
+    }
+
+    uint64_t x = 88172645463325252ULL;
+    for (auto _ : state) {
+        uint64_t sum = 0;
+
+        for (size_t i = 0; i < 1024 * 1024; ++i) {
+            // xorshift64
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+
+            sum += v[x % n];
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1024 * 1024);
+}
+
+static void huge_page_allocator_random_access_std(benchmark::State& state) {
+    bench_random_access_impl<std::allocator<uint64_t>>(state);
+}
+
+static void huge_page_allocator_random_access_huge(benchmark::State& state) {
+    bench_random_access_impl<ciel::huge_page_allocator<uint64_t>>(state);
+}
+
+// Args are in MiB.
+BENCHMARK(huge_page_allocator_random_access_std)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(huge_page_allocator_random_access_huge)->Arg(4096)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <ciel/inplace_string.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+// Build "user:<id>:<shard>" keys of at most 32 chars and hash them, which is what short key formatting looks like.
+// std::string stays within its SSO capacity of 15 chars for the short prefix, and allocates for the long one.
+
+namespace {
+
+template<class String>
+void append_integer(String& s, const uint64_t value) {
+    s.append_to_chars(value);
+}
+
+void append_integer(std::string& s, const uint64_t value) {
+    char buffer[20];
+    const auto res = std::to_chars(buffer, buffer + 20, value);
+    s.append(buffer, res.ptr);
+}
+
+} // namespace
+
+template<class String>
+static void bench_build_keys_impl(benchmark::State& state, const char* prefix) {
+    for (auto _ : state) {
+        size_t h = 0;
+
+        for (uint64_t id = 0; id < 1000; ++id) {
+            String key(prefix);
+            key += ':';
+            append_integer(key, id * 7919);
+            key += ':';
+            append_integer(key, id % 16);
+
+            h ^= std::hash<String>{}(key);
+        }
+
+        benchmark::DoNotOptimize(h);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+static void inplace_string_build_short_keys(benchmark::State& state) {
+    bench_build_keys_impl<ciel::inplace_string<32>>(state, "u");
+}
+
+static void std_string_build_short_keys(benchmark::State& state) {
+    bench_build_keys_impl<std::string>(state, "u");
+}
+
+static void inplace_string_build_long_keys(benchmark::State& state) {
+    bench_build_keys_impl<ciel::inplace_string<32>>(state, "session_user");
+}
+
+static void std_string_build_long_keys(benchmark::State& state) {
+    bench_build_keys_impl<std::string>(state, "session_user");
+}
+
+BENCHMARK(inplace_string_build_short_keys);
+BENCHMARK(std_string_build_short_keys);
+BENCHMARK(inplace_string_build_long_keys);
+BENCHMARK(std_string_build_long_keys);
+
+// Keep the keys, where std::string's are on the heap once they outgrow SSO.
+
+template<class String>
+static void bench_collect_keys_impl(benchmark::State& state) {
+    for (auto _ : state) {
+        ciel::vector<String> keys;
+        keys.reserve(1000);
+
+        for (uint64_t id = 0; id < 1000; ++id) {
+            String key("session_user");
+            key += ':';
+            append_integer(key, id);
+            keys.emplace_back(std::move(key));
+        }
+
+        benchmark::DoNotOptimize(keys.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+static void inplace_string_collect_keys(benchmark::State& state) {
+    bench_collect_keys_impl<ciel::inplace_string<32>>(state);
+}
+
+static void std_string_collect_keys(benchmark::State& state) {
+    bench_collect_keys_impl<std::string>(state);
+}
+
+BENCHMARK(inplace_string_collect_keys);
+BENCHMARK(std_string_collect_keys);
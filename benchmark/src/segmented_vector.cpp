@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <ciel/segmented_vector.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+// A 64 bytes event.
+struct event {
+    uint64_t data[8];
+};
+
+} // namespace
+
+// push_back
+
+static void segmented_vector_push_back(benchmark::State& state) {
+    for (auto _ : state) {
+        ciel::segmented_vector<event> v;
+
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            v.push_back(event{});
+        }
+
+        benchmark::DoNotOptimize(v.back());
+        benchmark::ClobberMemory();
+    }
+}
+
+static void vector_push_back(benchmark::State& state) {
+    for (auto _ : state) {
+        ciel::vector<event> v;
+
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            v.push_back(event{});
+        }
+
+        benchmark::DoNotOptimize(v.back());
+        benchmark::ClobberMemory();
+    }
+}
+
+static void vector_reserve_push_back(benchmark::State& state) {
+    for (auto _ : state) {
+        ciel::vector<event> v;
+        v.reserve(state.range(0));
+
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            v.push_back(event{});
+        }
+
+        benchmark::DoNotOptimize(v.back());
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK(segmented_vector_push_back)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(vector_push_back)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(vector_reserve_push_back)->Arg(1 << 10)->Arg(1 << 20);
+
+// iterate
+
+template<class Container>
+static void bench_iterate_impl(benchmark::State& state) {
+    Container v;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        v.push_back(event{{static_cast<uint64_t>(i)}});
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const event& e : v) {
+            sum += e.data[0];
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+static void segmented_vector_iterate(benchmark::State& state) {
+    bench_iterate_impl<ciel::segmented_vector<event>>(state);
+}
+
+static void vector_iterate(benchmark::State& state) {
+    bench_iterate_impl<ciel::vector<event>>(state);
+}
+
+BENCHMARK(segmented_vector_iterate)->Arg(1 << 20);
+BENCHMARK(vector_iterate)->Arg(1 << 20);
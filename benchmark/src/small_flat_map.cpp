@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <ciel/small_flat_map.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+// Small maps of uint32_t keys, the inline capacity is 16 so that 64 elements are spilled.
+
+namespace {
+
+using small_map = ciel::small_flat_map<uint32_t, uint32_t, 16>;
+
+// Unique random keys in random order.
+ciel::vector<uint32_t> make_keys(const size_t n) {
+    std::mt19937 g(42);
+
+    ciel::vector<uint32_t> res(ciel::reserve_capacity, n);
+    for (size_t i = 0; i < n; ++i) {
+        res.unchecked_emplace_back(static_cast<uint32_t>(i * 2654435761u));
+    }
+
+    std::shuffle(res.begin(), res.end(), g);
+    return res;
+}
+
+template<class Map>
+void bench_lookup_impl(benchmark::State& state) {
+    const ciel::vector<uint32_t> keys = make_keys(state.range(0));
+
+    Map m;
+    for (const uint32_t key : keys) {
+        m[key] = key;
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(m.find(keys[i])->second);
+
+        if (++i == keys.size()) {
+            i = 0;
+        }
+    }
+}
+
+template<class Map>
+void bench_insert_impl(benchmark::State& state) {
+    const ciel::vector<uint32_t> keys = make_keys(state.range(0));
+
+    for (auto _ : state) {
+        Map m;
+        for (const uint32_t key : keys) {
+            m.try_emplace(key, key);
+        }
+
+        benchmark::DoNotOptimize(m.size());
+    }
+}
+
+} // namespace
+
+// lookup
+
+static void small_flat_map_lookup(benchmark::State& state) {
+    bench_lookup_impl<small_map>(state);
+}
+
+static void small_flat_map_std_map_lookup(benchmark::State& state) {
+    bench_lookup_impl<std::map<uint32_t, uint32_t>>(state);
+}
+
+static void small_flat_map_std_unordered_map_lookup(benchmark::State& state) {
+    bench_lookup_impl<std::unordered_map<uint32_t, uint32_t>>(state);
+}
+
+BENCHMARK(small_flat_map_lookup)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_flat_map_std_map_lookup)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_flat_map_std_unordered_map_lookup)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// insert
+
+static void small_flat_map_insert(benchmark::State& state) {
+    bench_insert_impl<small_map>(state);
+}
+
+static void small_flat_map_std_map_insert(benchmark::State& state) {
+    bench_insert_impl<std::map<uint32_t, uint32_t>>(state);
+}
+
+static void small_flat_map_std_unordered_map_insert(benchmark::State& state) {
+    bench_insert_impl<std::unordered_map<uint32_t, uint32_t>>(state);
+}
+
+BENCHMARK(small_flat_map_insert)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_flat_map_std_map_insert)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_flat_map_std_unordered_map_insert)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
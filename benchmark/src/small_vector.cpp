@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+#include <ciel/small_vector.hpp>
+#include <ciel/vector.hpp>
+#include <vector>
+
+// Build and destroy many short-lived containers, which is where the inline buffer saves an allocation.
+
+template<class Container>
+static void bench_small_build_destroy_impl(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int n = 0; n < 1000; ++n) {
+            Container v;
+
+            for (int i = 0; i < state.range(0); ++i) {
+                v.emplace_back(i);
+            }
+
+            benchmark::DoNotOptimize(v.data());
+        }
+
+        benchmark::ClobberMemory();
+    }
+}
+
+static void small_vector_build_destroy_small(benchmark::State& state) {
+    bench_small_build_destroy_impl<ciel::small_vector<int, 16>>(state);
+}
+
+static void small_vector_build_destroy_ciel(benchmark::State& state) {
+    bench_small_build_destroy_impl<ciel::vector<int>>(state);
+}
+
+static void small_vector_build_destroy_std(benchmark::State& state) {
+    bench_small_build_destroy_impl<std::vector<int>>(state);
+}
+
+BENCHMARK(small_vector_build_destroy_small)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_vector_build_destroy_ciel)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(small_vector_build_destroy_std)->Arg(4)->Arg(16)->Arg(64);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <ciel/soa_vector.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Sum one field of 10M particles.
+
+namespace {
+
+constexpr size_t particle_count = 10000000;
+
+struct particle {
+    double x, y, z;
+    double vx, vy, vz;
+    double mass;
+    uint64_t id;
+};
+
+} // namespace
+
+static void particle_sum_aos(benchmark::State& state) {
+    ciel::vector<particle> v(particle_count, particle{1, 2, 3, 4, 5, 6, 7, 8});
+
+    for (auto _ : state) {
+        double sum = 0;
+        for (const particle& p : v) {
+            sum += p.mass;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * particle_count * sizeof(double));
+}
+
+static void particle_sum_soa(benchmark::State& state) {
+    ciel::soa_vector<double, double, double, double, double, double, double, uint64_t> v;
+    v.reserve(particle_count);
+    for (size_t i = 0; i < particle_count; ++i) {
+        v.emplace_back(1, 2, 3, 4, 5, 6, 7, 8);
+    }
+
+    for (auto _ : state) {
+        double sum = 0;
+        for (const double mass : v.column<6>()) {
+            sum += mass;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * particle_count * sizeof(double));
+}
+
+BENCHMARK(particle_sum_aos);
+BENCHMARK(particle_sum_soa);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <ciel/string.hpp>
+#include <ciel/vector.hpp>
+#include <cstddef>
+#include <string>
+
+// ciel::vector<String> regrowth and front insertion, where every element is relocated.
+// ciel::string is trivially relocatable and moves with memcpy, libstdc++'s std::string is moved one by one.
+// range(0) is the length of each string, 8 is inline for both, 40 is on the heap for both.
+
+template<class String>
+static void bench_regrow_impl(benchmark::State& state) {
+    const String value(static_cast<size_t>(state.range(0)), 'x');
+
+    for (auto _ : state) {
+        ciel::vector<String> v;
+
+        for (size_t i = 0; i < 10000; ++i) {
+            v.emplace_back(value);
+        }
+
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+static void string_regrow(benchmark::State& state) {
+    bench_regrow_impl<ciel::string>(state);
+}
+
+static void std_string_regrow(benchmark::State& state) {
+    bench_regrow_impl<std::string>(state);
+}
+
+BENCHMARK(string_regrow)->Arg(8)->Arg(40);
+BENCHMARK(std_string_regrow)->Arg(8)->Arg(40);
+
+template<class String>
+static void bench_insert_front_impl(benchmark::State& state) {
+    const String value(static_cast<size_t>(state.range(0)), 'x');
+
+    for (auto _ : state) {
+        ciel::vector<String> v;
+        v.reserve(1000);
+
+        for (size_t i = 0; i < 1000; ++i) {
+            v.emplace(v.begin(), value);
+        }
+
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+
+static void string_insert_front(benchmark::State& state) {
+    bench_insert_front_impl<ciel::string>(state);
+}
+
+static void std_string_insert_front(benchmark::State& state) {
+    bench_insert_front_impl<std::string>(state);
+}
+
+BENCHMARK(string_insert_front)->Arg(8)->Arg(40);
+BENCHMARK(std_string_insert_front)->Arg(8)->Arg(40);
+
+// Appending chars one at a time, which compares the growth of the strings themselves.
+
+template<class String>
+static void bench_push_back_impl(benchmark::State& state) {
+    for (auto _ : state) {
+        String s;
+
+        for (int i = 0; i < state.range(0); ++i) {
+            s.push_back('x');
+        }
+
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+
+static void string_push_back(benchmark::State& state) {
+    bench_push_back_impl<ciel::string>(state);
+}
+
+static void std_string_push_back(benchmark::State& state) {
+    bench_push_back_impl<std::string>(state);
+}
+
+BENCHMARK(string_push_back)->Arg(16)->Arg(1000);
+BENCHMARK(std_string_push_back)->Arg(16)->Arg(1000);
@@ -1,8 +1,14 @@
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <ciel/core/exchange.hpp>
 #include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/growth_policy.hpp>
+#include <ciel/malloc_allocator.hpp>
+#include <ciel/parallel_policy.hpp>
 #include <ciel/vector.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace {
@@ -31,8 +37,55 @@ public:
         delete ptr;
     }
 
+    int get() const noexcept {
+        return *ptr;
+    }
+
 }; // class tr
 
+struct allocation_stats {
+    size_t allocations = 0;
+    size_t live_bytes  = 0;
+    size_t peak_bytes  = 0;
+
+}; // struct allocation_stats
+
+allocation_stats stats;
+
+template<class T>
+class counting_allocator {
+public:
+    using value_type = T;
+
+    counting_allocator() = default;
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>&) noexcept {}
+
+    T* allocate(const size_t n) {
+        ++stats.allocations;
+        stats.live_bytes += n * sizeof(T);
+        stats.peak_bytes = std::max(stats.peak_bytes, stats.live_bytes);
+
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, const size_t n) noexcept {
+        stats.live_bytes -= n * sizeof(T);
+
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept {
+        return true;
+    }
+
+    friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept {
+        return false;
+    }
+
+}; // class counting_allocator
+
 } // namespace
 
 template<>
@@ -77,6 +130,19 @@ BENCHMARK(vector_int_emplace_back_std)->Arg(10000);
 BENCHMARK(vector_tr_emplace_back_ciel)->Arg(10000);
 BENCHMARK(vector_tr_emplace_back_std)->Arg(10000);
 
+// Expansions through realloc may extend the block in place or remap its pages instead of copying them.
+
+static void vector_int_emplace_back_realloc(benchmark::State& state) {
+    bench_emplace_back_impl<ciel::vector<int, ciel::malloc_allocator<int>>>(state);
+}
+
+static void vector_int_emplace_back_no_realloc(benchmark::State& state) {
+    bench_emplace_back_impl<ciel::vector<int>>(state);
+}
+
+BENCHMARK(vector_int_emplace_back_realloc)->Arg(10000)->Arg(10000000);
+BENCHMARK(vector_int_emplace_back_no_realloc)->Arg(10000)->Arg(10000000);
+
 // insert
 
 template<class Container>
@@ -128,6 +194,51 @@ BENCHMARK(vector_int_insert_std)->Arg(1000);
 BENCHMARK(vector_tr_insert_ciel)->Arg(1000);
 BENCHMARK(vector_tr_insert_std)->Arg(1000);
 
+// insert_batch: insert 1000 values evenly into range(0) elements.
+
+template<class Insert>
+static void bench_insert_batch_impl(benchmark::State& state, Insert insert) {
+    const size_t n = state.range(0);
+    const size_t k = 1000;
+
+    ciel::vector<size_t> positions;
+    ciel::vector<int> values;
+    for (size_t i = 0; i < k; ++i) {
+        positions.emplace_back(i * n / k);
+        values.emplace_back(static_cast<int>(i));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ciel::vector<int> v(n, 0);
+        state.ResumeTiming();
+
+        insert(v, positions, values);
+
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+static void vector_int_insert_batch(benchmark::State& state) {
+    bench_insert_batch_impl(state, [](ciel::vector<int>& v, const ciel::vector<size_t>& positions,
+                                      const ciel::vector<int>& values) {
+        v.insert_batch(positions, values);
+    });
+}
+
+static void vector_int_insert_one_by_one(benchmark::State& state) {
+    bench_insert_batch_impl(state, [](ciel::vector<int>& v, const ciel::vector<size_t>& positions,
+                                      const ciel::vector<int>& values) {
+        for (size_t i = positions.size(); i > 0; --i) {
+            v.insert(v.begin() + positions[i - 1], values[i - 1]);
+        }
+    });
+}
+
+BENCHMARK(vector_int_insert_batch)->Arg(100000)->Arg(1000000);
+BENCHMARK(vector_int_insert_one_by_one)->Arg(100000)->Arg(1000000);
+
 // erase
 
 template<class Container>
@@ -178,3 +289,133 @@ BENCHMARK(vector_int_erase_ciel)->Arg(1000);
 BENCHMARK(vector_int_erase_std)->Arg(1000);
 BENCHMARK(vector_tr_erase_ciel)->Arg(1000);
 BENCHMARK(vector_tr_erase_std)->Arg(1000);
+
+// erase_if
+
+template<class Container, class EraseIf>
+static void bench_erase_if_impl(benchmark::State& state, EraseIf erase_if) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v;
+        v.reserve(state.range(0));
+        for (int i = 0; i < state.range(0); ++i) {
+            v.emplace_back(i);
+        }
+        state.ResumeTiming();
+
+        erase_if(v, [](const tr& t) {
+            return t.get() % 3 == 0;
+        });
+
+        benchmark::DoNotOptimize(v);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void vector_tr_erase_if_ciel(benchmark::State& state) {
+    bench_erase_if_impl<ciel::vector<tr>>(state, [](ciel::vector<tr>& v, auto pred) {
+        ciel::erase_if(v, pred);
+    });
+}
+
+static void vector_tr_unstable_erase_if_ciel(benchmark::State& state) {
+    bench_erase_if_impl<ciel::vector<tr>>(state, [](ciel::vector<tr>& v, auto pred) {
+        v.unstable_erase_if(pred);
+    });
+}
+
+static void vector_tr_erase_if_std(benchmark::State& state) {
+    bench_erase_if_impl<std::vector<tr>>(state, [](std::vector<tr>& v, auto pred) {
+        std::erase_if(v, pred);
+    });
+}
+
+BENCHMARK(vector_tr_erase_if_ciel)->Arg(10000);
+BENCHMARK(vector_tr_unstable_erase_if_ciel)->Arg(10000);
+BENCHMARK(vector_tr_erase_if_std)->Arg(10000);
+
+// parallel_policy
+
+static void vector_parallel_construct_fill(benchmark::State& state) {
+    const size_t n = size_t{1} << 27; // 1 GiB of uint64_t
+
+    for (auto _ : state) {
+        ciel::vector<uint64_t> v(ciel::parallel_policy{static_cast<size_t>(state.range(0))}, n, 42);
+
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * n * sizeof(uint64_t));
+}
+
+static void vector_parallel_construct_copy(benchmark::State& state) {
+    const size_t n = size_t{1} << 27; // 1 GiB of uint64_t
+    const ciel::vector<uint64_t> src(ciel::parallel_policy{}, n, 42);
+
+    for (auto _ : state) {
+        ciel::vector<uint64_t> v(ciel::parallel_policy{static_cast<size_t>(state.range(0))}, src);
+
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * n * sizeof(uint64_t));
+}
+
+BENCHMARK(vector_parallel_construct_fill)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(vector_parallel_construct_copy)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// growth_policy
+
+template<class GrowthPolicy>
+static void bench_growth_policy_impl(benchmark::State& state) {
+    using Container = ciel::vector<int, counting_allocator<int>, GrowthPolicy>;
+
+    stats = allocation_stats{};
+
+    for (auto _ : state) {
+        Container v;
+
+        for (int i = 0; i < state.range(0); ++i) {
+            v.emplace_back(i);
+        }
+
+        benchmark::DoNotOptimize(v);
+        benchmark::ClobberMemory();
+    }
+
+    // Each iteration starts from an empty vector, so the first allocation is not a reallocation.
+    state.counters["reallocations"] =
+        static_cast<double>(stats.allocations) / static_cast<double>(state.iterations()) - 1;
+    state.counters["peak_bytes"]    = static_cast<double>(stats.peak_bytes);
+    state.counters["payload_bytes"] = static_cast<double>(state.range(0) * sizeof(int));
+}
+
+static void vector_growth_policy_2x(benchmark::State& state) {
+    bench_growth_policy_impl<ciel::growth_policy_2x>(state);
+}
+
+static void vector_growth_policy_1_5x(benchmark::State& state) {
+    bench_growth_policy_impl<ciel::growth_policy_1_5x>(state);
+}
+
+static void vector_growth_policy_size_class(benchmark::State& state) {
+    bench_growth_policy_impl<ciel::growth_policy_size_class>(state);
+}
+
+BENCHMARK(vector_growth_policy_2x)->Arg(1000)->Arg(100000)->Arg(10000000);
+BENCHMARK(vector_growth_policy_1_5x)->Arg(1000)->Arg(100000)->Arg(10000000);
+BENCHMARK(vector_growth_policy_size_class)->Arg(1000)->Arg(100000)->Arg(10000000);
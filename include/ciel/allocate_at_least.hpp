@@ -5,11 +5,17 @@
 
 #include <cstddef>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 NAMESPACE_CIEL_BEGIN
 
 #ifdef __cpp_lib_allocate_at_least
 
+template<class Pointer, class SizeType = size_t>
+using allocation_result = std::allocation_result<Pointer, SizeType>;
+
+// std::allocator_traits::allocate_at_least already forwards to Allocator::allocate_at_least if there is one.
 template<class Allocator, class SizeType = typename std::allocator_traits<Allocator>::size_type>
 CIEL_NODISCARD auto allocate_at_least(Allocator& allocator, const SizeType size) {
     return std::allocator_traits<Allocator>::allocate_at_least(allocator, size);
@@ -24,14 +30,52 @@ struct allocation_result {
 
 }; // struct allocation_result
 
+namespace detail {
+
+template<class Allocator, class SizeType, class = void>
+struct allocator_has_allocate_at_least : std::false_type {};
+
+template<class Allocator, class SizeType>
+struct allocator_has_allocate_at_least<
+    Allocator, SizeType, void_t<decltype(std::declval<Allocator&>().allocate_at_least(std::declval<SizeType>()))>>
+    : std::true_type {};
+
+} // namespace detail
+
 template<class Allocator, class Pointer = typename std::allocator_traits<Allocator>::pointer,
-         class SizeType = typename std::allocator_traits<Allocator>::size_type>
+         class SizeType = typename std::allocator_traits<Allocator>::size_type,
+         enable_if_t<detail::allocator_has_allocate_at_least<Allocator, SizeType>::value> = 0>
+CIEL_NODISCARD allocation_result<Pointer, SizeType> allocate_at_least(Allocator& allocator, const SizeType size) {
+    const auto res = allocator.allocate_at_least(size);
+    return {res.ptr, static_cast<SizeType>(res.count)};
+}
+
+template<class Allocator, class Pointer = typename std::allocator_traits<Allocator>::pointer,
+         class SizeType = typename std::allocator_traits<Allocator>::size_type,
+         enable_if_t<!detail::allocator_has_allocate_at_least<Allocator, SizeType>::value> = 0>
 CIEL_NODISCARD allocation_result<Pointer, SizeType> allocate_at_least(Allocator& allocator, const SizeType size) {
     return {std::allocator_traits<Allocator>::allocate(allocator, size), size};
 }
 
 #endif
 
+// allocator_has_reallocate_at_least
+// An opt-in protocol: Allocator::reallocate_at_least(p, old_count, new_count) resizes the block pointed to by p,
+// which has room for old_count objects, to have room for at least new_count objects, like realloc does.
+// new_count may be less than old_count, e.g. on shrink_to_fit.
+// It returns an allocation_result, and throws leaving p untouched on failure.
+// Since the bytes are moved as they are, containers only use it for trivially relocatable objects.
+
+template<class Allocator, class = void>
+struct allocator_has_reallocate_at_least : std::false_type {};
+
+template<class Allocator>
+struct allocator_has_reallocate_at_least<
+    Allocator, void_t<decltype(std::declval<Allocator&>().reallocate_at_least(
+                   std::declval<typename std::allocator_traits<Allocator>::pointer>(),
+                   std::declval<typename std::allocator_traits<Allocator>::size_type>(),
+                   std::declval<typename std::allocator_traits<Allocator>::size_type>()))>> : std::true_type {};
+
 NAMESPACE_CIEL_END
 
 #endif // CIELLAB_INCLUDE_CIEL_ALLOCATE_AT_LEAST_HPP_
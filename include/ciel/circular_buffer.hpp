@@ -0,0 +1,584 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CIRCULAR_BUFFER_HPP_
+#define CIELLAB_INCLUDE_CIEL_CIRCULAR_BUFFER_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/logical.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/span.hpp>
+#include <ciel/to_address.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// circular_buffer
+// A ring buffer whose capacity is fixed at construction, so it never allocates afterwards.
+// push_back on a full buffer overwrites the front element, push_front overwrites the back one,
+// which keeps the last capacity() elements of a stream.
+// Elements occupy at most two contiguous runs, array_one() and array_two(), which can be memcpyed out in order.
+// When the capacity is a power of two, indices wrap around by a mask instead of a comparison.
+
+template<class Buffer, class Reference>
+class circular_buffer_iterator : public random_access_iterator_base<circular_buffer_iterator<Buffer, Reference>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = typename Buffer::value_type;
+    using pointer           = remove_reference_t<Reference>*;
+    using reference         = Reference;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+
+private:
+    Buffer* buf_{nullptr};
+    size_t index_{0};
+
+public:
+    circular_buffer_iterator() = default;
+
+    circular_buffer_iterator(Buffer* buf, const size_t index) noexcept
+        : buf_(buf), index_(index) {}
+
+    template<class B, class R, enable_if_t<std::is_convertible<B*, Buffer*>::value> = 0>
+    circular_buffer_iterator(const circular_buffer_iterator<B, R>& other) noexcept
+        : buf_(other.base()), index_(other.index()) {}
+
+    void go_next() noexcept {
+        ++index_;
+    }
+
+    void go_prev() noexcept {
+        --index_;
+    }
+
+    void advance(const difference_type n) noexcept {
+        index_ += n;
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        CIEL_ASSERT(buf_ != nullptr);
+
+        return (*buf_)[index_];
+    }
+
+    CIEL_NODISCARD pointer operator->() const noexcept {
+        return std::addressof(**this);
+    }
+
+    CIEL_NODISCARD reference operator[](const difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    CIEL_NODISCARD Buffer* base() const noexcept {
+        return buf_;
+    }
+
+    CIEL_NODISCARD size_t index() const noexcept {
+        return index_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const circular_buffer_iterator& lhs,
+                                          const circular_buffer_iterator& rhs) noexcept {
+        return lhs.index() == rhs.index();
+    }
+
+    CIEL_NODISCARD friend bool operator<(const circular_buffer_iterator& lhs,
+                                         const circular_buffer_iterator& rhs) noexcept {
+        return lhs.index() < rhs.index();
+    }
+
+    CIEL_NODISCARD friend circular_buffer_iterator operator+(circular_buffer_iterator iter,
+                                                             const difference_type n) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend circular_buffer_iterator operator+(const difference_type n,
+                                                             circular_buffer_iterator iter) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend circular_buffer_iterator operator-(circular_buffer_iterator iter,
+                                                             const difference_type n) noexcept {
+        iter -= n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend difference_type operator-(const circular_buffer_iterator& lhs,
+                                                    const circular_buffer_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index() - rhs.index());
+    }
+
+}; // class circular_buffer_iterator
+
+template<class T, class Allocator = std::allocator<T>>
+class circular_buffer {
+    static_assert(std::is_same<typename Allocator::value_type, T>::value, "");
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer          = typename std::allocator_traits<allocator_type>::const_pointer;
+    using iterator               = circular_buffer_iterator<circular_buffer, reference>;
+    using const_iterator         = circular_buffer_iterator<const circular_buffer, const_reference>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    pointer begin_{nullptr};
+    size_type head_{0};
+    size_type size_{0};
+    size_type capacity_{0};
+    // capacity_ - 1 when capacity_ is a power of two, 0 otherwise.
+    compressed_pair<size_type, allocator_type> mask_alloc_;
+
+    size_type& mask_() noexcept {
+        return mask_alloc_.first();
+    }
+
+    const size_type& mask_() const noexcept {
+        return mask_alloc_.first();
+    }
+
+    allocator_type& allocator_() noexcept {
+        return mask_alloc_.second();
+    }
+
+    const allocator_type& allocator_() const noexcept {
+        return mask_alloc_.second();
+    }
+
+    // i < capacity_ * 2
+    CIEL_NODISCARD size_type wrap(const size_type i) const noexcept {
+        CIEL_ASSERT(i < capacity_ * 2);
+
+        if (mask_() != 0) {
+            return i & mask_();
+        }
+
+        return i >= capacity_ ? i - capacity_ : i;
+    }
+
+    CIEL_NODISCARD size_type physical(const size_type pos) const noexcept {
+        return wrap(head_ + pos);
+    }
+
+    void allocate(const size_type cap) {
+        CIEL_ASSERT(begin_ == nullptr);
+
+        if (cap != 0) {
+            begin_ = alloc_traits::allocate(allocator_(), cap);
+        }
+
+        capacity_ = cap;
+        mask_()   = (cap != 0 && (cap & (cap - 1)) == 0) ? cap - 1 : 0;
+    }
+
+    void destroy_and_deallocate() noexcept {
+        clear();
+
+        if (begin_ != nullptr) {
+            alloc_traits::deallocate(allocator_(), begin_, capacity_);
+            begin_ = nullptr;
+        }
+
+        capacity_ = 0;
+        mask_()   = 0;
+    }
+
+    // Elements of other in order, starting from slot 0.
+    void construct_from(const circular_buffer& other) {
+        CIEL_ASSERT(empty());
+        CIEL_ASSERT(capacity_ >= other.size());
+
+        head_ = 0;
+
+        for (const value_type& value : other) {
+            alloc_traits::construct(allocator_(), ciel::to_address(begin_ + size_), value);
+            ++size_;
+        }
+    }
+
+    void steal(circular_buffer& other) noexcept {
+        begin_    = ciel::exchange(other.begin_, nullptr);
+        head_     = ciel::exchange(other.head_, 0);
+        size_     = ciel::exchange(other.size_, 0);
+        capacity_ = ciel::exchange(other.capacity_, 0);
+        mask_()   = ciel::exchange(other.mask_(), 0);
+    }
+
+    void move_assign(circular_buffer& other, std::true_type) noexcept {
+        destroy_and_deallocate();
+
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            allocator_() = std::move(other.allocator_());
+        }
+
+        steal(other);
+    }
+
+    void move_assign(circular_buffer& other, std::false_type) {
+        if (allocator_() == other.allocator_()) {
+            move_assign(other, std::true_type{});
+            return;
+        }
+
+        if (capacity_ != other.capacity_) {
+            destroy_and_deallocate();
+            allocate(other.capacity_);
+
+        } else {
+            clear();
+        }
+
+        head_ = 0;
+
+        for (value_type& value : other) {
+            alloc_traits::construct(allocator_(), ciel::to_address(begin_ + size_), std::move(value));
+            ++size_;
+        }
+    }
+
+    void swap_alloc(circular_buffer& other, std::true_type) noexcept {
+        using std::swap;
+        swap(allocator_(), other.allocator_());
+    }
+
+    void swap_alloc(circular_buffer&, std::false_type) noexcept {}
+
+public:
+    circular_buffer() = default;
+
+    explicit circular_buffer(const allocator_type& alloc) noexcept
+        : mask_alloc_(0, alloc) {}
+
+    explicit circular_buffer(const size_type capacity, const allocator_type& alloc = allocator_type())
+        : mask_alloc_(0, alloc) {
+        allocate(capacity);
+    }
+
+    circular_buffer(const size_type capacity, const size_type count, const value_type& value,
+                    const allocator_type& alloc = allocator_type())
+        : circular_buffer(capacity, alloc) {
+        CIEL_ASSERT(count <= capacity);
+
+        for (size_type i = 0; i < count; ++i) {
+            push_back(value);
+        }
+    }
+
+    circular_buffer(const circular_buffer& other)
+        : circular_buffer(other.capacity_, alloc_traits::select_on_container_copy_construction(other.allocator_())) {
+        construct_from(other);
+    }
+
+    circular_buffer(circular_buffer&& other) noexcept
+        : mask_alloc_(0, std::move(other.allocator_())) {
+        steal(other);
+    }
+
+    circular_buffer& operator=(const circular_buffer& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        const bool propagate =
+            alloc_traits::propagate_on_container_copy_assignment::value && allocator_() != other.allocator_();
+
+        if (propagate || capacity_ != other.capacity_) {
+            destroy_and_deallocate();
+
+            if (propagate) {
+                allocator_() = other.allocator_();
+            }
+
+            allocate(other.capacity_);
+
+        } else {
+            clear();
+        }
+
+        construct_from(other);
+
+        return *this;
+    }
+
+    circular_buffer& operator=(circular_buffer&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        move_assign(other, bool_constant < alloc_traits::propagate_on_container_move_assignment::value
+                                               || alloc_traits::is_always_equal::value > {});
+
+        return *this;
+    }
+
+    ~circular_buffer() {
+        destroy_and_deallocate();
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) noexcept {
+        CIEL_ASSERT(pos < size_);
+
+        return begin_[physical(pos)];
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const noexcept {
+        CIEL_ASSERT(pos < size_);
+
+        return begin_[physical(pos)];
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size_) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::circular_buffer"));
+        }
+
+        return operator[](pos);
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size_) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::circular_buffer"));
+        }
+
+        return operator[](pos);
+    }
+
+    CIEL_NODISCARD reference front() noexcept {
+        return operator[](0);
+    }
+
+    CIEL_NODISCARD const_reference front() const noexcept {
+        return operator[](0);
+    }
+
+    CIEL_NODISCARD reference back() noexcept {
+        return operator[](size_ - 1);
+    }
+
+    CIEL_NODISCARD const_reference back() const noexcept {
+        return operator[](size_ - 1);
+    }
+
+    // The elements are [array_one(), array_two()] in order, array_two() is empty unless they wrap around.
+    CIEL_NODISCARD span<value_type> array_one() noexcept {
+        return span<value_type>(ciel::to_address(begin_) + head_, ciel::min(size_, capacity_ - head_));
+    }
+
+    CIEL_NODISCARD span<const value_type> array_one() const noexcept {
+        return span<const value_type>(ciel::to_address(begin_) + head_, ciel::min(size_, capacity_ - head_));
+    }
+
+    CIEL_NODISCARD span<value_type> array_two() noexcept {
+        return span<value_type>(ciel::to_address(begin_), size_ - ciel::min(size_, capacity_ - head_));
+    }
+
+    CIEL_NODISCARD span<const value_type> array_two() const noexcept {
+        return span<const value_type>(ciel::to_address(begin_), size_ - ciel::min(size_, capacity_ - head_));
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return iterator(this, size_);
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD bool full() const noexcept {
+        return size_ == capacity_;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return alloc_traits::max_size(allocator_());
+    }
+
+    void clear() noexcept {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = 0; i < size_; ++i) {
+                alloc_traits::destroy(allocator_(), ciel::to_address(begin_ + physical(i)));
+            }
+        }
+
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // Overwrites the front element if full. The new element is built first, so args may refer to the front one.
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        CIEL_ASSERT(capacity_ != 0);
+
+        if CIEL_UNLIKELY (full()) {
+            const size_type i = head_;
+            begin_[i]         = value_type(std::forward<Args>(args)...);
+            head_             = wrap(head_ + 1);
+
+            return begin_[i];
+        }
+
+        const size_type i = physical(size_);
+        alloc_traits::construct(allocator_(), ciel::to_address(begin_ + i), std::forward<Args>(args)...);
+        ++size_;
+
+        return begin_[i];
+    }
+
+    void push_back(const value_type& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // Overwrites the back element if full.
+    template<class... Args>
+    reference emplace_front(Args&&... args) {
+        CIEL_ASSERT(capacity_ != 0);
+
+        const size_type i = wrap(head_ + capacity_ - 1);
+
+        if CIEL_UNLIKELY (full()) {
+            begin_[i] = value_type(std::forward<Args>(args)...);
+
+        } else {
+            alloc_traits::construct(allocator_(), ciel::to_address(begin_ + i), std::forward<Args>(args)...);
+            ++size_;
+        }
+
+        head_ = i;
+
+        return begin_[i];
+    }
+
+    void push_front(const value_type& value) {
+        emplace_front(value);
+    }
+
+    void push_front(value_type&& value) {
+        emplace_front(std::move(value));
+    }
+
+    void pop_front() noexcept {
+        CIEL_ASSERT(!empty());
+
+        alloc_traits::destroy(allocator_(), ciel::to_address(begin_ + head_));
+        head_ = wrap(head_ + 1);
+        --size_;
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        alloc_traits::destroy(allocator_(), ciel::to_address(begin_ + physical(size_ - 1)));
+        --size_;
+    }
+
+    void swap(circular_buffer& other) noexcept {
+        using std::swap;
+
+        swap(begin_, other.begin_);
+        swap(head_, other.head_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+        swap(mask_(), other.mask_());
+        swap_alloc(other, typename alloc_traits::propagate_on_container_swap{});
+    }
+
+}; // class circular_buffer
+
+template<class T, class Allocator>
+struct is_trivially_relocatable<circular_buffer<T, Allocator>>
+    : conjunction<is_trivially_relocatable<Allocator>,
+                  is_trivially_relocatable<typename std::allocator_traits<Allocator>::pointer>> {};
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class T, class Allocator>
+void swap(ciel::circular_buffer<T, Allocator>& lhs,
+          ciel::circular_buffer<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_CIRCULAR_BUFFER_HPP_
@@ -0,0 +1,913 @@
+#ifndef CIELLAB_INCLUDE_CIEL_COMPACT_VECTOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_COMPACT_VECTOR_HPP_
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/allocator_traits.hpp>
+#include <ciel/compare.hpp>
+#include <ciel/copy_n.hpp>
+#include <ciel/core/aligned_storage.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/do_if_noexcept.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/growth_policy.hpp>
+#include <ciel/relocate.hpp>
+#include <ciel/split_buffer.hpp>
+#include <ciel/to_address.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// compact_vector
+// A vector of one pointer plus a 32-bit size and a 32-bit capacity, 16 bytes instead of vector's 24,
+// for workloads holding lots of small vectors. max_size() is capped at 2^32 - 1.
+// It expands, inserts and erases through the same relocation paths as vector:
+// memcpy for trivially relocatable types, and Allocator::reallocate_at_least if there is one.
+// Capacities come from the same GrowthPolicy, so both grow alike.
+
+template<class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth_policy_2x>
+class compact_vector {
+    static_assert(std::is_same<typename Allocator::value_type, T>::value, "");
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using growth_policy          = GrowthPolicy;
+    using size_type              = uint32_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer          = typename std::allocator_traits<allocator_type>::const_pointer;
+    using iterator               = pointer;
+    using const_iterator         = const_pointer;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    template<class... Args>
+    using via_trivial_construct =
+        allocator_has_trivial_construct<allocator_type, decltype(ciel::to_address(std::declval<pointer>())), Args...>;
+    using via_trivial_destroy =
+        allocator_has_trivial_destroy<allocator_type, decltype(ciel::to_address(std::declval<pointer>()))>;
+
+    static constexpr bool expand_via_memcpy =
+        is_trivially_relocatable<value_type>::value
+        && via_trivial_construct<decltype(ciel::move_if_noexcept(*std::declval<pointer>()))>::value
+        && via_trivial_destroy::value;
+
+    static constexpr bool expand_via_realloc =
+        expand_via_memcpy && allocator_has_reallocate_at_least<allocator_type>::value;
+
+    static constexpr bool move_via_memmove = is_trivially_relocatable<value_type>::value
+                                          && via_trivial_construct<decltype(std::move(*std::declval<pointer>()))>::value
+                                          && via_trivial_destroy::value;
+
+    pointer begin_{nullptr};
+    size_type size_{0};
+    compressed_pair<size_type, allocator_type> cap_alloc_{0, default_init};
+
+    size_type& cap_() noexcept {
+        return cap_alloc_.first();
+    }
+
+    const size_type& cap_() const noexcept {
+        return cap_alloc_.first();
+    }
+
+    allocator_type& allocator_() noexcept {
+        return cap_alloc_.second();
+    }
+
+    const allocator_type& allocator_() const noexcept {
+        return cap_alloc_.second();
+    }
+
+    CIEL_NODISCARD pointer end_() const noexcept {
+        return begin_ + size_;
+    }
+
+    // allocate_at_least may hand back more than max_size(). Deallocating with any count between
+    // the requested one and the returned one is fine, so the excess is simply never used.
+    CIEL_NODISCARD size_type clamp_cap(const size_t count) const noexcept {
+        return static_cast<size_type>(ciel::min<size_t>(count, max_size()));
+    }
+
+    CIEL_NODISCARD size_type recommend_cap(const size_t new_size) const {
+        CIEL_ASSERT(new_size > 0);
+
+        const size_type ms = max_size();
+
+        if CIEL_UNLIKELY (new_size > ms) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::compact_vector expanding size is beyond max_size"));
+        }
+
+        return static_cast<size_type>(
+            detail::recommend_cap<growth_policy>(capacity(), new_size, ms, sizeof(value_type)));
+    }
+
+    template<class... Args>
+    void construct(pointer p, Args&&... args) {
+        alloc_traits::construct(allocator_(), ciel::to_address(p), std::forward<Args>(args)...);
+    }
+
+    void destroy(pointer p) noexcept {
+        CIEL_ASSERT(begin_ <= p);
+        CIEL_ASSERT(p < end_());
+
+        alloc_traits::destroy(allocator_(), ciel::to_address(p));
+    }
+
+    // Destroy [begin_ + new_size, end_()).
+    void destroy_from(const size_type new_size) noexcept {
+        CIEL_ASSERT(new_size <= size_);
+
+        for (pointer p = begin_ + new_size; p != end_(); ++p) {
+            alloc_traits::destroy(allocator_(), ciel::to_address(p));
+        }
+
+        size_ = new_size;
+    }
+
+    void construct_at_end(const size_type n) {
+        CIEL_ASSERT(size_ + n <= capacity());
+
+        for (size_type i = 0; i < n; ++i) {
+            unchecked_emplace_back();
+        }
+    }
+
+    void construct_at_end(const size_type n, const value_type& value) {
+        CIEL_ASSERT(size_ + n <= capacity());
+
+        for (size_type i = 0; i < n; ++i) {
+            unchecked_emplace_back(value);
+        }
+    }
+
+    template<class Iter>
+    void construct_at_end(Iter first, Iter last) {
+        pointer end = end_();
+
+        CIEL_TRY {
+            ciel::uninitialized_copy(allocator_(), first, last, end);
+        }
+        CIEL_CATCH (...) {
+            // end has been advanced past the constructed ones.
+            size_ = static_cast<size_type>(end - begin_);
+            CIEL_THROW;
+        }
+
+        size_ = static_cast<size_type>(end - begin_);
+    }
+
+    void init(const size_t count) {
+        CIEL_ASSERT(count != 0);
+        CIEL_ASSERT(begin_ == nullptr);
+
+        if CIEL_UNLIKELY (count > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::compact_vector size is beyond max_size"));
+        }
+
+        const auto allocation_res = ciel::allocate_at_least(allocator_(), count);
+
+        begin_ = allocation_res.ptr;
+        size_  = 0;
+        cap_() = clamp_cap(allocation_res.count);
+    }
+
+    void set_nullptr() noexcept {
+        begin_ = nullptr;
+        size_  = 0;
+        cap_() = 0;
+    }
+
+    void do_destroy() noexcept {
+        if (begin_) {
+            clear();
+            alloc_traits::deallocate(allocator_(), begin_, capacity());
+        }
+    }
+
+    void reset() noexcept {
+        do_destroy();
+        set_nullptr();
+    }
+
+    void reset(const size_t count) {
+        CIEL_ASSERT(count != 0);
+
+        do_destroy();
+        set_nullptr(); // It's neccessary since allocation would throw.
+        init(count);
+    }
+
+    void take_buffer(split_buffer<value_type, allocator_type&>& sb) noexcept {
+        begin_ = sb.begin_cap_;
+        size_  = static_cast<size_type>(sb.end_ - sb.begin_cap_);
+        cap_() = clamp_cap(sb.capacity());
+
+        sb.begin_cap_ = nullptr; // enough for split_buffer's destructor
+    }
+
+    void swap_out_buffer(split_buffer<value_type, allocator_type&>&& sb) noexcept(
+        expand_via_memcpy || std::is_nothrow_move_constructible<value_type>::value) {
+        CIEL_ASSERT(sb.front_spare() == size());
+
+        // If either dest or src is an invalid or null pointer, memcpy's behavior is undefined, even if count is zero.
+        if (begin_) {
+            if (expand_via_memcpy) {
+                ciel::uninitialized_relocate(ciel::to_address(begin_), ciel::to_address(end_()),
+                                             ciel::to_address(sb.begin_cap_));
+
+            } else {
+                for (pointer p = end_() - 1; p >= begin_; --p) {
+                    sb.unchecked_emplace_front(ciel::move_if_noexcept(*p));
+                }
+
+                clear();
+            }
+
+            alloc_traits::deallocate(allocator_(), begin_, capacity());
+        }
+
+        take_buffer(sb);
+    }
+
+    void swap_out_buffer(split_buffer<value_type, allocator_type&>&& sb,
+                         pointer pos) noexcept(expand_via_memcpy
+                                               || std::is_nothrow_move_constructible<value_type>::value) {
+        if (begin_) {
+            const size_t front_count = pos - begin_;
+            const size_t back_count  = end_() - pos;
+
+            CIEL_ASSERT(sb.front_spare() == front_count);
+            CIEL_ASSERT(sb.back_spare() >= back_count);
+
+            if (expand_via_memcpy) {
+                ciel::uninitialized_relocate(ciel::to_address(begin_), ciel::to_address(pos),
+                                             ciel::to_address(sb.begin_cap_));
+
+                ciel::uninitialized_relocate(ciel::to_address(pos), ciel::to_address(end_()),
+                                             ciel::to_address(sb.end_));
+                sb.end_ += back_count;
+
+            } else {
+                for (pointer p = pos - 1; p >= begin_; --p) {
+                    sb.unchecked_emplace_front(ciel::move_if_noexcept(*p));
+                }
+
+                for (pointer p = pos; p < end_(); ++p) {
+                    sb.unchecked_emplace_back(ciel::move_if_noexcept(*p));
+                }
+
+                clear();
+            }
+
+            alloc_traits::deallocate(allocator_(), begin_, capacity());
+        }
+
+        take_buffer(sb);
+    }
+
+    // Relocate the whole buffer to hold at least new_cap elements, only called when expand_via_realloc.
+    void reallocate(const size_type new_cap, std::true_type) {
+        CIEL_ASSERT(begin_ != nullptr);
+        CIEL_ASSERT(new_cap >= size());
+        CIEL_ASSERT(new_cap != 0);
+
+        const auto allocation_res = allocator_().reallocate_at_least(begin_, capacity(), new_cap);
+
+        begin_ = allocation_res.ptr;
+        cap_() = clamp_cap(allocation_res.count);
+    }
+
+    void reallocate(size_type, std::false_type) noexcept {
+        unreachable();
+    }
+
+    template<class... Args>
+    void emplace_back_aux(Args&&... args) {
+        if (expand_via_realloc && size_ == capacity() && begin_ != nullptr) {
+            // args may refer to an element, which would be invalidated by reallocate,
+            // so construct the new element aside first, then relocate it into place.
+            typename aligned_storage<sizeof(value_type), alignof(value_type)>::type buffer;
+            value_type* tmp = reinterpret_cast<value_type*>(&buffer);
+            alloc_traits::construct(allocator_(), tmp, std::forward<Args>(args)...);
+
+            CIEL_TRY {
+                reallocate(recommend_cap(size_t{size_} + 1), std::integral_constant<bool, expand_via_realloc>{});
+            }
+            CIEL_CATCH (...) {
+                alloc_traits::destroy(allocator_(), tmp);
+                CIEL_THROW;
+            }
+
+            ciel::relocate_at(tmp, ciel::to_address(end_()));
+            ++size_;
+
+        } else if (size_ == capacity()) {
+            split_buffer<value_type, allocator_type&> sb(allocator_(), recommend_cap(size_t{size_} + 1), size());
+            sb.unchecked_emplace_back(std::forward<Args>(args)...);
+            swap_out_buffer(std::move(sb));
+
+        } else {
+            unchecked_emplace_back(std::forward<Args>(args)...);
+        }
+    }
+
+    template<class Iter>
+    void assign(Iter first, Iter last, const size_t count) {
+        if (capacity() < count) {
+            reset(count);
+            construct_at_end(first, last);
+            return;
+        }
+
+        if (size() > count) {
+            destroy_from(static_cast<size_type>(count));
+            ciel::copy_n(first, count, begin_); // count == size()
+
+        } else {
+            Iter mid = ciel::copy_n(first, size(), begin_);
+            construct_at_end(mid, last);
+        }
+    }
+
+    void copy_assign_alloc(const compact_vector& other, std::true_type) {
+        if (allocator_() != other.allocator_()) {
+            reset();
+        }
+
+        allocator_() = other.allocator_();
+    }
+
+    void copy_assign_alloc(const compact_vector&, std::false_type) noexcept {}
+
+    void swap_alloc(compact_vector& other, std::true_type) noexcept {
+        using std::swap;
+        swap(allocator_(), other.allocator_());
+    }
+
+    void swap_alloc(compact_vector&, std::false_type) noexcept {}
+
+    iterator erase_impl(pointer first, pointer last,
+                        const difference_type count) noexcept(move_via_memmove
+                                                              || std::is_nothrow_move_assignable<value_type>::value) {
+        CIEL_ASSERT(last - first == count);
+        CIEL_ASSERT(count != 0);
+
+        const auto index      = first - begin_;
+        const auto back_count = end_() - last;
+
+        if (back_count == 0) {
+            destroy_from(static_cast<size_type>(index));
+
+        } else if (move_via_memmove) {
+            for (pointer p = first; p != last; ++p) {
+                destroy(p);
+            }
+
+            size_ -= static_cast<size_type>(count);
+
+            ciel::uninitialized_relocate_n(ciel::to_address(last), back_count, ciel::to_address(first));
+
+        } else {
+            const pointer new_end = std::move(last, end_(), first);
+            destroy_from(static_cast<size_type>(new_end - begin_));
+        }
+
+        return begin() + index;
+    }
+
+public:
+    compact_vector() = default;
+
+    explicit compact_vector(const allocator_type& alloc) noexcept
+        : cap_alloc_(0, alloc) {}
+
+    // Counts are taken as size_t so that the ones beyond max_size() throw rather than being truncated.
+    compact_vector(const size_t count, const value_type& value, const allocator_type& alloc = allocator_type())
+        : compact_vector(alloc) {
+        if CIEL_LIKELY (count > 0) {
+            init(count);
+            construct_at_end(static_cast<size_type>(count), value);
+        }
+    }
+
+    explicit compact_vector(const size_t count, const allocator_type& alloc = allocator_type())
+        : compact_vector(alloc) {
+        if CIEL_LIKELY (count > 0) {
+            init(count);
+            construct_at_end(static_cast<size_type>(count));
+        }
+    }
+
+    template<class Iter, enable_if_t<is_exactly_input_iterator<Iter>::value> = 0>
+    compact_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : compact_vector(alloc) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    template<class Iter, enable_if_t<is_forward_iterator<Iter>::value> = 0>
+    compact_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : compact_vector(alloc) {
+        const auto count = std::distance(first, last);
+
+        if CIEL_LIKELY (count > 0) {
+            init(count);
+            construct_at_end(first, last);
+        }
+    }
+
+    compact_vector(const compact_vector& other)
+        : compact_vector(other.begin(), other.end(),
+                         alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+    compact_vector(const compact_vector& other, const allocator_type& alloc)
+        : compact_vector(other.begin(), other.end(), alloc) {}
+
+    compact_vector(compact_vector&& other) noexcept
+        : begin_(ciel::exchange(other.begin_, nullptr)),
+          size_(ciel::exchange(other.size_, 0)),
+          cap_alloc_(ciel::exchange(other.cap_(), 0), std::move(other.allocator_())) {}
+
+    compact_vector(compact_vector&& other, const allocator_type& alloc)
+        : compact_vector(alloc) {
+        if (allocator_() == other.get_allocator()) {
+            begin_ = ciel::exchange(other.begin_, nullptr);
+            size_  = ciel::exchange(other.size_, 0);
+            cap_() = ciel::exchange(other.cap_(), 0);
+
+        } else if (other.size() > 0) {
+            init(other.size());
+            construct_at_end(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+    }
+
+    compact_vector(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type())
+        : compact_vector(init.begin(), init.end(), alloc) {}
+
+    compact_vector(reserve_capacity_t, const size_t count, const allocator_type& alloc = allocator_type())
+        : compact_vector(alloc) {
+        init(count);
+    }
+
+    ~compact_vector() {
+        do_destroy();
+    }
+
+    compact_vector& operator=(const compact_vector& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        copy_assign_alloc(other, typename alloc_traits::propagate_on_container_copy_assignment{});
+        assign(other.begin(), other.end(), other.size());
+
+        return *this;
+    }
+
+    compact_vector& operator=(compact_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        if (alloc_traits::propagate_on_container_move_assignment::value || allocator_() == other.allocator_()) {
+            swap(other);
+
+        } else {
+            assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), other.size());
+        }
+
+        return *this;
+    }
+
+    compact_vector& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end(), ilist.size());
+        return *this;
+    }
+
+    void assign(const size_t count, const value_type& value) {
+        if (capacity() < count) {
+            // value may be an element of this vector, so it's copied before the buffer goes away.
+            compact_vector(count, value, allocator_()).swap(*this);
+            return;
+        }
+
+        const size_type n = static_cast<size_type>(count);
+
+        if (n >= size()) {
+            std::fill_n(begin_, size(), value);
+            construct_at_end(n - size(), value);
+
+        } else {
+            std::fill_n(begin_, n, value);
+            destroy_from(n);
+        }
+    }
+
+    template<class Iter, enable_if_t<is_forward_iterator<Iter>::value> = 0>
+    void assign(Iter first, Iter last) {
+        const size_t count = std::distance(first, last);
+
+        assign(first, last, count);
+    }
+
+    template<class Iter, enable_if_t<is_exactly_input_iterator<Iter>::value> = 0>
+    void assign(Iter first, Iter last) {
+        size_type i = 0;
+        for (; first != last && i != size_; ++first) {
+            begin_[i] = *first;
+            ++i;
+        }
+
+        if (i != size_) {
+            destroy_from(i);
+
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    void assign(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end(), ilist.size());
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("ciel::compact_vector::at pos is not within the range"));
+        }
+
+        return begin_[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("ciel::compact_vector::at pos is not within the range"));
+        }
+
+        return begin_[pos];
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) {
+        CIEL_ASSERT(pos < size());
+
+        return begin_[pos];
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const {
+        CIEL_ASSERT(pos < size());
+
+        return begin_[pos];
+    }
+
+    CIEL_NODISCARD reference front() {
+        CIEL_ASSERT(!empty());
+
+        return begin_[0];
+    }
+
+    CIEL_NODISCARD const_reference front() const {
+        CIEL_ASSERT(!empty());
+
+        return begin_[0];
+    }
+
+    CIEL_NODISCARD reference back() {
+        CIEL_ASSERT(!empty());
+
+        return begin_[size_ - 1];
+    }
+
+    CIEL_NODISCARD const_reference back() const {
+        CIEL_ASSERT(!empty());
+
+        return begin_[size_ - 1];
+    }
+
+    CIEL_NODISCARD T* data() noexcept {
+        return ciel::to_address(begin_);
+    }
+
+    CIEL_NODISCARD const T* data() const noexcept {
+        return ciel::to_address(begin_);
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return begin_;
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return begin_;
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return end_();
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return end_();
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return static_cast<size_type>(
+            std::min<size_t>(std::numeric_limits<size_type>::max(), alloc_traits::max_size(allocator_())));
+    }
+
+    void reserve(const size_t new_cap) {
+        if (new_cap <= capacity()) {
+            return;
+        }
+
+        if CIEL_UNLIKELY (new_cap > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error{"ciel::compact_vector::reserve capacity beyond max_size"});
+        }
+
+        if (expand_via_realloc && begin_ != nullptr) {
+            reallocate(static_cast<size_type>(new_cap), std::integral_constant<bool, expand_via_realloc>{});
+            return;
+        }
+
+        split_buffer<value_type, allocator_type&> sb(allocator_(), new_cap, size());
+        swap_out_buffer(std::move(sb));
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return cap_();
+    }
+
+    void shrink_to_fit() {
+        if CIEL_UNLIKELY (size() == capacity()) {
+            return;
+        }
+
+        if (size() > 0) {
+            CIEL_TRY {
+                if (expand_via_realloc) {
+                    reallocate(size(), std::integral_constant<bool, expand_via_realloc>{});
+
+                } else {
+                    split_buffer<value_type, allocator_type&> sb(allocator_(), size(), size());
+                    swap_out_buffer(std::move(sb));
+                }
+            }
+            CIEL_CATCH (...) {}
+
+        } else {
+            alloc_traits::deallocate(allocator_(), begin_, capacity());
+            set_nullptr();
+        }
+    }
+
+    void clear() noexcept {
+        destroy_from(0);
+    }
+
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, std::move(value));
+    }
+
+    template<class... Args>
+    iterator emplace(const_iterator p, Args&&... args) {
+        const size_type index = static_cast<size_type>(p - begin());
+        CIEL_ASSERT(index <= size());
+
+        if (size_ == capacity()) {
+            split_buffer<value_type, allocator_type&> sb(allocator_(), recommend_cap(size_t{size_} + 1), index);
+            sb.unchecked_emplace_back(std::forward<Args>(args)...);
+            swap_out_buffer(std::move(sb), begin_ + index);
+
+        } else if (index == size_) {
+            unchecked_emplace_back(std::forward<Args>(args)...);
+
+        } else {
+            // args may refer to an element, which is shifted below.
+            value_type tmp(std::forward<Args>(args)...);
+            const pointer pos = begin_ + index;
+
+            if (move_via_memmove) {
+                ciel::uninitialized_relocate_backward(ciel::to_address(pos), ciel::to_address(end_()),
+                                                      ciel::to_address(end_() + 1));
+
+                CIEL_TRY {
+                    construct(pos, std::move(tmp));
+                }
+                CIEL_CATCH (...) {
+                    ciel::uninitialized_relocate_n(ciel::to_address(pos + 1), size_ - index, ciel::to_address(pos));
+                    CIEL_THROW;
+                }
+
+                ++size_;
+
+            } else {
+                const pointer old_end = end_();
+                unchecked_emplace_back(std::move(*(old_end - 1)));
+                std::move_backward(pos, old_end - 1, old_end);
+                *pos = std::move(tmp);
+            }
+        }
+
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator p) {
+        const pointer pos = begin_ + (p - begin());
+        CIEL_ASSERT(begin_ <= pos);
+        CIEL_ASSERT(pos < end_());
+
+        return erase_impl(pos, pos + 1, 1);
+    }
+
+    iterator erase(const_iterator f, const_iterator l) {
+        const pointer first = begin_ + (f - begin());
+        const pointer last  = begin_ + (l - begin());
+        CIEL_ASSERT(begin_ <= first);
+        CIEL_ASSERT(last <= end_());
+
+        const auto count = last - first;
+
+        if CIEL_UNLIKELY (count <= 0) {
+            return last;
+        }
+
+        return erase_impl(first, last, count);
+    }
+
+    void push_back(const value_type& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        emplace_back_aux(std::forward<Args>(args)...);
+
+        return back();
+    }
+
+    template<class... Args>
+    reference unchecked_emplace_back(Args&&... args) {
+        CIEL_ASSERT(size_ < capacity());
+
+        construct(end_(), std::forward<Args>(args)...);
+        ++size_;
+
+        return back();
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        destroy(end_() - 1);
+        --size_;
+    }
+
+    void resize(const size_t count) {
+        if (size() >= count) {
+            destroy_from(static_cast<size_type>(count));
+
+        } else {
+            reserve(count);
+            construct_at_end(static_cast<size_type>(count - size()));
+        }
+    }
+
+    void resize(const size_t count, const value_type& value) {
+        if (size() >= count) {
+            destroy_from(static_cast<size_type>(count));
+
+        } else if (count > capacity()) {
+            if CIEL_UNLIKELY (count > max_size()) {
+                CIEL_THROW_EXCEPTION(std::length_error{"ciel::compact_vector::resize size beyond max_size"});
+            }
+
+            split_buffer<value_type, allocator_type&> sb(allocator_(), count, size());
+            sb.construct_at_end(count - size(), value);
+            swap_out_buffer(std::move(sb));
+
+        } else {
+            construct_at_end(static_cast<size_type>(count - size()), value);
+        }
+    }
+
+    void swap(compact_vector& other) noexcept {
+        using std::swap;
+
+        swap(begin_, other.begin_);
+        swap(size_, other.size_);
+        swap(cap_(), other.cap_());
+
+        swap_alloc(other, typename alloc_traits::propagate_on_container_swap{});
+    }
+
+}; // class compact_vector
+
+template<class T, class Allocator, class GrowthPolicy>
+struct is_trivially_relocatable<compact_vector<T, Allocator, GrowthPolicy>>
+    : conjunction<is_trivially_relocatable<Allocator>,
+                  is_trivially_relocatable<typename std::allocator_traits<remove_reference_t<Allocator>>::pointer>> {};
+
+template<class T, class Alloc, class GrowthPolicy, class U>
+typename compact_vector<T, Alloc, GrowthPolicy>::size_type erase(compact_vector<T, Alloc, GrowthPolicy>& c,
+                                                                 const U& value) {
+    auto it        = std::remove(c.begin(), c.end(), value);
+    const auto res = std::distance(it, c.end());
+    c.erase(it, c.end());
+    return static_cast<typename compact_vector<T, Alloc, GrowthPolicy>::size_type>(res);
+}
+
+template<class T, class Alloc, class GrowthPolicy, class Pred>
+typename compact_vector<T, Alloc, GrowthPolicy>::size_type erase_if(compact_vector<T, Alloc, GrowthPolicy>& c,
+                                                                    Pred pred) {
+    auto it        = std::remove_if(c.begin(), c.end(), pred);
+    const auto res = std::distance(it, c.end());
+    c.erase(it, c.end());
+    return static_cast<typename compact_vector<T, Alloc, GrowthPolicy>::size_type>(res);
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class T, class Alloc, class GrowthPolicy>
+void swap(ciel::compact_vector<T, Alloc, GrowthPolicy>& lhs,
+          ciel::compact_vector<T, Alloc, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_COMPACT_VECTOR_HPP_
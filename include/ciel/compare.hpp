@@ -3,19 +3,133 @@
 
 #include <ciel/core/config.hpp>
 #include <ciel/core/is_range.hpp>
+#include <ciel/core/is_trivially_equality_comparable.hpp>
+#include <ciel/core/logical.hpp>
+#include <ciel/core/simd.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 NAMESPACE_CIEL_BEGIN
 
+// When both ranges have data() and size() and share a trivially equality comparable element type,
+// e.g. ciel::vector<int> and ciel::inplace_vector<int, N>, they are compared as bytes:
+// operator== is a memcmp, and operator< looks for the first mismatching byte 16 bytes at a time with SSE2,
+// then compares the two elements containing it.
+
+namespace detail {
+
+template<class T, class U, class E = typename contiguous_element<const T>::type>
+struct is_bytewise_comparable
+    : conjunction<negation<std::is_void<E>>, std::is_same<E, typename contiguous_element<const U>::type>,
+                  is_trivially_equality_comparable<E>> {};
+
+// Index of the first byte that differs between [p, p + n) and [q, q + n), or n if there is none.
+CIEL_NODISCARD inline size_t mismatch_bytes(const unsigned char* p, const unsigned char* q, const size_t n) noexcept {
+    size_t i = 0;
+
+#ifdef CIEL_HAS_X86_SIMD
+    // Check 2 vectors at a time, then find out which one differs.
+    for (; i + 32 <= n; i += 32) {
+        const __m128i m0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i)));
+        const __m128i m1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16)),
+                                          _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i + 16)));
+
+        if (_mm_movemask_epi8(_mm_and_si128(m0, m1)) != 0xFFFF) {
+            break;
+        }
+    }
+
+    for (; i + 16 <= n; i += 16) {
+        const __m128i m = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i)));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m)) ^ 0xFFFFu;
+
+        if (mask != 0) {
+            return i + countr_zero(mask);
+        }
+    }
+#else
+    for (; i + 8 <= n; i += 8) {
+        uint64_t a;
+        uint64_t b;
+        std::memcpy(&a, p + i, 8);
+        std::memcpy(&b, q + i, 8);
+
+        if (a != b) {
+            break;
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        if (p[i] != q[i]) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool range_equal(const T& lhs, const U& rhs, std::false_type) noexcept {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool range_equal(const T& lhs, const U& rhs, std::true_type) noexcept {
+    using E = typename contiguous_element<const T>::type;
+
+    const size_t n = static_cast<size_t>(lhs.size());
+
+    // If either pointer is null, memcmp's behavior is undefined, even if count is zero.
+    return n == static_cast<size_t>(rhs.size())
+        && (n == 0 || std::memcmp(lhs.data(), rhs.data(), sizeof(E) * n) == 0);
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool range_less(const T& lhs, const U& rhs, std::false_type) noexcept {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool range_less(const T& lhs, const U& rhs, std::true_type) noexcept {
+    using E = typename contiguous_element<const T>::type;
+
+    const size_t lhs_size = static_cast<size_t>(lhs.size());
+    const size_t rhs_size = static_cast<size_t>(rhs.size());
+    const size_t n        = ciel::min(lhs_size, rhs_size);
+
+    if (n != 0) {
+        const E* p = lhs.data();
+        const E* q = rhs.data();
+
+        const size_t i = mismatch_bytes(reinterpret_cast<const unsigned char*>(p),
+                                        reinterpret_cast<const unsigned char*>(q), sizeof(E) * n)
+                       / sizeof(E);
+
+        if (i != n) {
+            return p[i] < q[i];
+        }
+    }
+
+    return lhs_size < rhs_size;
+}
+
+} // namespace detail
+
 template<class T, class U, enable_if_t<is_range_with_size<T>::value && is_range_with_size<U>::value> = 0>
 CIEL_NODISCARD bool operator==(const T& lhs, const U& rhs) noexcept {
-    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    return detail::range_equal(lhs, rhs, detail::is_bytewise_comparable<T, U>{});
 }
 
 template<class T, class U, enable_if_t<is_range<T>::value && is_range<U>::value> = 0>
 CIEL_NODISCARD bool operator<(const T& lhs, const U& rhs) noexcept {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    return detail::range_less(lhs, rhs, detail::is_bytewise_comparable<T, U>{});
 }
 
 template<class T, class U>
@@ -0,0 +1,527 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CONCURRENT_VECTOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_CONCURRENT_VECTOR_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/simd.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// concurrent_vector
+// An append-only vector that many threads can push_back to while other threads are reading it.
+// Elements live in buckets of doubling sizes (first_bucket_size, 2 * first_bucket_size, ...) that are allocated
+// on demand and never reallocated, so references to elements are stable for the lifetime of the container.
+//
+// A writer claims an index, constructs the element in place, then marks it ready. size() is the length
+// of the prefix in which every element is ready, so readers may access [0, size()) without any locking.
+// Whoever finds the element at size() ready advances size() over it, which makes publication lock-free:
+// a slow writer only delays the visibility of the elements behind its own.
+//
+// emplace_back, push_back, reserve and all const member functions may be called concurrently.
+// Everything else requires exclusive access.
+//
+// The element is constructed before claiming an index when its constructor may throw,
+// so a failed insertion never leaves a hole. That's why T must be nothrow move constructible in this case.
+
+template<class Vector, class Reference>
+class concurrent_vector_iterator
+    : public random_access_iterator_base<concurrent_vector_iterator<Vector, Reference>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = typename Vector::value_type;
+    using pointer           = remove_reference_t<Reference>*;
+    using reference         = Reference;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+
+private:
+    Vector* vec_{nullptr};
+    size_t index_{0};
+
+public:
+    concurrent_vector_iterator() = default;
+
+    concurrent_vector_iterator(Vector* vec, const size_t index) noexcept
+        : vec_(vec), index_(index) {}
+
+    template<class V, class R, enable_if_t<std::is_convertible<V*, Vector*>::value> = 0>
+    concurrent_vector_iterator(const concurrent_vector_iterator<V, R>& other) noexcept
+        : vec_(other.base()), index_(other.index()) {}
+
+    void go_next() noexcept {
+        ++index_;
+    }
+
+    void go_prev() noexcept {
+        --index_;
+    }
+
+    void advance(const difference_type n) noexcept {
+        index_ += n;
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        CIEL_ASSERT(vec_ != nullptr);
+
+        return (*vec_)[index_];
+    }
+
+    CIEL_NODISCARD pointer operator->() const noexcept {
+        return std::addressof(**this);
+    }
+
+    CIEL_NODISCARD reference operator[](const difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    CIEL_NODISCARD Vector* base() const noexcept {
+        return vec_;
+    }
+
+    CIEL_NODISCARD size_t index() const noexcept {
+        return index_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const concurrent_vector_iterator& lhs,
+                                          const concurrent_vector_iterator& rhs) noexcept {
+        return lhs.index() == rhs.index();
+    }
+
+    CIEL_NODISCARD friend bool operator<(const concurrent_vector_iterator& lhs,
+                                         const concurrent_vector_iterator& rhs) noexcept {
+        return lhs.index() < rhs.index();
+    }
+
+    CIEL_NODISCARD friend concurrent_vector_iterator operator+(concurrent_vector_iterator iter,
+                                                               const difference_type n) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend concurrent_vector_iterator operator+(const difference_type n,
+                                                               concurrent_vector_iterator iter) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend concurrent_vector_iterator operator-(concurrent_vector_iterator iter,
+                                                               const difference_type n) noexcept {
+        iter -= n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend difference_type operator-(const concurrent_vector_iterator& lhs,
+                                                    const concurrent_vector_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index() - rhs.index());
+    }
+
+}; // class concurrent_vector_iterator
+
+template<class T, class Allocator = std::allocator<T>>
+class concurrent_vector {
+    static_assert(std::is_same<typename Allocator::value_type, T>::value, "");
+    static_assert(std::is_same<typename std::allocator_traits<Allocator>::pointer, T*>::value,
+                  "Bucket pointers are stored in std::atomic, so fancy pointers are not supported");
+
+public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = concurrent_vector_iterator<concurrent_vector, reference>;
+    using const_iterator         = concurrent_vector_iterator<const concurrent_vector, const_reference>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type first_bucket_size = 32;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using flag_type    = std::atomic<bool>;
+
+    static_assert(alignof(flag_type) == 1, "Ready flags are stored right after the elements of each bucket");
+
+    static constexpr size_type first_bucket_shift = 5;
+    static constexpr size_type bucket_count       = std::numeric_limits<size_type>::digits - first_bucket_shift;
+
+    static_assert(size_type{1} << first_bucket_shift == first_bucket_size, "");
+
+    // Writers claim indices here.
+    alignas(cacheline_size) std::atomic<size_type> reserved_{0};
+    // Readers only look at the published size, keep it away from the writers' hot spot.
+    alignas(cacheline_size) compressed_pair<std::atomic<size_type>, allocator_type> size_alloc_{0, default_init};
+    // Bucket b holds first_bucket_size << b elements, followed by as many ready flags.
+    alignas(cacheline_size) std::atomic<pointer> buckets_[bucket_count]{};
+
+    CIEL_NODISCARD std::atomic<size_type>& size_() noexcept {
+        return size_alloc_.first();
+    }
+
+    CIEL_NODISCARD const std::atomic<size_type>& size_() const noexcept {
+        return size_alloc_.first();
+    }
+
+    CIEL_NODISCARD allocator_type& allocator_() noexcept {
+        return size_alloc_.second();
+    }
+
+    CIEL_NODISCARD const allocator_type& allocator_() const noexcept {
+        return size_alloc_.second();
+    }
+
+    // Index i lives in bucket floor(log2(i + first_bucket_size)) - first_bucket_shift.
+    CIEL_NODISCARD static size_type bucket_index(const size_type idx) noexcept {
+        const uint64_t n = idx + first_bucket_size;
+
+        return static_cast<size_type>(63 - detail::countl_zero(n)) - first_bucket_shift;
+    }
+
+    CIEL_NODISCARD static size_type bucket_offset(const size_type idx, const size_type b) noexcept {
+        return idx + first_bucket_size - (first_bucket_size << b);
+    }
+
+    CIEL_NODISCARD static size_type bucket_capacity(const size_type b) noexcept {
+        return first_bucket_size << b;
+    }
+
+    // In units of value_type, including the trailing ready flags.
+    CIEL_NODISCARD static size_type bucket_allocation_size(const size_type b) noexcept {
+        const size_type cap = bucket_capacity(b);
+
+        return cap + (cap * sizeof(flag_type) + sizeof(value_type) - 1) / sizeof(value_type);
+    }
+
+    CIEL_NODISCARD static flag_type* bucket_flags(const pointer bucket, const size_type b) noexcept {
+        return reinterpret_cast<flag_type*>(bucket + bucket_capacity(b));
+    }
+
+    // Returns bucket b, allocating it if no one did yet.
+    // Racing threads may all allocate, the losers of CAS deallocate their own.
+    pointer bucket(const size_type b) {
+        CIEL_ASSERT(b < bucket_count);
+
+        pointer res = buckets_[b].load(std::memory_order_acquire);
+
+        if CIEL_LIKELY (res != nullptr) {
+            return res;
+        }
+
+        const pointer new_bucket = alloc_traits::allocate(allocator_(), bucket_allocation_size(b));
+
+        flag_type* flags = bucket_flags(new_bucket, b);
+        for (size_type i = 0; i < bucket_capacity(b); ++i) {
+            ::new (flags + i) flag_type(false);
+        }
+
+        if (buckets_[b].compare_exchange_strong(res, new_bucket, std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+            return new_bucket;
+        }
+
+        alloc_traits::deallocate(allocator_(), new_bucket, bucket_allocation_size(b));
+        return res;
+    }
+
+    // Claims an index whose bucket is already allocated. Nothing is claimed if the allocation throws.
+    CIEL_NODISCARD std::pair<size_type, pointer> claim() {
+        size_type idx = reserved_.load(std::memory_order_relaxed);
+        pointer slot  = nullptr;
+
+        do {
+            if CIEL_UNLIKELY (idx == max_size()) {
+                CIEL_THROW_EXCEPTION(std::length_error("ciel::concurrent_vector reached max_size"));
+            }
+
+            const size_type b = bucket_index(idx);
+            slot              = bucket(b) + bucket_offset(idx, b);
+
+        } while (!reserved_.compare_exchange_weak(idx, idx + 1, std::memory_order_relaxed));
+
+        return {idx, slot};
+    }
+
+    CIEL_NODISCARD bool is_ready(const size_type idx) const noexcept {
+        const size_type b    = bucket_index(idx);
+        const pointer bucket = buckets_[b].load(std::memory_order_acquire);
+
+        return bucket != nullptr && bucket_flags(bucket, b)[bucket_offset(idx, b)].load();
+    }
+
+    // Marks idx ready, then advances size_ over every ready element.
+    // All of these are seq_cst: a writer stores its flag then loads size_, while a helper CASes size_
+    // then loads the next flag. Weaker orderings would allow both of them to miss each other's store,
+    // leaving a ready element unpublished forever.
+    void publish(const size_type idx) noexcept {
+        const size_type b = bucket_index(idx);
+        bucket_flags(buckets_[b].load(std::memory_order_relaxed), b)[bucket_offset(idx, b)].store(true);
+
+        // If s < idx is not ready yet, its writer will carry on over ours.
+        size_type s = size_().load();
+        while (is_ready(s)) {
+            if (size_().compare_exchange_weak(s, s + 1)) {
+                ++s;
+            }
+        }
+    }
+
+    template<class... Args>
+    size_type emplace_back_impl(std::true_type /* nothrow */, Args&&... args) {
+        const std::pair<size_type, pointer> claimed = claim();
+
+        alloc_traits::construct(allocator_(), claimed.second, std::forward<Args>(args)...);
+        publish(claimed.first);
+
+        return claimed.first;
+    }
+
+    template<class... Args>
+    size_type emplace_back_impl(std::false_type /* nothrow */, Args&&... args) {
+        static_assert(std::is_nothrow_move_constructible<value_type>::value,
+                      "concurrent_vector requires T to be nothrow constructible from Args, "
+                      "or nothrow move constructible");
+
+        value_type tmp(std::forward<Args>(args)...);
+
+        return emplace_back_impl(std::true_type{}, std::move(tmp));
+    }
+
+    void destroy_and_deallocate() noexcept {
+        const size_type sz = size();
+
+        for (size_type i = 0; i < sz; ++i) {
+            alloc_traits::destroy(allocator_(), std::addressof((*this)[i]));
+        }
+
+        for (size_type b = 0; b < bucket_count; ++b) {
+            const pointer bucket = buckets_[b].load(std::memory_order_relaxed);
+
+            if (bucket != nullptr) {
+                alloc_traits::deallocate(allocator_(), bucket, bucket_allocation_size(b));
+            }
+        }
+    }
+
+public:
+    concurrent_vector() = default;
+
+    explicit concurrent_vector(const allocator_type& alloc) noexcept
+        : size_alloc_(0, alloc) {}
+
+    concurrent_vector(const concurrent_vector& other)
+        : concurrent_vector(alloc_traits::select_on_container_copy_construction(other.get_allocator())) {
+        // Delegated, so the destructor cleans up if a copy throws.
+        for (const value_type& value : other) {
+            emplace_back(value);
+        }
+    }
+
+    // Not thread-safe with respect to other, which is left empty.
+    concurrent_vector(concurrent_vector&& other) noexcept
+        : reserved_(other.reserved_.exchange(0, std::memory_order_relaxed)),
+          size_alloc_(other.size_().exchange(0, std::memory_order_relaxed), std::move(other.allocator_())) {
+        for (size_type b = 0; b < bucket_count; ++b) {
+            buckets_[b].store(other.buckets_[b].exchange(nullptr, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+        }
+    }
+
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(concurrent_vector&&)      = delete;
+
+    ~concurrent_vector() {
+        destroy_and_deallocate();
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    // The published elements, at the time of the call.
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_().load(std::memory_order_acquire);
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return ciel::min<size_type>(alloc_traits::max_size(allocator_()),
+                                    std::numeric_limits<difference_type>::max() - first_bucket_size);
+    }
+
+    // Allocated buckets from the front.
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        size_type b = 0;
+        while (b < bucket_count && buckets_[b].load(std::memory_order_relaxed) != nullptr) {
+            ++b;
+        }
+
+        return bucket_capacity(b) - first_bucket_size;
+    }
+
+    // Allocates the buckets for the first new_cap elements.
+    void reserve(const size_type new_cap) {
+        if CIEL_UNLIKELY (new_cap > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::concurrent_vector reserve capacity beyond max_size"));
+        }
+
+        if (new_cap == 0) {
+            return;
+        }
+
+        const size_type last = bucket_index(new_cap - 1);
+        for (size_type b = 0; b <= last; ++b) {
+            CIEL_UNUSED(bucket(b));
+        }
+    }
+
+    // Returns the index of the new element. It's readable by other threads once size() exceeds it.
+    template<class... Args>
+    size_type emplace_back(Args&&... args) {
+        return emplace_back_impl(bool_constant<std::is_nothrow_constructible<value_type, Args&&...>::value>{},
+                                 std::forward<Args>(args)...);
+    }
+
+    size_type push_back(const value_type& value) {
+        return emplace_back(value);
+    }
+
+    size_type push_back(value_type&& value) {
+        return emplace_back(std::move(value));
+    }
+
+    // pos < size() at some point is all that's needed, the element never moves after it's published.
+    CIEL_NODISCARD reference operator[](const size_type pos) noexcept {
+        CIEL_ASSERT(pos < size());
+
+        const size_type b = bucket_index(pos);
+
+        // The bucket pointer happens-before the publication of pos.
+        return buckets_[b].load(std::memory_order_relaxed)[bucket_offset(pos, b)];
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const noexcept {
+        CIEL_ASSERT(pos < size());
+
+        const size_type b = bucket_index(pos);
+
+        return buckets_[b].load(std::memory_order_relaxed)[bucket_offset(pos, b)];
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::concurrent_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::concurrent_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD reference front() noexcept {
+        CIEL_ASSERT(!empty());
+
+        return (*this)[0];
+    }
+
+    CIEL_NODISCARD const_reference front() const noexcept {
+        CIEL_ASSERT(!empty());
+
+        return (*this)[0];
+    }
+
+    // Iterators are a snapshot of [0, size()) at the time end() is called.
+    CIEL_NODISCARD iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return iterator(this, size());
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // Not thread-safe. Buckets are kept for reuse.
+    void clear() noexcept {
+        const size_type sz = size();
+
+        for (size_type i = 0; i < sz; ++i) {
+            const size_type b    = bucket_index(i);
+            const pointer bucket = buckets_[b].load(std::memory_order_relaxed);
+
+            alloc_traits::destroy(allocator_(), bucket + bucket_offset(i, b));
+            bucket_flags(bucket, b)[bucket_offset(i, b)].store(false, std::memory_order_relaxed);
+        }
+
+        reserved_.store(0, std::memory_order_relaxed);
+        size_().store(0, std::memory_order_relaxed);
+    }
+
+}; // class concurrent_vector
+
+template<class T, class Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::first_bucket_size;
+
+template<class T, class Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::first_bucket_shift;
+
+template<class T, class Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::bucket_count;
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CONCURRENT_VECTOR_HPP_
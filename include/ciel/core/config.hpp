@@ -99,6 +99,20 @@
 #  define CIEL_UNLIKELY(x) (x)
 #endif
 
+// trivial_abi
+// Objects of a class marked [[clang::trivial_abi]] are passed in registers,
+// and Clang's __is_trivially_relocatable holds for it.
+
+#if defined(__clang__) && defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(clang::trivial_abi)
+#    define CIEL_TRIVIAL_ABI [[clang::trivial_abi]]
+#  endif
+#endif
+
+#ifndef CIEL_TRIVIAL_ABI
+#  define CIEL_TRIVIAL_ABI
+#endif
+
 // __has_builtin
 
 #ifndef __has_builtin
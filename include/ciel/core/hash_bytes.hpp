@@ -0,0 +1,50 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_HASH_BYTES_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_HASH_BYTES_HPP_
+
+#include <ciel/core/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if CIEL_STD_VER >= 17
+#  include <functional>
+#  include <string_view>
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+// hash_bytes
+// Hash of the bytes [p, p + n), used by the string types' std::hash specializations.
+// Since C++17 it's std::hash<std::string_view>, so that a string hashes the same as the std::string with its content.
+
+CIEL_NODISCARD inline size_t hash_bytes(const char* p, const size_t n) noexcept {
+#if CIEL_STD_VER >= 17
+    return std::hash<std::string_view>{}(std::string_view(p, n));
+#else
+    constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t h = n * multiplier;
+    size_t i   = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        h = (h ^ word) * multiplier;
+        h ^= h >> 32;
+    }
+
+    if (i != n) {
+        uint64_t word = 0;
+        std::memcpy(&word, p + i, n - i);
+        h = (h ^ word) * multiplier;
+        h ^= h >> 32;
+    }
+
+    return static_cast<size_t>(h);
+#endif
+}
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_HASH_BYTES_HPP_
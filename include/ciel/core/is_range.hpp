@@ -28,6 +28,25 @@ struct is_range_with_size<T, void_t<decltype(std::declval<T>().begin())>, void_t
 template<class T>
 struct is_range_without_size : bool_constant<is_range<T>::value && !is_range_with_size<T>::value> {};
 
+namespace detail {
+
+// contiguous_element
+// The element type of a range with data() and size(), e.g. ciel::vector, or void for other ranges.
+
+template<class R, class = void>
+struct contiguous_element {
+    using type = void;
+};
+
+template<class R>
+struct contiguous_element<
+    R, void_t<decltype(std::declval<R&>().size()), decltype(std::declval<R&>().begin() + 1),
+              enable_if_t<std::is_pointer<decltype(std::declval<R&>().data())>::value>>> {
+    using type = remove_cv_t<remove_pointer_t<decltype(std::declval<R&>().data())>>;
+};
+
+} // namespace detail
+
 // from_range_t
 
 struct from_range_t {};
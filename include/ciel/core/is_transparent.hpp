@@ -0,0 +1,20 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_IS_TRANSPARENT_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_IS_TRANSPARENT_HPP_
+
+#include <ciel/core/config.hpp>
+
+#include <type_traits>
+
+NAMESPACE_CIEL_BEGIN
+
+// Whether a comparator or a hasher enables heterogeneous lookup.
+
+template<class T, class = void>
+struct is_transparent : std::false_type {};
+
+template<class T>
+struct is_transparent<T, void_t<typename T::is_transparent>> : std::true_type {};
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_IS_TRANSPARENT_HPP_
@@ -0,0 +1,36 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_IS_TRIVIALLY_EQUALITY_COMPARABLE_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_IS_TRIVIALLY_EQUALITY_COMPARABLE_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/logical.hpp>
+
+#include <type_traits>
+
+NAMESPACE_CIEL_BEGIN
+
+// is_trivially_equality_comparable
+// Two objects of type T compare equal if and only if their object representations are equal,
+// so that ranges of T can be compared with memcmp.
+// It holds for integers, enums and pointers, but not for floating points since 0.0 == -0.0 and NaN != NaN.
+// Specialize it for class types without padding whose operator== compares all members.
+
+template<class T>
+struct is_trivially_equality_comparable : disjunction<std::is_integral<T>, std::is_enum<T>, std::is_pointer<T>,
+#if __has_builtin(__is_trivially_equality_comparable)
+                                                      bool_constant<__is_trivially_equality_comparable(T)>,
+#endif
+                                                      std::false_type> {
+};
+
+template<class T>
+struct is_trivially_equality_comparable<const T> : is_trivially_equality_comparable<T> {};
+
+template<class T>
+struct is_trivially_equality_comparable<volatile T> : std::false_type {};
+
+template<class T>
+struct is_trivially_equality_comparable<const volatile T> : std::false_type {};
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_IS_TRIVIALLY_EQUALITY_COMPARABLE_HPP_
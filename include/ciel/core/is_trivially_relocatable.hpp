@@ -4,6 +4,7 @@
 #include <ciel/core/config.hpp>
 #include <ciel/core/logical.hpp>
 
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -11,17 +12,66 @@
 NAMESPACE_CIEL_BEGIN
 
 // https://www.open-std.org/jtc1/sc22/wg21/docs/papers/2024/p1144r10.html
+//
+// is_trivially_relocatable holds for trivially copyable types, for types the compiler knows to be trivially
+// relocatable, which on Clang includes the ones marked [[clang::trivial_abi]], for libc++'s own trivially
+// relocatable types, and for classes declaring CIEL_TRIVIALLY_RELOCATABLE. Otherwise, specialize it.
+
+// CIEL_TRIVIALLY_RELOCATABLE(class, member types...)
+// Declared in the public part of a class, it makes the class trivially relocatable if all the listed types are,
+// so that relocatability propagates through member-wise composition. The class must not have a user-provided
+// move constructor or destructor which depends on its address. An empty list means unconditionally.
+// The class names itself, so that the declaration isn't inherited by derived classes, which may add members.
+//
+//     struct entry {
+//         CIEL_TRIVIALLY_RELOCATABLE(entry, std::string, std::unique_ptr<int>);
+//
+//         std::string name;
+//         std::unique_ptr<int> value;
+//     };
+
+#define CIEL_TRIVIALLY_RELOCATABLE(...)                                                                  \
+    using ciel_trivially_relocatable_self_    = ::ciel::detail::trivially_relocatable_self<__VA_ARGS__>; \
+    using ciel_trivially_relocatable_members_ = ::ciel::detail::trivially_relocatable_members<__VA_ARGS__>
+
+template<class T>
+struct is_trivially_relocatable;
+
+namespace detail {
+
+template<class Self, class...>
+using trivially_relocatable_self = Self;
+
+template<class Self, class... Types>
+struct trivially_relocatable_members : conjunction<is_trivially_relocatable<Types>...> {};
+
+template<class T, class = void>
+struct is_declared_trivially_relocatable : std::false_type {};
+
+template<class T>
+struct is_declared_trivially_relocatable<T, void_t<typename T::ciel_trivially_relocatable_self_>>
+    : conjunction<std::is_same<typename T::ciel_trivially_relocatable_self_, remove_cv_t<T>>,
+                  typename T::ciel_trivially_relocatable_members_> {};
+
+} // namespace detail
 
 template<class T>
 struct is_trivially_relocatable : disjunction<std::is_trivially_copyable<T>,
-#ifdef _LIBCPP___TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_H
-                                              std::__libcpp_is_trivially_relocatable<T>,
+#if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+                                              bool_constant<__builtin_is_cpp_trivially_relocatable(T)>,
 #elif __has_builtin(__is_trivially_relocatable)
                                               bool_constant<__is_trivially_relocatable(T)>,
 #endif
-                                              std::false_type> {
+#ifdef _LIBCPP___TYPE_TRAITS_IS_TRIVIALLY_RELOCATABLE_H
+                                              std::__libcpp_is_trivially_relocatable<T>,
+#endif
+                                              detail::is_declared_trivially_relocatable<T>> {
 };
 
+// std::allocator is stateless, but its user-provided copy constructor makes it not trivially copyable on libstdc++.
+template<class T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
 template<class First, class Second>
 struct is_trivially_relocatable<std::pair<First, Second>>
     : conjunction<is_trivially_relocatable<First>, is_trivially_relocatable<Second>> {};
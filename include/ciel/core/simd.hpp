@@ -0,0 +1,198 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_SIMD_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_SIMD_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#  include <immintrin.h>
+#  define CIEL_HAS_X86_SIMD
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+namespace detail {
+
+#if defined(_MSC_VER) && !defined(__clang__) // MSVC
+
+CIEL_NODISCARD inline unsigned countr_zero(const uint32_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    unsigned long res;
+    _BitScanForward(&res, x);
+    return res;
+}
+
+CIEL_NODISCARD inline unsigned countr_zero(const uint64_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+#  ifdef _WIN64
+    unsigned long res;
+    _BitScanForward64(&res, x);
+    return res;
+#  else
+    const uint32_t low = static_cast<uint32_t>(x);
+    return low != 0 ? countr_zero(low) : 32 + countr_zero(static_cast<uint32_t>(x >> 32));
+#  endif
+}
+
+CIEL_NODISCARD inline unsigned countl_zero(const uint32_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    unsigned long res;
+    _BitScanReverse(&res, x);
+    return 31 - res;
+}
+
+CIEL_NODISCARD inline unsigned countl_zero(const uint64_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+#  ifdef _WIN64
+    unsigned long res;
+    _BitScanReverse64(&res, x);
+    return 63 - res;
+#  else
+    const uint32_t high = static_cast<uint32_t>(x >> 32);
+    return high != 0 ? countl_zero(high) : 32 + countl_zero(static_cast<uint32_t>(x));
+#  endif
+}
+
+// __popcnt needs the popcnt instruction, which isn't checked at run time here, so count by SWAR.
+CIEL_NODISCARD inline unsigned popcount(uint32_t x) noexcept {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return static_cast<unsigned>((x * 0x01010101u) >> 24);
+}
+
+CIEL_NODISCARD inline unsigned popcount(uint64_t x) noexcept {
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<unsigned>((x * 0x0101010101010101ull) >> 56);
+}
+
+#else // GCC, Clang
+
+CIEL_NODISCARD inline unsigned countr_zero(const uint32_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    return __builtin_ctz(x);
+}
+
+CIEL_NODISCARD inline unsigned countr_zero(const uint64_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    return __builtin_ctzll(x);
+}
+
+CIEL_NODISCARD inline unsigned countl_zero(const uint32_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    return __builtin_clz(x);
+}
+
+CIEL_NODISCARD inline unsigned countl_zero(const uint64_t x) noexcept {
+    CIEL_ASSERT(x != 0);
+
+    return __builtin_clzll(x);
+}
+
+CIEL_NODISCARD inline unsigned popcount(const uint32_t x) noexcept {
+    return __builtin_popcount(x);
+}
+
+CIEL_NODISCARD inline unsigned popcount(const uint64_t x) noexcept {
+    return __builtin_popcountll(x);
+}
+
+#endif
+
+#ifdef CIEL_HAS_X86_SIMD
+
+CIEL_NODISCARD inline bool cpu_supports_avx2() noexcept {
+    static const bool res = __builtin_cpu_supports("avx2");
+    return res;
+}
+
+CIEL_NODISCARD inline bool cpu_supports_popcnt() noexcept {
+    static const bool res = __builtin_cpu_supports("popcnt");
+    return res;
+}
+
+// Mula's nibble lookup: pshufb counts the bits of each nibble, psadbw sums the bytes into 64-bit lanes.
+__attribute__((target("avx2,popcnt"))) CIEL_NODISCARD inline size_t popcount_avx2(const uint64_t* p,
+                                                                                  const size_t n) noexcept {
+    const __m256i lookup   = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, //
+                                              0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+    __m256i acc = _mm256_setzero_si256();
+    size_t i    = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+        const __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+
+    size_t res = static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+
+    for (; i < n; ++i) {
+        res += __builtin_popcountll(p[i]);
+    }
+
+    return res;
+}
+
+__attribute__((target("popcnt"))) CIEL_NODISCARD inline size_t popcount_popcnt(const uint64_t* p,
+                                                                              const size_t n) noexcept {
+    size_t res = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        res += __builtin_popcountll(p[i]);
+    }
+
+    return res;
+}
+
+#endif // CIEL_HAS_X86_SIMD
+
+// Number of set bits in [p, p + n).
+CIEL_NODISCARD inline size_t popcount(const uint64_t* p, const size_t n) noexcept {
+#ifdef CIEL_HAS_X86_SIMD
+    if (cpu_supports_avx2()) {
+        return popcount_avx2(p, n);
+    }
+
+    if (cpu_supports_popcnt()) {
+        return popcount_popcnt(p, n);
+    }
+#endif
+
+    size_t res = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        res += popcount(p[i]);
+    }
+
+    return res;
+}
+
+} // namespace detail
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_SIMD_HPP_
@@ -0,0 +1,16 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_SORTED_UNIQUE_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_SORTED_UNIQUE_HPP_
+
+#include <ciel/core/config.hpp>
+
+NAMESPACE_CIEL_BEGIN
+
+// https://en.cppreference.com/w/cpp/container/flat_set/sorted_unique
+
+struct sorted_unique_t {};
+
+static constexpr sorted_unique_t sorted_unique;
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_SORTED_UNIQUE_HPP_
@@ -0,0 +1,126 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_SPAN_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_SPAN_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+NAMESPACE_CIEL_BEGIN
+
+// A minimal std::span with dynamic extent for C++11.
+
+template<class T>
+class span {
+public:
+    using element_type     = T;
+    using value_type       = remove_cv_t<T>;
+    using size_type        = size_t;
+    using difference_type  = ptrdiff_t;
+    using pointer          = T*;
+    using const_pointer    = const T*;
+    using reference        = T&;
+    using const_reference  = const T&;
+    using iterator         = T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+private:
+    pointer data_{nullptr};
+    size_type size_{0};
+
+public:
+    span() = default;
+
+    span(const pointer data, const size_type size) noexcept
+        : data_(data), size_(size) {}
+
+    span(const pointer first, const pointer last) noexcept
+        : data_(first), size_(last - first) {
+        CIEL_ASSERT(first <= last);
+    }
+
+    template<size_t N>
+    span(element_type (&arr)[N]) noexcept
+        : data_(arr), size_(N) {}
+
+    // span<T> to span<const T>.
+    template<class U, enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value> = 0>
+    span(const span<U>& other) noexcept
+        : data_(other.data()), size_(other.size()) {}
+
+    CIEL_NODISCARD iterator begin() const noexcept {
+        return data_;
+    }
+
+    CIEL_NODISCARD iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() const noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() const noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD reference front() const noexcept {
+        CIEL_ASSERT(!empty());
+
+        return *data_;
+    }
+
+    CIEL_NODISCARD reference back() const noexcept {
+        CIEL_ASSERT(!empty());
+
+        return *(data_ + size_ - 1);
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type idx) const noexcept {
+        CIEL_ASSERT(idx < size_);
+
+        return *(data_ + idx);
+    }
+
+    CIEL_NODISCARD pointer data() const noexcept {
+        return data_;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type size_bytes() const noexcept {
+        return size_ * sizeof(element_type);
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD span first(const size_type count) const noexcept {
+        CIEL_ASSERT(count <= size_);
+
+        return span(data_, count);
+    }
+
+    CIEL_NODISCARD span last(const size_type count) const noexcept {
+        CIEL_ASSERT(count <= size_);
+
+        return span(data_ + (size_ - count), count);
+    }
+
+    CIEL_NODISCARD span subspan(const size_type offset, const size_type count) const noexcept {
+        CIEL_ASSERT(offset <= size_);
+        CIEL_ASSERT(count <= size_ - offset);
+
+        return span(data_ + offset, count);
+    }
+
+}; // class span
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_SPAN_HPP_
@@ -0,0 +1,94 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_STD_TRIVIALLY_RELOCATABLE_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_STD_TRIVIALLY_RELOCATABLE_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/logical.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if CIEL_STD_VER >= 17
+#  include <optional>
+#endif
+
+// Specializations of is_trivially_relocatable for standard library types whose layout is known
+// not to point into the object itself on the standard library in use.
+// They are opt-in: include this header before is_trivially_relocatable is instantiated for these types,
+// and do so in every translation unit, otherwise the trait may differ between them.
+//
+// | type                | libstdc++ (GCC 7+)   | libc++ (LLVM 7+)     |
+// |---------------------|----------------------|----------------------|
+// | unique_ptr<T, D>    | if D is              | if D is              |
+// | shared_ptr, weak_ptr| yes                  | yes                  |
+// | vector<T, A>        | if A is, no debug    | if A is, no debug    |
+// | function<Sig>       | yes                  | no, SBO points to it |
+// | optional<T>         | if T is              | if T is              |
+// | basic_string<C,T,A> | no, SSO points to it | if A is, no debug    |
+//
+// pair and tuple of trivially relocatable types are always specialized, see is_trivially_relocatable.hpp.
+
+#if defined(_GLIBCXX_RELEASE) && _GLIBCXX_RELEASE >= 7
+#  define CIEL_STD_TRIVIALLY_RELOCATABLE_LIBSTDCXX
+#  if !defined(_GLIBCXX_DEBUG)
+#    define CIEL_STD_TRIVIALLY_RELOCATABLE_CONTAINERS
+#  endif
+#elif defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 7000
+#  define CIEL_STD_TRIVIALLY_RELOCATABLE_LIBCXX
+#  if !defined(_LIBCPP_ENABLE_DEBUG_MODE) && (!defined(_LIBCPP_DEBUG) || _LIBCPP_DEBUG < 1)
+#    define CIEL_STD_TRIVIALLY_RELOCATABLE_CONTAINERS
+#  endif
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+#if defined(CIEL_STD_TRIVIALLY_RELOCATABLE_LIBSTDCXX) || defined(CIEL_STD_TRIVIALLY_RELOCATABLE_LIBCXX)
+
+template<class T, class Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>>
+    : conjunction<is_trivially_relocatable<Deleter>,
+                  is_trivially_relocatable<typename std::unique_ptr<T, Deleter>::pointer>> {};
+
+template<class T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template<class T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+#  if CIEL_STD_VER >= 17
+template<class T>
+struct is_trivially_relocatable<std::optional<T>> : is_trivially_relocatable<T> {};
+#  endif
+
+#  ifdef CIEL_STD_TRIVIALLY_RELOCATABLE_CONTAINERS
+template<class T, class Allocator>
+struct is_trivially_relocatable<std::vector<T, Allocator>>
+    : conjunction<is_trivially_relocatable<Allocator>,
+                  is_trivially_relocatable<typename std::allocator_traits<Allocator>::pointer>> {};
+#  endif
+
+#endif
+
+#ifdef CIEL_STD_TRIVIALLY_RELOCATABLE_LIBSTDCXX
+// Small callables are stored locally only if they are trivially copyable.
+template<class R, class... Args>
+struct is_trivially_relocatable<std::function<R(Args...)>> : std::true_type {};
+#endif
+
+#if defined(CIEL_STD_TRIVIALLY_RELOCATABLE_LIBCXX) && defined(CIEL_STD_TRIVIALLY_RELOCATABLE_CONTAINERS)
+template<class CharT, class Traits, class Allocator>
+struct is_trivially_relocatable<std::basic_string<CharT, Traits, Allocator>>
+    : conjunction<is_trivially_relocatable<Allocator>,
+                  is_trivially_relocatable<typename std::allocator_traits<Allocator>::pointer>> {};
+#endif
+
+NAMESPACE_CIEL_END
+
+#undef CIEL_STD_TRIVIALLY_RELOCATABLE_LIBSTDCXX
+#undef CIEL_STD_TRIVIALLY_RELOCATABLE_LIBCXX
+#undef CIEL_STD_TRIVIALLY_RELOCATABLE_CONTAINERS
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_STD_TRIVIALLY_RELOCATABLE_HPP_
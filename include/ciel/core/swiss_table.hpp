@@ -0,0 +1,1082 @@
+#ifndef CIELLAB_INCLUDE_CIEL_CORE_SWISS_TABLE_HPP_
+#define CIELLAB_INCLUDE_CIEL_CORE_SWISS_TABLE_HPP_
+
+#include <ciel/core/aligned_storage.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/is_range.hpp>
+#include <ciel/core/is_transparent.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/simd.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// swiss_table
+// The open addressing hash table behind flat_hash_set and flat_hash_map, after Abseil's Swiss tables.
+//
+// Every slot has a control byte, which is empty, deleted, or the low 7 bits of the hash (H2) of a full slot.
+// A lookup starts at the group of control bytes indexed by the remaining bits of the hash (H1),
+// compares all 16 of them (8 without SSE2) with H2 at once, and only compares keys of the matches.
+// A group containing an empty byte ends the probing, otherwise the next group is probed quadratically.
+//
+// The capacity is always 2^n - 1 and at least a group wide. The control bytes are followed by a sentinel
+// which ends iterations, and by a copy of the first group, so a group can be loaded at any slot.
+// The table grows when it's 7/8 full. Rehashing memcpys the elements which are trivially relocatable.
+// Hash is assumed not to throw on the keys that are already in the table.
+//
+// Policy provides key_type, value_type, key(value) and constant_iterator, and transfer(alloc, dst, src) with
+// trivially_relocatable and nothrow_transfer for rehashing.
+
+namespace detail {
+
+using swiss_ctrl = int8_t;
+
+static constexpr swiss_ctrl swiss_empty    = -128; // 0b10000000
+static constexpr swiss_ctrl swiss_deleted  = -2;   // 0b11111110
+static constexpr swiss_ctrl swiss_sentinel = -1;   // 0b11111111
+
+CIEL_NODISCARD inline bool swiss_is_full(const swiss_ctrl c) noexcept {
+    return c >= 0;
+}
+
+// Set bits of a group match, Shift converts a bit index to a lane index.
+template<class T, unsigned Shift>
+class swiss_bitmask {
+private:
+    T mask_;
+
+public:
+    explicit swiss_bitmask(const T mask) noexcept
+        : mask_(mask) {}
+
+    explicit operator bool() const noexcept {
+        return mask_ != 0;
+    }
+
+    CIEL_NODISCARD unsigned lowest() const noexcept {
+        return countr_zero(mask_) >> Shift;
+    }
+
+    // Lanes of empty bytes on both sides of a slot are counted by these two.
+    CIEL_NODISCARD unsigned trailing_zeros() const noexcept {
+        return countr_zero(mask_) >> Shift;
+    }
+
+    CIEL_NODISCARD unsigned leading_zeros(const unsigned significant_bits) const noexcept {
+        return countl_zero(static_cast<T>(mask_ << (sizeof(T) * 8 - significant_bits))) >> Shift;
+    }
+
+    void clear_lowest() noexcept {
+        mask_ &= mask_ - 1;
+    }
+
+}; // class swiss_bitmask
+
+#ifdef CIEL_HAS_X86_SIMD
+
+struct swiss_group {
+    static constexpr size_t width = 16;
+    using bitmask                 = swiss_bitmask<uint32_t, 0>;
+
+    __m128i ctrl;
+
+    explicit swiss_group(const swiss_ctrl* p) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+    CIEL_NODISCARD bitmask match(const swiss_ctrl h2) const noexcept {
+        return bitmask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+
+    CIEL_NODISCARD bitmask match_empty() const noexcept {
+        return match(swiss_empty);
+    }
+
+    // Both are less than the sentinel, while full bytes are greater.
+    CIEL_NODISCARD bitmask match_empty_or_deleted() const noexcept {
+        return bitmask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(swiss_sentinel), ctrl))));
+    }
+
+    CIEL_NODISCARD static unsigned significant_bits() noexcept {
+        return 16;
+    }
+
+}; // struct swiss_group
+
+#else
+
+// Portable fallback, which checks 8 bytes at a time in a uint64_t. The highest bit of each byte holds the result.
+struct swiss_group {
+    static constexpr size_t width = 8;
+    using bitmask                 = swiss_bitmask<uint64_t, 3>;
+
+    static constexpr uint64_t lsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t msbs = 0x8080808080808080ULL;
+
+    uint64_t ctrl;
+
+    explicit swiss_group(const swiss_ctrl* p) noexcept {
+        std::memcpy(&ctrl, p, sizeof(ctrl));
+#  if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        ctrl = __builtin_bswap64(ctrl);
+#  endif
+    }
+
+    // May report false positives after a true match, which are filtered out by comparing keys.
+    CIEL_NODISCARD bitmask match(const swiss_ctrl h2) const noexcept {
+        const uint64_t x = ctrl ^ (lsbs * static_cast<uint8_t>(h2));
+
+        return bitmask((x - lsbs) & ~x & msbs);
+    }
+
+    // Only empty has the highest bit set and the second lowest bit unset.
+    CIEL_NODISCARD bitmask match_empty() const noexcept {
+        return bitmask(ctrl & ~(ctrl << 6) & msbs);
+    }
+
+    // Only empty and deleted have the highest bit set and the lowest bit unset.
+    CIEL_NODISCARD bitmask match_empty_or_deleted() const noexcept {
+        return bitmask(ctrl & ~(ctrl << 7) & msbs);
+    }
+
+    CIEL_NODISCARD static unsigned significant_bits() noexcept {
+        return 64;
+    }
+
+}; // struct swiss_group
+
+#endif // CIEL_HAS_X86_SIMD
+
+// Triangular probing over groups, which visits every group once when the capacity is 2^n - 1.
+class swiss_probe {
+private:
+    size_t mask_;
+    size_t offset_;
+    size_t index_{0};
+
+public:
+    swiss_probe(const size_t hash, const size_t mask) noexcept
+        : mask_(mask), offset_(hash & mask) {}
+
+    CIEL_NODISCARD size_t offset() const noexcept {
+        return offset_;
+    }
+
+    CIEL_NODISCARD size_t offset(const unsigned lane) const noexcept {
+        return (offset_ + lane) & mask_;
+    }
+
+    CIEL_NODISCARD size_t index() const noexcept {
+        return index_;
+    }
+
+    void next() noexcept {
+        index_ += swiss_group::width;
+        offset_ = (offset_ + index_) & mask_;
+    }
+
+}; // class swiss_probe
+
+// std::hash of integers is the identity on most implementations, spread the entropy to all bits.
+CIEL_NODISCARD inline size_t swiss_mix(const size_t hash) noexcept {
+#ifdef __SIZEOF_INT128__
+    __extension__ using uint128 = unsigned __int128;
+
+    const uint128 m = static_cast<uint128>(hash) * 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<size_t>(static_cast<uint64_t>(m) ^ static_cast<uint64_t>(m >> 64));
+#else
+    const uint64_t m = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+
+    return static_cast<size_t>(m ^ (m >> 32));
+#endif
+}
+
+// The control bytes of tables without any allocation, so that iterations and lookups need no special case.
+CIEL_NODISCARD inline swiss_ctrl* swiss_empty_group() noexcept {
+    alignas(16) static swiss_ctrl res[16] = {swiss_sentinel, swiss_empty, swiss_empty, swiss_empty,
+                                             swiss_empty,    swiss_empty, swiss_empty, swiss_empty,
+                                             swiss_empty,    swiss_empty, swiss_empty, swiss_empty,
+                                             swiss_empty,    swiss_empty, swiss_empty, swiss_empty};
+
+    return res;
+}
+
+} // namespace detail
+
+template<class T, class Reference>
+class swiss_table_iterator : public input_iterator_base<swiss_table_iterator<T, Reference>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = T;
+    using pointer           = remove_reference_t<Reference>*;
+    using reference         = Reference;
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept  = std::forward_iterator_tag;
+
+private:
+    const detail::swiss_ctrl* ctrl_{nullptr};
+    pointer slot_{nullptr};
+
+    // The sentinel stops it.
+    void skip_empty_or_deleted() noexcept {
+        while (*ctrl_ < detail::swiss_sentinel) {
+            ++ctrl_;
+            ++slot_;
+        }
+    }
+
+public:
+    swiss_table_iterator() = default;
+
+    swiss_table_iterator(const detail::swiss_ctrl* ctrl, const pointer slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {
+        skip_empty_or_deleted();
+    }
+
+    template<class R, enable_if_t<std::is_convertible<remove_reference_t<R>*, pointer>::value> = 0>
+    swiss_table_iterator(const swiss_table_iterator<T, R>& other) noexcept
+        : ctrl_(other.ctrl()), slot_(other.slot()) {}
+
+    void go_next() noexcept {
+        CIEL_ASSERT(detail::swiss_is_full(*ctrl_));
+
+        ++ctrl_;
+        ++slot_;
+        skip_empty_or_deleted();
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        CIEL_ASSERT(detail::swiss_is_full(*ctrl_));
+
+        return *slot_;
+    }
+
+    CIEL_NODISCARD pointer operator->() const noexcept {
+        return slot_;
+    }
+
+    CIEL_NODISCARD const detail::swiss_ctrl* ctrl() const noexcept {
+        return ctrl_;
+    }
+
+    CIEL_NODISCARD pointer slot() const noexcept {
+        return slot_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const swiss_table_iterator& lhs, const swiss_table_iterator& rhs) noexcept {
+        return lhs.ctrl() == rhs.ctrl();
+    }
+
+}; // class swiss_table_iterator
+
+template<class Policy, class Hash, class KeyEqual, class Allocator>
+class swiss_table {
+    static_assert(std::is_same<typename Allocator::value_type, typename Policy::value_type>::value, "");
+
+public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = KeyEqual;
+    using allocator_type  = Allocator;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using const_iterator  = swiss_table_iterator<value_type, const_reference>;
+    using iterator        = conditional_t<Policy::constant_iterator, const_iterator,
+                                          swiss_table_iterator<value_type, reference>>;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    using group        = detail::swiss_group;
+    using ctrl_type    = detail::swiss_ctrl;
+
+    // Control bytes and slots share one allocation of blocks.
+    using block_type      = typename aligned_storage<alignof(value_type), alignof(value_type)>::type;
+    using block_allocator = typename alloc_traits::template rebind_alloc<block_type>;
+    using block_traits    = typename alloc_traits::template rebind_traits<block_type>;
+
+    static_assert(std::is_same<typename alloc_traits::pointer, value_type*>::value, "");
+
+    template<class H = Hash, class E = KeyEqual>
+    using is_transparent_lookup = bool_constant<is_transparent<H>::value && is_transparent<E>::value>;
+
+    ctrl_type* ctrl_{detail::swiss_empty_group()};
+    pointer slots_{nullptr};
+    size_type size_{0};
+    size_type capacity_{0};
+    size_type growth_left_{0};
+    compressed_pair<hasher, compressed_pair<key_equal, allocator_type>> hash_eq_alloc_;
+
+    hasher& hash_() noexcept {
+        return hash_eq_alloc_.first();
+    }
+
+    const hasher& hash_() const noexcept {
+        return hash_eq_alloc_.first();
+    }
+
+    key_equal& eq_() noexcept {
+        return hash_eq_alloc_.second().first();
+    }
+
+    const key_equal& eq_() const noexcept {
+        return hash_eq_alloc_.second().first();
+    }
+
+    allocator_type& allocator_() noexcept {
+        return hash_eq_alloc_.second().second();
+    }
+
+    const allocator_type& allocator_() const noexcept {
+        return hash_eq_alloc_.second().second();
+    }
+
+    // capacity helpers
+
+    CIEL_NODISCARD static size_type normalize_capacity(const size_type n) noexcept {
+        size_type res = group::width - 1;
+        while (res < n) {
+            res = res * 2 + 1;
+        }
+
+        return res;
+    }
+
+    // Leaves at least one empty slot, so that probing always ends.
+    CIEL_NODISCARD static size_type capacity_to_growth(const size_type cap) noexcept {
+        if (group::width == 8 && cap == 7) {
+            return 6;
+        }
+
+        return cap - cap / 8;
+    }
+
+    CIEL_NODISCARD static size_type growth_to_capacity(const size_type growth) noexcept {
+        if (growth == 0) {
+            return 0;
+        }
+
+        if (group::width == 8 && growth == 7) {
+            return 8;
+        }
+
+        return growth + (growth - 1) / 7;
+    }
+
+    // control bytes, the sentinel and the cloned group
+    CIEL_NODISCARD static size_type ctrl_bytes(const size_type cap) noexcept {
+        return cap + group::width;
+    }
+
+    CIEL_NODISCARD static size_type slot_offset(const size_type cap) noexcept {
+        return (ctrl_bytes(cap) + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+    }
+
+    CIEL_NODISCARD static size_type allocation_blocks(const size_type cap) noexcept {
+        return (slot_offset(cap) + cap * sizeof(value_type) + sizeof(block_type) - 1) / sizeof(block_type);
+    }
+
+    // hash helpers
+
+    template<class K>
+    CIEL_NODISCARD size_t hash_of(const K& key) const {
+        return detail::swiss_mix(hash_()(key));
+    }
+
+    // Seeded by the address of the control bytes, so that two tables iterate in different orders.
+    // Otherwise inserting one's elements to the other in order would cluster badly.
+    CIEL_NODISCARD size_t h1(const size_t hash) const noexcept {
+        return (hash >> 7) ^ (reinterpret_cast<uintptr_t>(ctrl_) >> 12);
+    }
+
+    CIEL_NODISCARD static ctrl_type h2(const size_t hash) noexcept {
+        return static_cast<ctrl_type>(hash & 0x7F);
+    }
+
+    // Keep the cloned group in sync. When i >= width - 1, this writes the same byte twice.
+    void set_ctrl(const size_type i, const ctrl_type c) noexcept {
+        CIEL_ASSERT(i < capacity_);
+
+        ctrl_[i]                                                           = c;
+        ctrl_[((i - (group::width - 1)) & capacity_) + (group::width - 1)] = c;
+    }
+
+    void reset_ctrl() noexcept {
+        std::memset(ctrl_, detail::swiss_empty, ctrl_bytes(capacity_));
+        ctrl_[capacity_] = detail::swiss_sentinel;
+        growth_left_     = capacity_to_growth(capacity_) - size_;
+    }
+
+    CIEL_NODISCARD iterator iterator_at(const size_type i) noexcept {
+        return iterator(ctrl_ + i, slots_ + i);
+    }
+
+    CIEL_NODISCARD const_iterator iterator_at(const size_type i) const noexcept {
+        return const_iterator(ctrl_ + i, slots_ + i);
+    }
+
+    // Returns capacity_ if not found.
+    template<class K>
+    CIEL_NODISCARD size_type find_index(const K& key, const size_t hash) const {
+        if (size_ == 0) {
+            return capacity_;
+        }
+
+        detail::swiss_probe seq(h1(hash), capacity_);
+
+        while (true) {
+            const group g(ctrl_ + seq.offset());
+
+            for (auto mask = g.match(h2(hash)); mask; mask.clear_lowest()) {
+                const size_type i = seq.offset(mask.lowest());
+
+                if CIEL_LIKELY (eq_()(Policy::key(slots_[i]), key)) {
+                    return i;
+                }
+            }
+
+            if CIEL_LIKELY (g.match_empty()) {
+                return capacity_;
+            }
+
+            seq.next();
+            CIEL_ASSERT(seq.index() <= capacity_);
+        }
+    }
+
+    CIEL_NODISCARD size_type find_first_non_full(const size_t hash) const noexcept {
+        detail::swiss_probe seq(h1(hash), capacity_);
+
+        while (true) {
+            const auto mask = group(ctrl_ + seq.offset()).match_empty_or_deleted();
+
+            if CIEL_LIKELY (mask) {
+                return seq.offset(mask.lowest());
+            }
+
+            seq.next();
+            CIEL_ASSERT(seq.index() <= capacity_);
+        }
+    }
+
+    // Marks a slot for an element of hash, the caller constructs the element then.
+    size_type prepare_insert(const size_t hash) {
+        size_type i = capacity_ == 0 ? 0 : find_first_non_full(hash);
+
+        if CIEL_UNLIKELY (growth_left_ == 0 && (capacity_ == 0 || ctrl_[i] != detail::swiss_deleted)) {
+            rehash_and_grow();
+            i = find_first_non_full(hash);
+        }
+
+        growth_left_ -= ctrl_[i] == detail::swiss_empty;
+        set_ctrl(i, h2(hash));
+        ++size_;
+
+        return i;
+    }
+
+    // A slot can become empty instead of deleted if no probing could have passed it, i.e. there are less than
+    // a group of full or deleted slots around it.
+    void erase_meta(const size_type i) noexcept {
+        CIEL_ASSERT(detail::swiss_is_full(ctrl_[i]));
+
+        --size_;
+
+        const size_type index_before = (i - group::width) & capacity_;
+        const auto empty_after       = group(ctrl_ + i).match_empty();
+        const auto empty_before      = group(ctrl_ + index_before).match_empty();
+
+        const bool was_never_full
+            = empty_before && empty_after
+           && empty_after.trailing_zeros() + empty_before.leading_zeros(group::significant_bits()) < group::width;
+
+        set_ctrl(i, was_never_full ? detail::swiss_empty : detail::swiss_deleted);
+        growth_left_ += was_never_full;
+    }
+
+    void erase_at(const size_type i) noexcept {
+        alloc_traits::destroy(allocator_(), slots_ + i);
+        erase_meta(i);
+    }
+
+    template<class K, class Constructor>
+    std::pair<iterator, bool> find_or_insert(const K& key, Constructor&& construct) {
+        const size_t hash = hash_of(key);
+
+        size_type i = find_index(key, hash);
+        if (i != capacity_) {
+            return {iterator_at(i), false};
+        }
+
+        i = prepare_insert(hash);
+
+        CIEL_TRY {
+            construct(slots_ + i);
+        }
+        CIEL_CATCH (...) {
+            erase_meta(i);
+            CIEL_THROW;
+        }
+
+        return {iterator_at(i), true};
+    }
+
+    // rehash
+
+    void allocate(const size_type cap) {
+        block_allocator alloc(allocator_());
+        block_type* const blocks = block_traits::allocate(alloc, allocation_blocks(cap));
+
+        ctrl_     = reinterpret_cast<ctrl_type*>(blocks);
+        slots_    = reinterpret_cast<pointer>(reinterpret_cast<unsigned char*>(blocks) + slot_offset(cap));
+        capacity_ = cap;
+        reset_ctrl();
+    }
+
+    static void deallocate(allocator_type& allocator, ctrl_type* ctrl, const size_type cap) noexcept {
+        if (cap != 0) {
+            block_allocator alloc(allocator);
+            block_traits::deallocate(alloc, reinterpret_cast<block_type*>(ctrl), allocation_blocks(cap));
+        }
+    }
+
+    void destroy_elements() noexcept {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = 0; i < capacity_; ++i) {
+                if (detail::swiss_is_full(ctrl_[i])) {
+                    alloc_traits::destroy(allocator_(), slots_ + i);
+                }
+            }
+        }
+    }
+
+    void destroy_and_deallocate() noexcept {
+        destroy_elements();
+        deallocate(allocator_(), ctrl_, capacity_);
+
+        ctrl_        = detail::swiss_empty_group();
+        slots_       = nullptr;
+        size_        = 0;
+        capacity_    = 0;
+        growth_left_ = 0;
+    }
+
+    // Elements are placed into the new table, the old table is then released.
+    void transfer_from(const ctrl_type* old_ctrl, const pointer old_slots, const size_type old_cap,
+                       std::true_type /* trivially relocatable */) noexcept {
+        for (size_type i = 0; i < old_cap; ++i) {
+            if (detail::swiss_is_full(old_ctrl[i])) {
+                const size_t hash = hash_of(Policy::key(old_slots[i]));
+                const size_type j = find_first_non_full(hash);
+
+                set_ctrl(j, h2(hash));
+                std::memcpy(static_cast<void*>(slots_ + j), static_cast<const void*>(old_slots + i),
+                            sizeof(value_type));
+            }
+        }
+    }
+
+    void transfer_from(const ctrl_type* old_ctrl, const pointer old_slots, const size_type old_cap,
+                       std::false_type /* trivially relocatable */) {
+        transfer_from(old_ctrl, old_slots, old_cap, std::false_type{}, bool_constant<Policy::nothrow_transfer>{});
+    }
+
+    void transfer_from(const ctrl_type* old_ctrl, const pointer old_slots, const size_type old_cap,
+                       std::false_type /* trivially relocatable */, std::true_type /* nothrow */) noexcept {
+        for (size_type i = 0; i < old_cap; ++i) {
+            if (detail::swiss_is_full(old_ctrl[i])) {
+                const size_t hash = hash_of(Policy::key(old_slots[i]));
+                const size_type j = find_first_non_full(hash);
+
+                set_ctrl(j, h2(hash));
+                Policy::transfer(allocator_(), slots_ + j, old_slots + i);
+            }
+        }
+    }
+
+    // Copy everything, so that the old table stays intact if any copy throws.
+    void transfer_from(const ctrl_type* old_ctrl, const pointer old_slots, const size_type old_cap,
+                       std::false_type /* trivially relocatable */, std::false_type /* nothrow */) {
+        CIEL_TRY {
+            for (size_type i = 0; i < old_cap; ++i) {
+                if (detail::swiss_is_full(old_ctrl[i])) {
+                    const size_t hash = hash_of(Policy::key(old_slots[i]));
+                    const size_type j = find_first_non_full(hash);
+
+                    alloc_traits::construct(allocator_(), slots_ + j, static_cast<const value_type&>(old_slots[i]));
+                    set_ctrl(j, h2(hash));
+                }
+            }
+        }
+        CIEL_CATCH (...) {
+            destroy_elements();
+            deallocate(allocator_(), ctrl_, capacity_);
+            CIEL_THROW;
+        }
+
+        for (size_type i = 0; i < old_cap; ++i) {
+            if (detail::swiss_is_full(old_ctrl[i])) {
+                alloc_traits::destroy(allocator_(), old_slots + i);
+            }
+        }
+    }
+
+    void resize(const size_type new_cap) {
+        CIEL_ASSERT(new_cap == normalize_capacity(new_cap));
+        CIEL_ASSERT(capacity_to_growth(new_cap) >= size_);
+
+        ctrl_type* const old_ctrl  = ctrl_;
+        const pointer old_slots    = slots_;
+        const size_type old_cap    = capacity_;
+        const size_type old_growth = growth_left_;
+
+        allocate(new_cap);
+
+        CIEL_TRY {
+            transfer_from(old_ctrl, old_slots, old_cap, bool_constant<Policy::trivially_relocatable>{});
+        }
+        CIEL_CATCH (...) {
+            ctrl_        = old_ctrl;
+            slots_       = old_slots;
+            capacity_    = old_cap;
+            growth_left_ = old_growth;
+            CIEL_THROW;
+        }
+
+        deallocate(allocator_(), old_ctrl, old_cap);
+    }
+
+    // If deleted slots take much of the table, rehash in place instead of growing.
+    void rehash_and_grow() {
+        if (capacity_ == 0) {
+            resize(normalize_capacity(1));
+
+        } else if (capacity_ > group::width && size_ * 32 <= capacity_ * 25) {
+            resize(capacity_);
+
+        } else {
+            resize(capacity_ * 2 + 1);
+        }
+    }
+
+    template<class Iter>
+    void insert_range_impl(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    void copy_elements_from(const swiss_table& other) {
+        reserve(other.size());
+
+        for (const value_type& value : other) {
+            const size_type i = prepare_insert(hash_of(Policy::key(value)));
+
+            CIEL_TRY {
+                alloc_traits::construct(allocator_(), slots_ + i, value);
+            }
+            CIEL_CATCH (...) {
+                erase_meta(i);
+                CIEL_THROW;
+            }
+        }
+    }
+
+    void steal(swiss_table& other) noexcept {
+        ctrl_        = ciel::exchange(other.ctrl_, detail::swiss_empty_group());
+        slots_       = ciel::exchange(other.slots_, nullptr);
+        size_        = ciel::exchange(other.size_, 0);
+        capacity_    = ciel::exchange(other.capacity_, 0);
+        growth_left_ = ciel::exchange(other.growth_left_, 0);
+    }
+
+    void move_assign(swiss_table& other, std::true_type) noexcept {
+        destroy_and_deallocate();
+
+        if (alloc_traits::propagate_on_container_move_assignment::value) {
+            allocator_() = std::move(other.allocator_());
+        }
+
+        steal(other);
+    }
+
+    void move_assign(swiss_table& other, std::false_type) {
+        if (allocator_() == other.allocator_()) {
+            move_assign(other, std::true_type{});
+            return;
+        }
+
+        clear();
+        reserve(other.size());
+
+        for (value_type& value : other) {
+            insert(std::move(value));
+        }
+    }
+
+    void swap_alloc(swiss_table& other, std::true_type) noexcept {
+        using std::swap;
+        swap(allocator_(), other.allocator_());
+    }
+
+    void swap_alloc(swiss_table&, std::false_type) noexcept {}
+
+protected:
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args) {
+        return find_or_insert(key, [&](const pointer p) {
+            alloc_traits::construct(allocator_(), p, std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+    }
+
+public:
+    swiss_table() = default;
+
+    explicit swiss_table(const size_type bucket_count, const hasher& hash = hasher(),
+                         const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        : hash_eq_alloc_(hash, compressed_pair<key_equal, allocator_type>(equal, alloc)) {
+        if (bucket_count != 0) {
+            resize(normalize_capacity(bucket_count));
+        }
+    }
+
+    explicit swiss_table(const allocator_type& alloc)
+        : swiss_table(0, hasher(), key_equal(), alloc) {}
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    swiss_table(Iter first, Iter last, const size_type bucket_count = 0, const hasher& hash = hasher(),
+                const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type())
+        : swiss_table(bucket_count, hash, equal, alloc) {
+        insert(first, last);
+    }
+
+    swiss_table(std::initializer_list<value_type> init, const size_type bucket_count = 0,
+                const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+                const allocator_type& alloc = allocator_type())
+        : swiss_table(init.begin(), init.end(), bucket_count, hash, equal, alloc) {}
+
+    swiss_table(const swiss_table& other)
+        : hash_eq_alloc_(other.hash_(),
+                         compressed_pair<key_equal, allocator_type>(
+                             other.eq_(), alloc_traits::select_on_container_copy_construction(other.allocator_()))) {
+        CIEL_TRY {
+            copy_elements_from(other);
+        }
+        CIEL_CATCH (...) {
+            destroy_and_deallocate();
+            CIEL_THROW;
+        }
+    }
+
+    swiss_table(swiss_table&& other) noexcept(std::is_nothrow_move_constructible<hasher>::value
+                                              && std::is_nothrow_move_constructible<key_equal>::value)
+        : hash_eq_alloc_(std::move(other.hash_eq_alloc_)) {
+        steal(other);
+    }
+
+    swiss_table& operator=(const swiss_table& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        if (alloc_traits::propagate_on_container_copy_assignment::value && allocator_() != other.allocator_()) {
+            destroy_and_deallocate();
+            allocator_() = other.allocator_();
+
+        } else {
+            clear();
+        }
+
+        hash_() = other.hash_();
+        eq_()   = other.eq_();
+        copy_elements_from(other);
+
+        return *this;
+    }
+
+    swiss_table& operator=(swiss_table&& other) noexcept((alloc_traits::propagate_on_container_move_assignment::value
+                                                          || alloc_traits::is_always_equal::value)
+                                                         && std::is_nothrow_move_assignable<hasher>::value
+                                                         && std::is_nothrow_move_assignable<key_equal>::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        hash_() = std::move(other.hash_());
+        eq_()   = std::move(other.eq_());
+        move_assign(other, bool_constant < alloc_traits::propagate_on_container_move_assignment::value
+                                               || alloc_traits::is_always_equal::value > {});
+
+        return *this;
+    }
+
+    ~swiss_table() {
+        destroy_and_deallocate();
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    CIEL_NODISCARD hasher hash_function() const {
+        return hash_();
+    }
+
+    CIEL_NODISCARD key_equal key_eq() const {
+        return eq_();
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return iterator_at(0);
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return iterator_at(0);
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return iterator_at(capacity_);
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return iterator_at(capacity_);
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return std::numeric_limits<difference_type>::max() / (sizeof(value_type) + 1);
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    CIEL_NODISCARD size_type bucket_count() const noexcept {
+        return capacity_;
+    }
+
+    CIEL_NODISCARD float load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+    }
+
+    CIEL_NODISCARD float max_load_factor() const noexcept {
+        return 7.0f / 8.0f;
+    }
+
+    // Capacity is kept.
+    void clear() noexcept {
+        destroy_elements();
+
+        if (capacity_ != 0) {
+            size_ = 0;
+            reset_ctrl();
+        }
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return find_or_insert(Policy::key(value), [&](const pointer p) {
+            alloc_traits::construct(allocator_(), p, value);
+        });
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return find_or_insert(Policy::key(value), [&](const pointer p) {
+            alloc_traits::construct(allocator_(), p, std::move(value));
+        });
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert(std::move(value)).first;
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    void insert(Iter first, Iter last) {
+        if (is_forward_iterator<Iter>::value) {
+            reserve(size() + std::distance(first, last));
+        }
+
+        insert_range_impl(first, last);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    template<class R, enable_if_t<is_range<R>::value> = 0>
+    void insert_range(R&& rg) {
+        if (std::is_lvalue_reference<R>::value) {
+            insert(rg.begin(), rg.end());
+
+        } else {
+            insert(std::make_move_iterator(rg.begin()), std::make_move_iterator(rg.end()));
+        }
+    }
+
+    // The element is constructed at first to get the key.
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+
+        return insert(std::move(value));
+    }
+
+    template<class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    iterator erase(const_iterator pos) noexcept {
+        const size_type i = pos.ctrl() - ctrl_;
+        CIEL_ASSERT(i < capacity_);
+
+        erase_at(i);
+
+        return iterator_at(i);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        while (first != last) {
+            first = erase(first);
+        }
+
+        return iterator_at(last.ctrl() - ctrl_);
+    }
+
+    size_type erase(const key_type& key) {
+        const size_type i = find_index(key, hash_of(key));
+
+        if (i == capacity_) {
+            return 0;
+        }
+
+        erase_at(i);
+        return 1;
+    }
+
+    template<class K, class H = Hash,
+             enable_if_t<is_transparent_lookup<H>::value && !std::is_convertible<K, iterator>::value
+                         && !std::is_convertible<K, const_iterator>::value> = 0>
+    size_type erase(const K& key) {
+        const size_type i = find_index(key, hash_of(key));
+
+        if (i == capacity_) {
+            return 0;
+        }
+
+        erase_at(i);
+        return 1;
+    }
+
+    void swap(swiss_table& other) noexcept {
+        using std::swap;
+
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_(), other.hash_());
+        swap(eq_(), other.eq_());
+        swap_alloc(other, typename alloc_traits::propagate_on_container_swap{});
+    }
+
+    CIEL_NODISCARD iterator find(const key_type& key) {
+        return iterator_at(find_index(key, hash_of(key)));
+    }
+
+    CIEL_NODISCARD const_iterator find(const key_type& key) const {
+        return iterator_at(find_index(key, hash_of(key)));
+    }
+
+    template<class K, class H = Hash, enable_if_t<is_transparent_lookup<H>::value> = 0>
+    CIEL_NODISCARD iterator find(const K& key) {
+        return iterator_at(find_index(key, hash_of(key)));
+    }
+
+    template<class K, class H = Hash, enable_if_t<is_transparent_lookup<H>::value> = 0>
+    CIEL_NODISCARD const_iterator find(const K& key) const {
+        return iterator_at(find_index(key, hash_of(key)));
+    }
+
+    CIEL_NODISCARD bool contains(const key_type& key) const {
+        return find_index(key, hash_of(key)) != capacity_;
+    }
+
+    template<class K, class H = Hash, enable_if_t<is_transparent_lookup<H>::value> = 0>
+    CIEL_NODISCARD bool contains(const K& key) const {
+        return find_index(key, hash_of(key)) != capacity_;
+    }
+
+    CIEL_NODISCARD size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<class K, class H = Hash, enable_if_t<is_transparent_lookup<H>::value> = 0>
+    CIEL_NODISCARD size_type count(const K& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Makes room for count elements without growing.
+    void reserve(const size_type count) {
+        if (count > size_ + growth_left_) {
+            resize(normalize_capacity(growth_to_capacity(count)));
+        }
+    }
+
+    // Rehashes to at least count slots, or shrinks to fit if count is 0.
+    void rehash(const size_type count) {
+        if (count == 0 && size_ == 0) {
+            destroy_and_deallocate();
+            return;
+        }
+
+        const size_type new_cap = normalize_capacity(ciel::max(count, growth_to_capacity(size_)));
+        if (new_cap != capacity_) {
+            resize(new_cap);
+        }
+    }
+
+}; // class swiss_table
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_CORE_SWISS_TABLE_HPP_
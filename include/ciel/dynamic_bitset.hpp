@@ -0,0 +1,568 @@
+#ifndef CIELLAB_INCLUDE_CIEL_DYNAMIC_BITSET_HPP_
+#define CIELLAB_INCLUDE_CIEL_DYNAMIC_BITSET_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/simd.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// dynamic_bitset
+// A resizable sequence of bits packed into a ciel::vector<uint64_t>, one bit per element instead of one byte.
+// Bulk boolean operations work a word at a time, which compilers vectorize, and count() goes through the
+// SIMD popcount of core/simd.hpp.
+// Bits past size() in the last word are always zero, so whole words can be counted and compared.
+//
+// rank(pos) and select(k) scan the words. bitset_rank_index answers them in O(1) and O(log n) instead,
+// for bitsets which are queried much more often than modified.
+
+template<class Allocator = std::allocator<uint64_t>>
+class dynamic_bitset {
+public:
+    using word_type       = uint64_t;
+    using size_type       = size_t;
+    using allocator_type  = Allocator;
+    using const_reference = bool;
+
+    static constexpr size_type bits_per_word = 64;
+
+    class reference {
+    private:
+        word_type* word_;
+        word_type mask_;
+
+    public:
+        reference(word_type* word, const size_type bit) noexcept
+            : word_(word), mask_(word_type{1} << bit) {}
+
+        reference(const reference&) = default;
+
+        reference& operator=(const bool value) noexcept {
+            if (value) {
+                *word_ |= mask_;
+
+            } else {
+                *word_ &= ~mask_;
+            }
+
+            return *this;
+        }
+
+        reference& operator=(const reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        CIEL_NODISCARD bool operator~() const noexcept {
+            return (*word_ & mask_) == 0;
+        }
+
+        reference& flip() noexcept {
+            *word_ ^= mask_;
+            return *this;
+        }
+
+    }; // class reference
+
+private:
+    vector<word_type, allocator_type> words_;
+    size_type size_{0};
+
+    CIEL_NODISCARD static size_type word_count(const size_type n) noexcept {
+        return (n + bits_per_word - 1) / bits_per_word;
+    }
+
+    CIEL_NODISCARD static word_type fill_word(const bool value) noexcept {
+        return value ? ~word_type{0} : word_type{0};
+    }
+
+    // Clear the bits past size_ in the last word.
+    void trim() noexcept {
+        const size_type extra = size_ % bits_per_word;
+
+        if (extra != 0) {
+            words_.back() &= (word_type{1} << extra) - 1;
+        }
+    }
+
+    // Position of the k-th set bit of word, counted from 0. Halves are skipped by their popcount.
+    CIEL_NODISCARD static size_type select_in_word(word_type word, size_type k) noexcept {
+        CIEL_ASSERT(k < detail::popcount(word));
+
+        size_type res = 0;
+
+        for (size_type width = 32; width >= 8; width /= 2) {
+            const word_type low = word & ((word_type{1} << width) - 1);
+            const size_type c   = detail::popcount(low);
+
+            if (k >= c) {
+                k -= c;
+                word >>= width;
+                res += width;
+
+            } else {
+                word = low;
+            }
+        }
+
+        for (; k != 0; --k) {
+            word &= word - 1;
+        }
+
+        return res + detail::countr_zero(word);
+    }
+
+    template<class>
+    friend class bitset_rank_index;
+
+public:
+    dynamic_bitset() = default;
+
+    explicit dynamic_bitset(const allocator_type& alloc)
+        : words_(alloc) {}
+
+    explicit dynamic_bitset(const size_type count, const bool value = false,
+                            const allocator_type& alloc = allocator_type())
+        : words_(word_count(count), fill_word(value), alloc), size_(count) {
+        trim();
+    }
+
+    dynamic_bitset(const dynamic_bitset&) = default;
+
+    dynamic_bitset(dynamic_bitset&& other) noexcept
+        : words_(std::move(other.words_)), size_(ciel::exchange(other.size_, 0)) {}
+
+    dynamic_bitset& operator=(const dynamic_bitset&) = default;
+
+    dynamic_bitset& operator=(dynamic_bitset&& other) noexcept {
+        words_ = std::move(other.words_);
+        size_  = ciel::exchange(other.size_, 0);
+
+        return *this;
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return words_.get_allocator();
+    }
+
+    CIEL_NODISCARD bool operator[](const size_type pos) const noexcept {
+        CIEL_ASSERT(pos < size_);
+
+        return (words_[pos / bits_per_word] >> (pos % bits_per_word)) & 1;
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) noexcept {
+        CIEL_ASSERT(pos < size_);
+
+        return reference(words_.data() + pos / bits_per_word, pos % bits_per_word);
+    }
+
+    CIEL_NODISCARD bool test(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size_) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::dynamic_bitset"));
+        }
+
+        return operator[](pos);
+    }
+
+    CIEL_NODISCARD word_type* data() noexcept {
+        return words_.data();
+    }
+
+    CIEL_NODISCARD const word_type* data() const noexcept {
+        return words_.data();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type num_words() const noexcept {
+        return words_.size();
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return words_.capacity() * bits_per_word;
+    }
+
+    void reserve(const size_type new_cap) {
+        words_.reserve(word_count(new_cap));
+    }
+
+    void shrink_to_fit() {
+        words_.shrink_to_fit();
+    }
+
+    void clear() noexcept {
+        words_.clear();
+        size_ = 0;
+    }
+
+    void resize(const size_type count, const bool value = false) {
+        if (count > size_ && value) {
+            const size_type extra = size_ % bits_per_word;
+
+            if (extra != 0) {
+                words_.back() |= ~word_type{0} << extra;
+            }
+        }
+
+        words_.resize(word_count(count), fill_word(value));
+        size_ = count;
+        trim();
+    }
+
+    void push_back(const bool value) {
+        if (size_ % bits_per_word == 0) {
+            words_.emplace_back(0);
+        }
+
+        words_.back() |= static_cast<word_type>(value) << (size_ % bits_per_word);
+        ++size_;
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        --size_;
+
+        if (size_ % bits_per_word == 0) {
+            words_.pop_back();
+
+        } else {
+            trim();
+        }
+    }
+
+    dynamic_bitset& set() noexcept {
+        std::fill(words_.begin(), words_.end(), fill_word(true));
+        trim();
+
+        return *this;
+    }
+
+    dynamic_bitset& set(const size_type pos, const bool value = true) noexcept {
+        operator[](pos) = value;
+
+        return *this;
+    }
+
+    dynamic_bitset& reset() noexcept {
+        std::fill(words_.begin(), words_.end(), fill_word(false));
+
+        return *this;
+    }
+
+    dynamic_bitset& reset(const size_type pos) noexcept {
+        return set(pos, false);
+    }
+
+    dynamic_bitset& flip() noexcept {
+        for (word_type& word : words_) {
+            word = ~word;
+        }
+        trim();
+
+        return *this;
+    }
+
+    dynamic_bitset& flip(const size_type pos) noexcept {
+        operator[](pos).flip();
+
+        return *this;
+    }
+
+    // Bulk operations, both sides should have the same size.
+
+    dynamic_bitset& operator&=(const dynamic_bitset& other) noexcept {
+        CIEL_ASSERT(size_ == other.size_);
+
+        word_type* p       = words_.data();
+        const word_type* q = other.words_.data();
+
+        for (size_type i = 0; i < words_.size(); ++i) {
+            p[i] &= q[i];
+        }
+
+        return *this;
+    }
+
+    dynamic_bitset& operator|=(const dynamic_bitset& other) noexcept {
+        CIEL_ASSERT(size_ == other.size_);
+
+        word_type* p       = words_.data();
+        const word_type* q = other.words_.data();
+
+        for (size_type i = 0; i < words_.size(); ++i) {
+            p[i] |= q[i];
+        }
+
+        return *this;
+    }
+
+    dynamic_bitset& operator^=(const dynamic_bitset& other) noexcept {
+        CIEL_ASSERT(size_ == other.size_);
+
+        word_type* p       = words_.data();
+        const word_type* q = other.words_.data();
+
+        for (size_type i = 0; i < words_.size(); ++i) {
+            p[i] ^= q[i];
+        }
+
+        return *this;
+    }
+
+    // *this &= ~other, without materializing ~other.
+    dynamic_bitset& and_not(const dynamic_bitset& other) noexcept {
+        CIEL_ASSERT(size_ == other.size_);
+
+        word_type* p       = words_.data();
+        const word_type* q = other.words_.data();
+
+        for (size_type i = 0; i < words_.size(); ++i) {
+            p[i] &= ~q[i];
+        }
+
+        return *this;
+    }
+
+    CIEL_NODISCARD dynamic_bitset operator~() const {
+        dynamic_bitset res(*this);
+        res.flip();
+
+        return res;
+    }
+
+    CIEL_NODISCARD size_type count() const noexcept {
+        return detail::popcount(words_.data(), words_.size());
+    }
+
+    CIEL_NODISCARD bool all() const noexcept {
+        const size_type full = size_ / bits_per_word;
+
+        for (size_type i = 0; i < full; ++i) {
+            if (words_[i] != fill_word(true)) {
+                return false;
+            }
+        }
+
+        const size_type extra = size_ % bits_per_word;
+
+        return extra == 0 || words_.back() == (word_type{1} << extra) - 1;
+    }
+
+    CIEL_NODISCARD bool any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](const word_type word) {
+            return word != 0;
+        });
+    }
+
+    CIEL_NODISCARD bool none() const noexcept {
+        return !any();
+    }
+
+    // Position of the first set bit at or after pos, or size() if there is none.
+    CIEL_NODISCARD size_type find_next(const size_type pos) const noexcept {
+        if (pos >= size_) {
+            return size_;
+        }
+
+        size_type i    = pos / bits_per_word;
+        word_type word = words_[i] & (~word_type{0} << (pos % bits_per_word));
+
+        while (word == 0) {
+            if (++i == words_.size()) {
+                return size_;
+            }
+
+            word = words_[i];
+        }
+
+        return i * bits_per_word + detail::countr_zero(word);
+    }
+
+    CIEL_NODISCARD size_type find_first() const noexcept {
+        return find_next(0);
+    }
+
+    // Number of set bits in [0, pos).
+    CIEL_NODISCARD size_type rank(const size_type pos) const noexcept {
+        CIEL_ASSERT(pos <= size_);
+
+        const size_type full  = pos / bits_per_word;
+        const size_type extra = pos % bits_per_word;
+
+        size_type res = detail::popcount(words_.data(), full);
+        if (extra != 0) {
+            res += detail::popcount(words_[full] & ((word_type{1} << extra) - 1));
+        }
+
+        return res;
+    }
+
+    // Position of the k-th set bit counted from 0, or size() if there are no more than k set bits.
+    CIEL_NODISCARD size_type select(size_type k) const noexcept {
+        for (size_type i = 0; i < words_.size(); ++i) {
+            const size_type c = detail::popcount(words_[i]);
+
+            if (k < c) {
+                return i * bits_per_word + select_in_word(words_[i], k);
+            }
+
+            k -= c;
+        }
+
+        return size_;
+    }
+
+    void swap(dynamic_bitset& other) noexcept {
+        using std::swap;
+
+        words_.swap(other.words_);
+        swap(size_, other.size_);
+    }
+
+    CIEL_NODISCARD friend bool operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs) noexcept {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.words_.begin(), lhs.words_.end(), rhs.words_.begin());
+    }
+
+    CIEL_NODISCARD friend bool operator!=(const dynamic_bitset& lhs, const dynamic_bitset& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    CIEL_NODISCARD friend dynamic_bitset operator&(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    CIEL_NODISCARD friend dynamic_bitset operator|(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    CIEL_NODISCARD friend dynamic_bitset operator^(dynamic_bitset lhs, const dynamic_bitset& rhs) noexcept {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+}; // class dynamic_bitset
+
+template<class Allocator>
+constexpr typename dynamic_bitset<Allocator>::size_type dynamic_bitset<Allocator>::bits_per_word;
+
+// bitset_rank_index
+// Cumulative popcounts of every block of 8 words (512 bits), 1/8 of the bitset's memory.
+// rank is one lookup plus at most 8 word popcounts, select is a binary search over the blocks.
+// It refers to the bitset, which must outlive it and not be modified after it's built.
+
+template<class Allocator = std::allocator<uint64_t>>
+class bitset_rank_index {
+public:
+    using bitset_type = dynamic_bitset<Allocator>;
+    using size_type   = typename bitset_type::size_type;
+
+private:
+    static constexpr size_type words_per_block = 8;
+
+    const bitset_type* bits_;
+    // blocks_[i] is the number of set bits before block i, the last one is the total.
+    vector<size_type> blocks_;
+
+public:
+    explicit bitset_rank_index(const bitset_type& bits)
+        : bits_(std::addressof(bits)),
+          blocks_(reserve_capacity, (bits.num_words() + words_per_block - 1) / words_per_block + 1) {
+        const size_type n = bits.num_words();
+        size_type sum     = 0;
+
+        for (size_type i = 0; i < n; i += words_per_block) {
+            blocks_.unchecked_emplace_back(sum);
+            sum += detail::popcount(bits.data() + i, ciel::min(words_per_block, n - i));
+        }
+
+        blocks_.unchecked_emplace_back(sum);
+    }
+
+    // Number of set bits in [0, pos).
+    CIEL_NODISCARD size_type rank(const size_type pos) const noexcept {
+        CIEL_ASSERT(pos <= bits_->size());
+
+        const size_type word  = pos / bitset_type::bits_per_word;
+        const size_type block = word / words_per_block;
+        const size_type extra = pos % bitset_type::bits_per_word;
+
+        size_type res = blocks_[block];
+        for (size_type i = block * words_per_block; i < word; ++i) {
+            res += detail::popcount(bits_->data()[i]);
+        }
+
+        if (extra != 0) {
+            res += detail::popcount(bits_->data()[word] & ((uint64_t{1} << extra) - 1));
+        }
+
+        return res;
+    }
+
+    // Position of the k-th set bit counted from 0, or size() if there are no more than k set bits.
+    CIEL_NODISCARD size_type select(size_type k) const noexcept {
+        if (k >= blocks_.back()) {
+            return bits_->size();
+        }
+
+        // The last block whose count of preceding set bits is no more than k.
+        const size_type block = std::upper_bound(blocks_.begin(), blocks_.end(), k) - blocks_.begin() - 1;
+        k -= blocks_[block];
+
+        for (size_type i = block * words_per_block;; ++i) {
+            const size_type c = detail::popcount(bits_->data()[i]);
+
+            if (k < c) {
+                return i * bitset_type::bits_per_word + bitset_type::select_in_word(bits_->data()[i], k);
+            }
+
+            k -= c;
+        }
+    }
+
+    CIEL_NODISCARD size_type count() const noexcept {
+        return blocks_.back();
+    }
+
+}; // class bitset_rank_index
+
+template<class Allocator>
+constexpr typename bitset_rank_index<Allocator>::size_type bitset_rank_index<Allocator>::words_per_block;
+
+template<class Allocator>
+struct is_trivially_relocatable<dynamic_bitset<Allocator>> : is_trivially_relocatable<vector<uint64_t, Allocator>> {};
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Allocator>
+void swap(ciel::dynamic_bitset<Allocator>& lhs, ciel::dynamic_bitset<Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_DYNAMIC_BITSET_HPP_
@@ -646,6 +646,7 @@ public:
 
 }; // class list
 
+// The first and last nodes point to end_node_, which lives inside the object, the same as std::list.
 template<class T, class Allocator>
 struct is_trivially_relocatable<list<T, Allocator>> : std::false_type {};
 
@@ -0,0 +1,516 @@
+#ifndef CIELLAB_INCLUDE_CIEL_FIND_HPP_
+#define CIELLAB_INCLUDE_CIEL_FIND_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_range.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/simd.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// find, count, contains and find_first_of over a contiguous range.
+//
+// When the range has data() and size() and its elements are arithmetic types of 1, 2, 4 or 8 bytes,
+// e.g. ciel::vector<uint32_t> or ciel::inplace_vector<char, N>, elements are compared 16 or 32 bytes at a time
+// with SSE2 or AVX2, which is picked at runtime. Other ranges fall back to the std algorithms.
+// Either way the results are the same as comparing each element with operator==.
+
+namespace detail {
+
+template<class T>
+struct is_simd_searchable_element
+    : bool_constant<std::is_arithmetic<T>::value
+                    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+                    && (!std::is_floating_point<T>::value || std::is_same<T, float>::value
+                        || std::is_same<T, double>::value)> {};
+
+template<>
+struct is_simd_searchable_element<void> : std::false_type {};
+
+// Values of type T can be searched in the range R with SIMD. Mixing types is only allowed between integers,
+// so that the only element which may equal value is static_cast<E>(value).
+template<class R, class T, class E = typename contiguous_element<R>::type>
+struct is_simd_searchable
+    : bool_constant<is_simd_searchable_element<E>::value
+                    && (std::is_same<E, remove_cv_t<T>>::value
+                        || (std::is_integral<E>::value && std::is_integral<T>::value))> {};
+
+// Convert value to E, return false if no E can equal value, e.g. searching -1 in a range of uint8_t.
+template<class E, class T>
+CIEL_NODISCARD bool to_needle(const T& value, E& needle) noexcept {
+    using C = typename std::common_type<E, T>::type;
+
+    needle = static_cast<E>(value);
+
+    return static_cast<C>(needle) == static_cast<C>(value);
+}
+
+#ifdef CIEL_HAS_X86_SIMD
+
+// Broadcast the bits of value to all lanes. Floating points are compared by the float instructions,
+// so that 0.0 == -0.0 and NaN != NaN.
+
+template<size_t Size>
+using lane_bits = conditional_t<Size == 1, int8_t,
+                                conditional_t<Size == 2, int16_t, conditional_t<Size == 4, int32_t, long long>>>;
+
+template<class T>
+CIEL_NODISCARD lane_bits<sizeof(T)> to_lane_bits(const T value) noexcept {
+    lane_bits<sizeof(T)> res;
+    static_assert(sizeof(res) == sizeof(T), "");
+
+    std::memcpy(&res, &value, sizeof(T));
+    return res;
+}
+
+CIEL_NODISCARD inline __m128i sse2_set1_bits(const int8_t bits) noexcept {
+    return _mm_set1_epi8(bits);
+}
+
+CIEL_NODISCARD inline __m128i sse2_set1_bits(const int16_t bits) noexcept {
+    return _mm_set1_epi16(bits);
+}
+
+CIEL_NODISCARD inline __m128i sse2_set1_bits(const int32_t bits) noexcept {
+    return _mm_set1_epi32(bits);
+}
+
+CIEL_NODISCARD inline __m128i sse2_set1_bits(const long long bits) noexcept {
+    return _mm_set1_epi64x(bits);
+}
+
+template<class T>
+CIEL_NODISCARD __m128i sse2_set1(const T value) noexcept {
+    return sse2_set1_bits(to_lane_bits(value));
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 1> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    return _mm_cmpeq_epi8(a, b);
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 2> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    return _mm_cmpeq_epi16(a, b);
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 4> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    return _mm_cmpeq_epi32(a, b);
+}
+
+// SSE2 has no 64-bit compare, both 32-bit halves should be equal.
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 8> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    const __m128i res = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(res, _mm_shuffle_epi32(res, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+template<class T, enable_if_t<std::is_same<T, float>::value> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+}
+
+template<class T, enable_if_t<std::is_same<T, double>::value> = 0>
+CIEL_NODISCARD __m128i sse2_eq(const __m128i a, const __m128i b) noexcept {
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+}
+
+// One bit per byte of the 16 bytes starting at p, set if the element containing that byte equals needle.
+template<class T>
+CIEL_NODISCARD uint32_t sse2_match(const T* p, const __m128i needle) noexcept {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    return static_cast<uint32_t>(_mm_movemask_epi8(sse2_eq<T>(x, needle)));
+}
+
+template<class T>
+CIEL_NODISCARD size_t find_sse2(const T* p, const size_t n, const T value) noexcept {
+    static constexpr size_t lanes = 16 / sizeof(T);
+
+    const __m128i needle = sse2_set1(value);
+    size_t i             = 0;
+
+    // Check 4 vectors at a time, then find out which one matches.
+    for (; i + lanes * 4 <= n; i += lanes * 4) {
+        const __m128i m0 = sse2_eq<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)), needle);
+        const __m128i m1 = sse2_eq<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + lanes)), needle);
+        const __m128i m2 = sse2_eq<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + lanes * 2)), needle);
+        const __m128i m3 = sse2_eq<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + lanes * 3)), needle);
+
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(m0, m1), _mm_or_si128(m2, m3))) != 0) {
+            break;
+        }
+    }
+
+    for (; i + lanes <= n; i += lanes) {
+        const uint32_t mask = sse2_match(p + i, needle);
+
+        if (mask != 0) {
+            return i + countr_zero(mask) / sizeof(T);
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+template<class T>
+CIEL_NODISCARD size_t count_sse2(const T* p, const size_t n, const T value) noexcept {
+    static constexpr size_t lanes = 16 / sizeof(T);
+
+    const __m128i needle = sse2_set1(value);
+    size_t i             = 0;
+    size_t res           = 0;
+
+    for (; i + lanes <= n; i += lanes) {
+        res += popcount(sse2_match(p + i, needle));
+    }
+
+    res /= sizeof(T);
+
+    for (; i < n; ++i) {
+        res += (p[i] == value);
+    }
+
+    return res;
+}
+
+template<class T>
+CIEL_NODISCARD size_t find_first_of_sse2(const T* p, const size_t n, const T* values, const size_t m) noexcept {
+    static constexpr size_t lanes = 16 / sizeof(T);
+
+    CIEL_ASSERT(m <= 16);
+
+    __m128i needles[16];
+    for (size_t j = 0; j < m; ++j) {
+        needles[j] = sse2_set1(values[j]);
+    }
+
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i eq      = _mm_setzero_si128();
+
+        for (size_t j = 0; j < m; ++j) {
+            eq = _mm_or_si128(eq, sse2_eq<T>(x, needles[j]));
+        }
+
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+
+        if (mask != 0) {
+            return i + countr_zero(mask) / sizeof(T);
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (std::find(values, values + m, p[i]) != values + m) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+#  define CIEL_TARGET_AVX2 __attribute__((target("avx2")))
+
+CIEL_TARGET_AVX2 CIEL_NODISCARD inline __m256i avx2_set1_bits(const int8_t bits) noexcept {
+    return _mm256_set1_epi8(bits);
+}
+
+CIEL_TARGET_AVX2 CIEL_NODISCARD inline __m256i avx2_set1_bits(const int16_t bits) noexcept {
+    return _mm256_set1_epi16(bits);
+}
+
+CIEL_TARGET_AVX2 CIEL_NODISCARD inline __m256i avx2_set1_bits(const int32_t bits) noexcept {
+    return _mm256_set1_epi32(bits);
+}
+
+CIEL_TARGET_AVX2 CIEL_NODISCARD inline __m256i avx2_set1_bits(const long long bits) noexcept {
+    return _mm256_set1_epi64x(bits);
+}
+
+template<class T>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_set1(const T value) noexcept {
+    return avx2_set1_bits(to_lane_bits(value));
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 1> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_cmpeq_epi8(a, b);
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 2> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_cmpeq_epi16(a, b);
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 4> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_cmpeq_epi32(a, b);
+}
+
+template<class T, enable_if_t<std::is_integral<T>::value && sizeof(T) == 8> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_cmpeq_epi64(a, b);
+}
+
+template<class T, enable_if_t<std::is_same<T, float>::value> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+}
+
+template<class T, enable_if_t<std::is_same<T, double>::value> = 0>
+CIEL_TARGET_AVX2 CIEL_NODISCARD __m256i avx2_eq(const __m256i a, const __m256i b) noexcept {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+}
+
+template<class T>
+CIEL_TARGET_AVX2 CIEL_NODISCARD uint32_t avx2_match(const T* p, const __m256i needle) noexcept {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(avx2_eq<T>(x, needle)));
+}
+
+template<class T>
+CIEL_TARGET_AVX2 CIEL_NODISCARD size_t find_avx2(const T* p, const size_t n, const T value) noexcept {
+    static constexpr size_t lanes = 32 / sizeof(T);
+
+    const __m256i needle = avx2_set1(value);
+    size_t i             = 0;
+
+    for (; i + lanes * 4 <= n; i += lanes * 4) {
+        const __m256i m0 = avx2_eq<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), needle);
+        const __m256i m1 = avx2_eq<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + lanes)), needle);
+        const __m256i m2 =
+            avx2_eq<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + lanes * 2)), needle);
+        const __m256i m3 =
+            avx2_eq<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + lanes * 3)), needle);
+
+        if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3)),
+                                _mm256_set1_epi8(-1))) {
+            break;
+        }
+    }
+
+    for (; i + lanes <= n; i += lanes) {
+        const uint32_t mask = avx2_match(p + i, needle);
+
+        if (mask != 0) {
+            return i + countr_zero(mask) / sizeof(T);
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+template<class T>
+CIEL_TARGET_AVX2 CIEL_NODISCARD size_t count_avx2(const T* p, const size_t n, const T value) noexcept {
+    static constexpr size_t lanes = 32 / sizeof(T);
+
+    const __m256i needle = avx2_set1(value);
+    size_t i             = 0;
+    size_t res           = 0;
+
+    for (; i + lanes <= n; i += lanes) {
+        res += popcount(avx2_match(p + i, needle));
+    }
+
+    res /= sizeof(T);
+
+    for (; i < n; ++i) {
+        res += (p[i] == value);
+    }
+
+    return res;
+}
+
+template<class T>
+CIEL_TARGET_AVX2 CIEL_NODISCARD size_t find_first_of_avx2(const T* p, const size_t n, const T* values,
+                                                          const size_t m) noexcept {
+    static constexpr size_t lanes = 32 / sizeof(T);
+
+    CIEL_ASSERT(m <= 16);
+
+    __m256i needles[16];
+    for (size_t j = 0; j < m; ++j) {
+        needles[j] = avx2_set1(values[j]);
+    }
+
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i eq      = _mm256_setzero_si256();
+
+        for (size_t j = 0; j < m; ++j) {
+            eq = _mm256_or_si256(eq, avx2_eq<T>(x, needles[j]));
+        }
+
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+
+        if (mask != 0) {
+            return i + countr_zero(mask) / sizeof(T);
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (std::find(values, values + m, p[i]) != values + m) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+#  undef CIEL_TARGET_AVX2
+
+#endif // CIEL_HAS_X86_SIMD
+
+// Return the index of the first element equal to value in [p, p + n), or n if there is none.
+template<class T>
+CIEL_NODISCARD size_t simd_find(const T* p, const size_t n, const T value) noexcept {
+#ifdef CIEL_HAS_X86_SIMD
+    // Less than one vector, skip the dispatch, which costs more than the loop for tiny ranges like small maps.
+    if (n < 16 / sizeof(T)) {
+        return std::find(p, p + n, value) - p;
+    }
+
+    if (cpu_supports_avx2()) {
+        return find_avx2(p, n, value);
+    }
+
+    return find_sse2(p, n, value);
+#else
+    return std::find(p, p + n, value) - p;
+#endif
+}
+
+template<class T>
+CIEL_NODISCARD size_t simd_count(const T* p, const size_t n, const T value) noexcept {
+#ifdef CIEL_HAS_X86_SIMD
+    if (cpu_supports_avx2()) {
+        return count_avx2(p, n, value);
+    }
+
+    return count_sse2(p, n, value);
+#else
+    return std::count(p, p + n, value);
+#endif
+}
+
+// values should have no more than 16 elements.
+template<class T>
+CIEL_NODISCARD size_t simd_find_first_of(const T* p, const size_t n, const T* values, const size_t m) noexcept {
+#ifdef CIEL_HAS_X86_SIMD
+    if (cpu_supports_avx2()) {
+        return find_first_of_avx2(p, n, values, m);
+    }
+
+    return find_first_of_sse2(p, n, values, m);
+#else
+    return std::find_first_of(p, p + n, values, values + m) - p;
+#endif
+}
+
+} // namespace detail
+
+// find
+
+template<class R, class T, enable_if_t<detail::is_simd_searchable<R, T>::value> = 0>
+CIEL_NODISCARD auto find(R& rg, const T& value) noexcept -> decltype(rg.begin()) {
+    using E = typename detail::contiguous_element<R>::type;
+
+    E needle;
+    if (!detail::to_needle(value, needle)) {
+        return rg.end();
+    }
+
+    return rg.begin() + detail::simd_find<E>(rg.data(), rg.size(), needle);
+}
+
+template<class R, class T, enable_if_t<!detail::is_simd_searchable<R, T>::value> = 0>
+CIEL_NODISCARD auto find(R& rg, const T& value) -> decltype(rg.begin()) {
+    return std::find(rg.begin(), rg.end(), value);
+}
+
+// count
+
+template<class R, class T, enable_if_t<detail::is_simd_searchable<R, T>::value> = 0>
+CIEL_NODISCARD size_t count(const R& rg, const T& value) noexcept {
+    using E = typename detail::contiguous_element<const R>::type;
+
+    E needle;
+    if (!detail::to_needle(value, needle)) {
+        return 0;
+    }
+
+    return detail::simd_count<E>(rg.data(), rg.size(), needle);
+}
+
+template<class R, class T, enable_if_t<!detail::is_simd_searchable<R, T>::value> = 0>
+CIEL_NODISCARD size_t count(const R& rg, const T& value) {
+    return std::count(rg.begin(), rg.end(), value);
+}
+
+// contains
+
+template<class R, class T>
+CIEL_NODISCARD bool contains(const R& rg, const T& value) {
+    return ciel::find(rg, value) != rg.end();
+}
+
+// find_first_of
+// Return the first element in rg which equals any of the elements in values.
+
+template<class R1, class R2,
+         enable_if_t<detail::is_simd_searchable<R1, typename detail::contiguous_element<R2>::type>::value> = 0>
+CIEL_NODISCARD auto find_first_of(R1& rg, const R2& values) -> decltype(rg.begin()) {
+    using E = typename detail::contiguous_element<R1>::type;
+
+    // Only values which can equal some element are searched.
+    E needles[16];
+    size_t m = 0;
+
+    for (auto it = values.begin(); it != values.end(); ++it) {
+        if (m == 16) {
+            return std::find_first_of(rg.begin(), rg.end(), values.begin(), values.end());
+        }
+
+        if (detail::to_needle(*it, needles[m])) {
+            ++m;
+        }
+    }
+
+    if (m == 0) {
+        return rg.end();
+    }
+
+    return rg.begin() + detail::simd_find_first_of<E>(rg.data(), rg.size(), needles, m);
+}
+
+template<class R1, class R2,
+         enable_if_t<!detail::is_simd_searchable<R1, typename detail::contiguous_element<R2>::type>::value> = 0>
+CIEL_NODISCARD auto find_first_of(R1& rg, const R2& values) -> decltype(rg.begin()) {
+    return std::find_first_of(rg.begin(), rg.end(), values.begin(), values.end());
+}
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_FIND_HPP_
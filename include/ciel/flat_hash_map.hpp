@@ -0,0 +1,201 @@
+#ifndef CIELLAB_INCLUDE_CIEL_FLAT_HASH_MAP_HPP_
+#define CIELLAB_INCLUDE_CIEL_FLAT_HASH_MAP_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/logical.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/swiss_table.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// flat_hash_map
+// An open addressing hash map which stores std::pair<const Key, T> inline, see core/swiss_table.hpp.
+// Unlike std::unordered_map, rehashing invalidates pointers and references to the elements, not only iterators.
+
+namespace detail {
+
+template<class Key, class T>
+struct flat_hash_map_policy {
+    using key_type   = Key;
+    using value_type = std::pair<const Key, T>;
+
+    static constexpr bool constant_iterator = false;
+    static constexpr bool trivially_relocatable
+        = conjunction<is_trivially_relocatable<Key>, is_trivially_relocatable<T>>::value;
+    static constexpr bool nothrow_transfer
+        = std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<T>::value;
+
+    CIEL_NODISCARD static const key_type& key(const value_type& value) noexcept {
+        return value.first;
+    }
+
+    // The source is destroyed right after, so its key can be moved from.
+    template<class Allocator>
+    static void transfer(Allocator& alloc, value_type* dst, value_type* src) noexcept {
+        std::allocator_traits<Allocator>::construct(alloc, dst, std::move(const_cast<Key&>(src->first)),
+                                                    std::move(src->second));
+        std::allocator_traits<Allocator>::destroy(alloc, src);
+    }
+
+}; // struct flat_hash_map_policy
+
+template<class Key, class T>
+constexpr bool flat_hash_map_policy<Key, T>::constant_iterator;
+
+template<class Key, class T>
+constexpr bool flat_hash_map_policy<Key, T>::trivially_relocatable;
+
+template<class Key, class T>
+constexpr bool flat_hash_map_policy<Key, T>::nothrow_transfer;
+
+} // namespace detail
+
+template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+         class Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_hash_map : public swiss_table<detail::flat_hash_map_policy<Key, T>, Hash, KeyEqual, Allocator> {
+    using base_type = swiss_table<detail::flat_hash_map_policy<Key, T>, Hash, KeyEqual, Allocator>;
+
+public:
+    using mapped_type    = T;
+    using iterator       = typename base_type::iterator;
+    using const_iterator = typename base_type::const_iterator;
+    using base_type::base_type;
+
+    flat_hash_map() = default;
+
+    flat_hash_map& operator=(std::initializer_list<typename base_type::value_type> ilist) {
+        this->clear();
+        this->insert(ilist);
+
+        return *this;
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return this->try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        return this->try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    iterator try_emplace(const_iterator, const Key& key, Args&&... args) {
+        return try_emplace(key, std::forward<Args>(args)...).first;
+    }
+
+    template<class... Args>
+    iterator try_emplace(const_iterator, Key&& key, Args&&... args) {
+        return try_emplace(std::move(key), std::forward<Args>(args)...).first;
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        auto res = try_emplace(key, std::forward<M>(obj));
+        if (!res.second) {
+            res.first->second = std::forward<M>(obj);
+        }
+
+        return res;
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj) {
+        auto res = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!res.second) {
+            res.first->second = std::forward<M>(obj);
+        }
+
+        return res;
+    }
+
+    T& operator[](const Key& key) {
+        return try_emplace(key).first->second;
+    }
+
+    T& operator[](Key&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    CIEL_NODISCARD T& at(const Key& key) {
+        const auto it = this->find(key);
+        if CIEL_UNLIKELY (it == this->end()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("ciel::flat_hash_map::at key not found"));
+        }
+
+        return it->second;
+    }
+
+    CIEL_NODISCARD const T& at(const Key& key) const {
+        const auto it = this->find(key);
+        if CIEL_UNLIKELY (it == this->end()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("ciel::flat_hash_map::at key not found"));
+        }
+
+        return it->second;
+    }
+
+    // Order doesn't matter.
+    CIEL_NODISCARD friend bool operator==(const flat_hash_map& lhs, const flat_hash_map& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (const auto& value : lhs) {
+            const auto it = rhs.find(value.first);
+            if (it == rhs.end() || !(it->second == value.second)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}; // class flat_hash_map
+
+template<class Key, class T, class Hash, class KeyEqual, class Allocator>
+struct is_trivially_relocatable<flat_hash_map<Key, T, Hash, KeyEqual, Allocator>>
+    : conjunction<is_trivially_relocatable<Hash>, is_trivially_relocatable<KeyEqual>,
+                  is_trivially_relocatable<Allocator>> {};
+
+template<class Key, class T, class Hash, class KeyEqual, class Allocator, class Pred>
+typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+erase_if(flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& c, Pred pred) {
+    const auto old_size = c.size();
+
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+
+        } else {
+            ++it;
+        }
+    }
+
+    return old_size - c.size();
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Key, class T, class Hash, class KeyEqual, class Allocator>
+void swap(ciel::flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs,
+          ciel::flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_FLAT_HASH_MAP_HPP_
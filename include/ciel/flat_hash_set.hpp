@@ -0,0 +1,125 @@
+#ifndef CIELLAB_INCLUDE_CIEL_FLAT_HASH_SET_HPP_
+#define CIELLAB_INCLUDE_CIEL_FLAT_HASH_SET_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/logical.hpp>
+#include <ciel/core/swiss_table.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// flat_hash_set
+// An open addressing hash set which stores the keys inline, see core/swiss_table.hpp.
+// Unlike std::unordered_set, rehashing invalidates pointers and references to the elements, not only iterators.
+
+namespace detail {
+
+template<class Key>
+struct flat_hash_set_policy {
+    using key_type   = Key;
+    using value_type = Key;
+
+    static constexpr bool constant_iterator     = true;
+    static constexpr bool trivially_relocatable = is_trivially_relocatable<Key>::value;
+    static constexpr bool nothrow_transfer      = std::is_nothrow_move_constructible<Key>::value;
+
+    CIEL_NODISCARD static const key_type& key(const value_type& value) noexcept {
+        return value;
+    }
+
+    template<class Allocator>
+    static void transfer(Allocator& alloc, value_type* dst, value_type* src) noexcept {
+        std::allocator_traits<Allocator>::construct(alloc, dst, std::move(*src));
+        std::allocator_traits<Allocator>::destroy(alloc, src);
+    }
+
+}; // struct flat_hash_set_policy
+
+template<class Key>
+constexpr bool flat_hash_set_policy<Key>::constant_iterator;
+
+template<class Key>
+constexpr bool flat_hash_set_policy<Key>::trivially_relocatable;
+
+template<class Key>
+constexpr bool flat_hash_set_policy<Key>::nothrow_transfer;
+
+} // namespace detail
+
+template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+         class Allocator = std::allocator<Key>>
+class flat_hash_set : public swiss_table<detail::flat_hash_set_policy<Key>, Hash, KeyEqual, Allocator> {
+    using base_type = swiss_table<detail::flat_hash_set_policy<Key>, Hash, KeyEqual, Allocator>;
+
+public:
+    using base_type::base_type;
+
+    flat_hash_set() = default;
+
+    flat_hash_set& operator=(std::initializer_list<Key> ilist) {
+        this->clear();
+        this->insert(ilist);
+
+        return *this;
+    }
+
+    // Order doesn't matter.
+    CIEL_NODISCARD friend bool operator==(const flat_hash_set& lhs, const flat_hash_set& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (const Key& key : lhs) {
+            if (!rhs.contains(key)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}; // class flat_hash_set
+
+template<class Key, class Hash, class KeyEqual, class Allocator>
+struct is_trivially_relocatable<flat_hash_set<Key, Hash, KeyEqual, Allocator>>
+    : conjunction<is_trivially_relocatable<Hash>, is_trivially_relocatable<KeyEqual>,
+                  is_trivially_relocatable<Allocator>> {};
+
+template<class Key, class Hash, class KeyEqual, class Allocator, class Pred>
+typename flat_hash_set<Key, Hash, KeyEqual, Allocator>::size_type
+erase_if(flat_hash_set<Key, Hash, KeyEqual, Allocator>& c, Pred pred) {
+    const auto old_size = c.size();
+
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+
+        } else {
+            ++it;
+        }
+    }
+
+    return old_size - c.size();
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Key, class Hash, class KeyEqual, class Allocator>
+void swap(ciel::flat_hash_set<Key, Hash, KeyEqual, Allocator>& lhs,
+          ciel::flat_hash_set<Key, Hash, KeyEqual, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_FLAT_HASH_SET_HPP_
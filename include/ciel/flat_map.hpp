@@ -0,0 +1,751 @@
+#ifndef CIELLAB_INCLUDE_CIEL_FLAT_MAP_HPP_
+#define CIELLAB_INCLUDE_CIEL_FLAT_MAP_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_range.hpp>
+#include <ciel/core/is_transparent.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/sorted_unique.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// flat_map
+// Sorted keys and their mapped values are kept in two separate ciel::vectors, like C++23 std::flat_map.
+// Binary searches only touch the keys, so lookups are far more cache friendly than walking a tree.
+// Single insertions and erasures are O(n), they go through vector's insert/erase, so trivially relocatable
+// elements are shifted by memmove. Prefer insert_range for bulk insertions: it appends the new elements,
+// sorts them, then merges them with the old ones and removes duplicates, in O(n + m log m).
+// When keys are equivalent, the element that was inserted first is kept.
+//
+// Iterators yield std::pair<const Key&, T&>, which are proxies, not references to std::pair<Key, T>.
+
+template<class Key, class T, bool Const>
+class flat_map_iterator : public random_access_iterator_base<flat_map_iterator<Key, T, Const>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = std::pair<Key, T>;
+    using reference         = std::pair<const Key&, conditional_t<Const, const T&, T&>>;
+    using iterator_category = std::random_access_iterator_tag;
+
+    struct pointer {
+        reference ref;
+
+        CIEL_NODISCARD reference* operator->() noexcept {
+            return std::addressof(ref);
+        }
+
+    }; // struct pointer
+
+private:
+    using mapped_pointer = conditional_t<Const, const T*, T*>;
+
+    const Key* key_{nullptr};
+    mapped_pointer mapped_{nullptr};
+
+public:
+    flat_map_iterator() = default;
+
+    flat_map_iterator(const Key* key, const mapped_pointer mapped) noexcept
+        : key_(key), mapped_(mapped) {}
+
+    template<bool C, enable_if_t<Const && !C> = 0>
+    flat_map_iterator(const flat_map_iterator<Key, T, C>& other) noexcept
+        : key_(other.key()), mapped_(other.mapped()) {}
+
+    void go_next() noexcept {
+        ++key_;
+        ++mapped_;
+    }
+
+    void go_prev() noexcept {
+        --key_;
+        --mapped_;
+    }
+
+    void advance(const difference_type n) noexcept {
+        key_ += n;
+        mapped_ += n;
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        return reference(*key_, *mapped_);
+    }
+
+    CIEL_NODISCARD pointer operator->() const noexcept {
+        return pointer{**this};
+    }
+
+    CIEL_NODISCARD reference operator[](const difference_type n) const noexcept {
+        return reference(key_[n], mapped_[n]);
+    }
+
+    CIEL_NODISCARD const Key* key() const noexcept {
+        return key_;
+    }
+
+    CIEL_NODISCARD mapped_pointer mapped() const noexcept {
+        return mapped_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const flat_map_iterator& lhs, const flat_map_iterator& rhs) noexcept {
+        return lhs.key() == rhs.key();
+    }
+
+    CIEL_NODISCARD friend bool operator<(const flat_map_iterator& lhs, const flat_map_iterator& rhs) noexcept {
+        return lhs.key() < rhs.key();
+    }
+
+    CIEL_NODISCARD friend flat_map_iterator operator+(flat_map_iterator iter, const difference_type n) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend flat_map_iterator operator+(const difference_type n, flat_map_iterator iter) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend flat_map_iterator operator-(flat_map_iterator iter, const difference_type n) noexcept {
+        iter -= n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend difference_type operator-(const flat_map_iterator& lhs,
+                                                    const flat_map_iterator& rhs) noexcept {
+        return lhs.key() - rhs.key();
+    }
+
+}; // class flat_map_iterator
+
+template<class Key, class T, class Compare = std::less<Key>, class KeyContainer = vector<Key>,
+         class MappedContainer = vector<T>>
+class flat_map {
+    static_assert(std::is_same<Key, typename KeyContainer::value_type>::value, "");
+    static_assert(std::is_same<T, typename MappedContainer::value_type>::value, "");
+
+public:
+    using key_type               = Key;
+    using mapped_type            = T;
+    using value_type             = std::pair<key_type, mapped_type>;
+    using key_compare            = Compare;
+    using reference              = std::pair<const key_type&, mapped_type&>;
+    using const_reference        = std::pair<const key_type&, const mapped_type&>;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using iterator               = flat_map_iterator<key_type, mapped_type, false>;
+    using const_iterator         = flat_map_iterator<key_type, mapped_type, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using key_container_type     = KeyContainer;
+    using mapped_container_type  = MappedContainer;
+
+    struct containers {
+        key_container_type keys;
+        mapped_container_type values;
+
+    }; // struct containers
+
+private:
+    key_container_type keys_;
+    compressed_pair<mapped_container_type, key_compare> values_comp_;
+
+    CIEL_NODISCARD mapped_container_type& values_() noexcept {
+        return values_comp_.first();
+    }
+
+    CIEL_NODISCARD const mapped_container_type& values_() const noexcept {
+        return values_comp_.first();
+    }
+
+    CIEL_NODISCARD key_compare& comp_() noexcept {
+        return values_comp_.second();
+    }
+
+    CIEL_NODISCARD const key_compare& comp_() const noexcept {
+        return values_comp_.second();
+    }
+
+    CIEL_NODISCARD iterator make_iterator(const size_type i) noexcept {
+        return iterator(keys_.data() + i, values_().data() + i);
+    }
+
+    CIEL_NODISCARD const_iterator make_iterator(const size_type i) const noexcept {
+        return const_iterator(keys_.data() + i, values_().data() + i);
+    }
+
+    CIEL_NODISCARD size_type index_of(const const_iterator pos) const noexcept {
+        CIEL_ASSERT(keys_.data() <= pos.key() && pos.key() <= keys_.data() + size());
+
+        return pos.key() - keys_.data();
+    }
+
+    template<class K>
+    CIEL_NODISCARD size_type lower_bound_index(const K& key) const {
+        return std::lower_bound(keys_.begin(), keys_.end(), key, comp_()) - keys_.begin();
+    }
+
+    template<class K>
+    CIEL_NODISCARD size_type upper_bound_index(const K& key) const {
+        return std::upper_bound(keys_.begin(), keys_.end(), key, comp_()) - keys_.begin();
+    }
+
+    template<class K>
+    CIEL_NODISCARD size_type find_index(const K& key) const {
+        const size_type i = lower_bound_index(key);
+
+        return i != size() && !comp_()(key, keys_[i]) ? i : size();
+    }
+
+    CIEL_NODISCARD bool is_sorted_unique() const {
+        return std::adjacent_find(keys_.begin(), keys_.end(), [this](const key_type& lhs, const key_type& rhs) {
+                   return !comp_()(lhs, rhs);
+               }) == keys_.end();
+    }
+
+    // [0, sorted_size) is sorted and unique. Stable sort the rest by an index permutation
+    // since keys and values can't be swapped together, then merge both parts into new containers,
+    // skipping the elements that are equivalent to the last merged one.
+    void sort_and_unique(const size_type sorted_size) {
+        CIEL_ASSERT(sorted_size <= size());
+        CIEL_ASSERT(keys_.size() == values_().size());
+
+        const size_type n = size();
+        if (sorted_size == n) {
+            return;
+        }
+
+        vector<size_type> perm;
+        key_container_type new_keys(keys_.get_allocator());
+        mapped_container_type new_values(values_().get_allocator());
+
+        CIEL_TRY {
+            perm.resize(n - sorted_size);
+            std::iota(perm.begin(), perm.end(), sorted_size);
+            std::stable_sort(perm.begin(), perm.end(), [this](const size_type lhs, const size_type rhs) {
+                return comp_()(keys_[lhs], keys_[rhs]);
+            });
+
+            new_keys.reserve(n);
+            new_values.reserve(n);
+        }
+        CIEL_CATCH (...) {
+            // Nothing is moved yet, drop the new elements.
+            keys_.erase(keys_.begin() + sorted_size, keys_.end());
+            values_().erase(values_().begin() + sorted_size, values_().end());
+            CIEL_THROW;
+        }
+
+        const auto push = [&](const size_type i) {
+            if (!new_keys.empty() && !comp_()(new_keys.back(), keys_[i])) {
+                return;
+            }
+
+            new_keys.emplace_back(std::move(keys_[i]));
+            new_values.emplace_back(std::move(values_()[i]));
+        };
+
+        CIEL_TRY {
+            size_type i = 0;
+            auto it     = perm.begin();
+
+            // On ties, the old element goes first so that it's the one kept.
+            while (i != sorted_size && it != perm.end()) {
+                if (comp_()(keys_[*it], keys_[i])) {
+                    push(*it++);
+
+                } else {
+                    push(i++);
+                }
+            }
+
+            for (; i != sorted_size; ++i) {
+                push(i);
+            }
+
+            for (; it != perm.end(); ++it) {
+                push(*it);
+            }
+        }
+        CIEL_CATCH (...) {
+            // Some elements are moved from, the invariant can't be kept.
+            clear();
+            CIEL_THROW;
+        }
+
+        keys_     = std::move(new_keys);
+        values_() = std::move(new_values);
+    }
+
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args) {
+        const size_type i = lower_bound_index(key);
+
+        if (i != size() && !comp_()(key, keys_[i])) {
+            return {make_iterator(i), false};
+        }
+
+        keys_.emplace(keys_.begin() + i, std::forward<K>(key));
+
+        CIEL_TRY {
+            values_().emplace(values_().begin() + i, std::forward<Args>(args)...);
+        }
+        CIEL_CATCH (...) {
+            keys_.erase(keys_.begin() + i);
+            CIEL_THROW;
+        }
+
+        return {make_iterator(i), true};
+    }
+
+    template<class R>
+    void insert_range_impl(R& rg, std::true_type /* lvalue */) {
+        insert(rg.begin(), rg.end());
+    }
+
+    template<class R>
+    void insert_range_impl(R& rg, std::false_type /* lvalue */) {
+        insert(std::make_move_iterator(rg.begin()), std::make_move_iterator(rg.end()));
+    }
+
+    template<class K, class M>
+    std::pair<iterator, bool> insert_or_assign_impl(K&& key, M&& obj) {
+        const size_type i = lower_bound_index(key);
+
+        if (i != size() && !comp_()(key, keys_[i])) {
+            values_()[i] = std::forward<M>(obj);
+            return {make_iterator(i), false};
+        }
+
+        return try_emplace_impl(std::forward<K>(key), std::forward<M>(obj));
+    }
+
+public:
+    flat_map() = default;
+
+    explicit flat_map(const key_compare& comp)
+        : keys_(), values_comp_(mapped_container_type(), comp) {}
+
+    flat_map(key_container_type keys, mapped_container_type values, const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), values_comp_(std::move(values), comp) {
+        CIEL_ASSERT(keys_.size() == values_().size());
+
+        sort_and_unique(0);
+    }
+
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values,
+             const key_compare& comp = key_compare())
+        : keys_(std::move(keys)), values_comp_(std::move(values), comp) {
+        CIEL_ASSERT(keys_.size() == values_().size());
+        CIEL_ASSERT(is_sorted_unique());
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    flat_map(Iter first, Iter last, const key_compare& comp = key_compare())
+        : flat_map(comp) {
+        insert(first, last);
+    }
+
+    template<class R, enable_if_t<is_range<R>::value> = 0>
+    flat_map(from_range_t, R&& rg, const key_compare& comp = key_compare())
+        : flat_map(comp) {
+        insert_range(std::forward<R>(rg));
+    }
+
+    flat_map(std::initializer_list<value_type> init, const key_compare& comp = key_compare())
+        : flat_map(init.begin(), init.end(), comp) {}
+
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist);
+
+        return *this;
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return make_iterator(0);
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return make_iterator(0);
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return make_iterator(size());
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return make_iterator(size());
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return keys_.empty();
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return keys_.size();
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return ciel::min<size_type>(keys_.max_size(), values_().max_size());
+    }
+
+    void reserve(const size_type new_cap) {
+        keys_.reserve(new_cap);
+        values_().reserve(new_cap);
+    }
+
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_().shrink_to_fit();
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    CIEL_NODISCARD mapped_type& at(const key_type& key) {
+        const size_type i = find_index(key);
+
+        if CIEL_UNLIKELY (i == size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("key is not found in ciel::flat_map"));
+        }
+
+        return values_()[i];
+    }
+
+    CIEL_NODISCARD const mapped_type& at(const key_type& key) const {
+        const size_type i = find_index(key);
+
+        if CIEL_UNLIKELY (i == size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("key is not found in ciel::flat_map"));
+        }
+
+        return values_()[i];
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+
+        return try_emplace_impl(std::move(value.first), std::move(value.second));
+    }
+
+    template<class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace_impl(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace_impl(std::move(value.first), std::move(value.second));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert(std::move(value)).first;
+    }
+
+    // Elements are moved if Iter is a move_iterator.
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    void insert(Iter first, Iter last) {
+        const size_type old_size = size();
+
+        CIEL_TRY {
+            for (; first != last; ++first) {
+                auto&& value = *first;
+                keys_.emplace_back(std::forward<decltype(value)>(value).first);
+                values_().emplace_back(std::forward<decltype(value)>(value).second);
+            }
+        }
+        CIEL_CATCH (...) {
+            keys_.erase(keys_.begin() + old_size, keys_.end());
+            values_().erase(values_().begin() + old_size, values_().end());
+            CIEL_THROW;
+        }
+
+        sort_and_unique(old_size);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // Elements are moved if rg is an rvalue.
+    template<class R, enable_if_t<is_range<R>::value> = 0>
+    void insert_range(R&& rg) {
+        insert_range_impl(rg, std::is_lvalue_reference<R>{});
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        return insert_or_assign_impl(key, std::forward<M>(obj));
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        return insert_or_assign_impl(std::move(key), std::forward<M>(obj));
+    }
+
+    containers extract() && {
+        containers res{std::move(keys_), std::move(values_())};
+        clear();
+
+        return res;
+    }
+
+    void replace(key_container_type&& keys, mapped_container_type&& values) {
+        keys_     = std::move(keys);
+        values_() = std::move(values);
+
+        CIEL_ASSERT(keys_.size() == values_().size());
+        CIEL_ASSERT(is_sorted_unique());
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_type f = index_of(first);
+        const size_type l = index_of(last);
+
+        keys_.erase(keys_.begin() + f, keys_.begin() + l);
+        values_().erase(values_().begin() + f, values_().begin() + l);
+
+        return make_iterator(f);
+    }
+
+    size_type erase(const key_type& key) {
+        const size_type i = find_index(key);
+
+        if (i == size()) {
+            return 0;
+        }
+
+        erase(make_iterator(i));
+        return 1;
+    }
+
+    void swap(flat_map& other) noexcept {
+        using std::swap;
+
+        swap(keys_, other.keys_);
+        swap(values_(), other.values_());
+        swap(comp_(), other.comp_());
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_().clear();
+    }
+
+    CIEL_NODISCARD key_compare key_comp() const {
+        return comp_();
+    }
+
+    CIEL_NODISCARD const key_container_type& keys() const noexcept {
+        return keys_;
+    }
+
+    CIEL_NODISCARD const mapped_container_type& values() const noexcept {
+        return values_();
+    }
+
+    CIEL_NODISCARD iterator find(const key_type& key) {
+        return make_iterator(find_index(key));
+    }
+
+    CIEL_NODISCARD const_iterator find(const key_type& key) const {
+        return make_iterator(find_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator find(const K& key) {
+        return make_iterator(find_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD const_iterator find(const K& key) const {
+        return make_iterator(find_index(key));
+    }
+
+    CIEL_NODISCARD size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD size_type count(const K& key) const {
+        return upper_bound_index(key) - lower_bound_index(key);
+    }
+
+    CIEL_NODISCARD bool contains(const key_type& key) const {
+        return find_index(key) != size();
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD bool contains(const K& key) const {
+        return find_index(key) != size();
+    }
+
+    CIEL_NODISCARD iterator lower_bound(const key_type& key) {
+        return make_iterator(lower_bound_index(key));
+    }
+
+    CIEL_NODISCARD const_iterator lower_bound(const key_type& key) const {
+        return make_iterator(lower_bound_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator lower_bound(const K& key) {
+        return make_iterator(lower_bound_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD const_iterator lower_bound(const K& key) const {
+        return make_iterator(lower_bound_index(key));
+    }
+
+    CIEL_NODISCARD iterator upper_bound(const key_type& key) {
+        return make_iterator(upper_bound_index(key));
+    }
+
+    CIEL_NODISCARD const_iterator upper_bound(const key_type& key) const {
+        return make_iterator(upper_bound_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator upper_bound(const K& key) {
+        return make_iterator(upper_bound_index(key));
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD const_iterator upper_bound(const K& key) const {
+        return make_iterator(upper_bound_index(key));
+    }
+
+    CIEL_NODISCARD std::pair<iterator, iterator> equal_range(const key_type& key) {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    CIEL_NODISCARD std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD std::pair<iterator, iterator> equal_range(const K& key) {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+}; // class flat_map
+
+template<class Key, class T, class Compare, class KeyContainer, class MappedContainer, class Pred>
+size_t erase_if(flat_map<Key, T, Compare, KeyContainer, MappedContainer>& c, Pred pred) {
+    const size_t old_size = c.size();
+
+    auto conts = std::move(c).extract();
+
+    size_t out = 0;
+    for (size_t i = 0; i < conts.keys.size(); ++i) {
+        if (!pred(std::pair<const Key&, T&>(conts.keys[i], conts.values[i]))) {
+            if (out != i) {
+                conts.keys[out]   = std::move(conts.keys[i]);
+                conts.values[out] = std::move(conts.values[i]);
+            }
+
+            ++out;
+        }
+    }
+
+    conts.keys.erase(conts.keys.begin() + out, conts.keys.end());
+    conts.values.erase(conts.values.begin() + out, conts.values.end());
+    c.replace(std::move(conts.keys), std::move(conts.values));
+
+    return old_size - c.size();
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Key, class T, class Compare, class KeyContainer, class MappedContainer>
+void swap(ciel::flat_map<Key, T, Compare, KeyContainer, MappedContainer>& lhs,
+          ciel::flat_map<Key, T, Compare, KeyContainer, MappedContainer>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_FLAT_MAP_HPP_
@@ -0,0 +1,410 @@
+#ifndef CIELLAB_INCLUDE_CIEL_FLAT_SET_HPP_
+#define CIELLAB_INCLUDE_CIEL_FLAT_SET_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_range.hpp>
+#include <ciel/core/is_transparent.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/sorted_unique.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// flat_set
+// A sorted ciel::vector of unique keys, like C++23 std::flat_set.
+// Lookups are binary searches over contiguous memory, which are far more cache friendly than walking a tree.
+// Single insertions and erasures are O(n), they go through vector's insert/erase, so trivially relocatable
+// keys are shifted by memmove. Prefer insert_range for bulk insertions: it appends the new keys, sorts them,
+// then merges them with the old ones and removes duplicates, in O(n + m log m).
+
+template<class Key, class Compare = std::less<Key>, class KeyContainer = vector<Key>>
+class flat_set {
+    static_assert(std::is_same<Key, typename KeyContainer::value_type>::value, "");
+
+public:
+    using key_type               = Key;
+    using value_type             = Key;
+    using key_compare            = Compare;
+    using value_compare          = Compare;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = typename KeyContainer::size_type;
+    using difference_type        = typename KeyContainer::difference_type;
+    using iterator               = typename KeyContainer::const_iterator;
+    using const_iterator         = typename KeyContainer::const_iterator;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using container_type         = KeyContainer;
+
+private:
+    compressed_pair<container_type, key_compare> c_comp_;
+
+    CIEL_NODISCARD container_type& c_() noexcept {
+        return c_comp_.first();
+    }
+
+    CIEL_NODISCARD const container_type& c_() const noexcept {
+        return c_comp_.first();
+    }
+
+    CIEL_NODISCARD key_compare& comp_() noexcept {
+        return c_comp_.second();
+    }
+
+    CIEL_NODISCARD const key_compare& comp_() const noexcept {
+        return c_comp_.second();
+    }
+
+    // [begin, begin + sorted_size) is sorted and unique, and [begin + sorted_size, end) is sorted, merge them.
+    // Both steps are stable, so among equivalent keys the old one is kept, then the first new one.
+    void merge_unique(const size_type sorted_size) {
+        CIEL_ASSERT(sorted_size <= size());
+
+        CIEL_TRY {
+            std::inplace_merge(c_().begin(), c_().begin() + sorted_size, c_().end(), comp_());
+
+            // Sorted, so neighbors are equivalent if the first one is not less than the second one.
+            const auto new_end = std::unique(c_().begin(), c_().end(),
+                                             [this](const key_type& lhs, const key_type& rhs) {
+                                                 return !comp_()(lhs, rhs);
+                                             });
+            c_().erase(new_end, c_().end());
+        }
+        CIEL_CATCH (...) {
+            // The old and new keys are mixed up, the invariant can't be kept.
+            clear();
+            CIEL_THROW;
+        }
+    }
+
+    // [begin, begin + sorted_size) is sorted and unique, sort and merge the rest into it.
+    void sort_and_unique(const size_type sorted_size) {
+        CIEL_ASSERT(sorted_size <= size());
+
+        CIEL_TRY {
+            std::stable_sort(c_().begin() + sorted_size, c_().end(), comp_());
+        }
+        CIEL_CATCH (...) {
+            // Only the new keys are reordered, drop them.
+            c_().erase(c_().begin() + sorted_size, c_().end());
+            CIEL_THROW;
+        }
+
+        merge_unique(sorted_size);
+    }
+
+    CIEL_NODISCARD bool is_sorted_unique() const {
+        return std::adjacent_find(c_().begin(), c_().end(), [this](const key_type& lhs, const key_type& rhs) {
+                   return !comp_()(lhs, rhs);
+               }) == c_().end();
+    }
+
+    template<class K>
+    std::pair<iterator, bool> insert_impl(K&& key) {
+        const auto it = std::lower_bound(c_().begin(), c_().end(), key, comp_());
+
+        if (it != c_().end() && !comp_()(key, *it)) {
+            return {it, false};
+        }
+
+        return {c_().emplace(it, std::forward<K>(key)), true};
+    }
+
+public:
+    flat_set() = default;
+
+    explicit flat_set(const key_compare& comp)
+        : c_comp_(container_type(), comp) {}
+
+    explicit flat_set(container_type cont, const key_compare& comp = key_compare())
+        : c_comp_(std::move(cont), comp) {
+        sort_and_unique(0);
+    }
+
+    flat_set(sorted_unique_t, container_type cont, const key_compare& comp = key_compare())
+        : c_comp_(std::move(cont), comp) {
+        CIEL_ASSERT(is_sorted_unique());
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    flat_set(Iter first, Iter last, const key_compare& comp = key_compare())
+        : c_comp_(container_type(first, last), comp) {
+        sort_and_unique(0);
+    }
+
+    template<class R, enable_if_t<is_range<R>::value> = 0>
+    flat_set(from_range_t, R&& rg, const key_compare& comp = key_compare())
+        : flat_set(comp) {
+        insert_range(std::forward<R>(rg));
+    }
+
+    flat_set(std::initializer_list<value_type> init, const key_compare& comp = key_compare())
+        : flat_set(init.begin(), init.end(), comp) {}
+
+    flat_set& operator=(std::initializer_list<value_type> ilist) {
+        c_().assign(ilist.begin(), ilist.end());
+        sort_and_unique(0);
+
+        return *this;
+    }
+
+    CIEL_NODISCARD iterator begin() const noexcept {
+        return c_().begin();
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() const noexcept {
+        return c_().end();
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() const noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() const noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return c_().empty();
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return c_().size();
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return c_().max_size();
+    }
+
+    void reserve(const size_type new_cap) {
+        c_().reserve(new_cap);
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return c_().capacity();
+    }
+
+    void shrink_to_fit() {
+        c_().shrink_to_fit();
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+
+        return insert_impl(std::move(value));
+    }
+
+    template<class... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return insert_impl(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return insert_impl(std::move(value));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert_impl(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert_impl(std::move(value)).first;
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    void insert(Iter first, Iter last) {
+        const size_type old_size = size();
+        c_().insert(c_().end(), first, last);
+        sort_and_unique(old_size);
+    }
+
+    // The caller promises [first, last) is sorted and unique, so only the merge is needed.
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    void insert(sorted_unique_t, Iter first, Iter last) {
+        const size_type old_size = size();
+        c_().insert(c_().end(), first, last);
+
+        CIEL_ASSERT(std::is_sorted(c_().begin() + old_size, c_().end(), comp_()));
+        merge_unique(old_size);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    template<class R, enable_if_t<is_range<R>::value> = 0>
+    void insert_range(R&& rg) {
+        const size_type old_size = size();
+        c_().append_range(std::forward<R>(rg));
+        sort_and_unique(old_size);
+    }
+
+    container_type extract() && {
+        container_type res = std::move(c_());
+        c_().clear();
+
+        return res;
+    }
+
+    void replace(container_type&& cont) {
+        c_() = std::move(cont);
+        CIEL_ASSERT(is_sorted_unique());
+    }
+
+    iterator erase(const_iterator pos) {
+        return c_().erase(pos);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return c_().erase(first, last);
+    }
+
+    size_type erase(const key_type& key) {
+        const auto it = find(key);
+
+        if (it == end()) {
+            return 0;
+        }
+
+        c_().erase(it);
+        return 1;
+    }
+
+    void swap(flat_set& other) noexcept {
+        using std::swap;
+
+        swap(c_(), other.c_());
+        swap(comp_(), other.comp_());
+    }
+
+    void clear() noexcept {
+        c_().clear();
+    }
+
+    CIEL_NODISCARD key_compare key_comp() const {
+        return comp_();
+    }
+
+    CIEL_NODISCARD value_compare value_comp() const {
+        return comp_();
+    }
+
+    CIEL_NODISCARD iterator find(const key_type& key) const {
+        const auto it = lower_bound(key);
+
+        return it != end() && !comp_()(key, *it) ? it : end();
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator find(const K& key) const {
+        const auto it = lower_bound(key);
+
+        return it != end() && !comp_()(key, *it) ? it : end();
+    }
+
+    CIEL_NODISCARD size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD size_type count(const K& key) const {
+        const auto range = equal_range(key);
+
+        return std::distance(range.first, range.second);
+    }
+
+    CIEL_NODISCARD bool contains(const key_type& key) const {
+        return find(key) != end();
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD bool contains(const K& key) const {
+        return find(key) != end();
+    }
+
+    CIEL_NODISCARD iterator lower_bound(const key_type& key) const {
+        return std::lower_bound(begin(), end(), key, comp_());
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator lower_bound(const K& key) const {
+        return std::lower_bound(begin(), end(), key, comp_());
+    }
+
+    CIEL_NODISCARD iterator upper_bound(const key_type& key) const {
+        return std::upper_bound(begin(), end(), key, comp_());
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD iterator upper_bound(const K& key) const {
+        return std::upper_bound(begin(), end(), key, comp_());
+    }
+
+    CIEL_NODISCARD std::pair<iterator, iterator> equal_range(const key_type& key) const {
+        return std::equal_range(begin(), end(), key, comp_());
+    }
+
+    template<class K, class C = Compare, enable_if_t<is_transparent<C>::value> = 0>
+    CIEL_NODISCARD std::pair<iterator, iterator> equal_range(const K& key) const {
+        return std::equal_range(begin(), end(), key, comp_());
+    }
+
+}; // class flat_set
+
+template<class Key, class Compare, class KeyContainer, class Pred>
+typename flat_set<Key, Compare, KeyContainer>::size_type erase_if(flat_set<Key, Compare, KeyContainer>& c,
+                                                                 Pred pred) {
+    const auto old_size = c.size();
+
+    auto cont = std::move(c).extract();
+    cont.erase(std::remove_if(cont.begin(), cont.end(), pred), cont.end());
+    c.replace(std::move(cont));
+
+    return old_size - c.size();
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Key, class Compare, class KeyContainer>
+void swap(ciel::flat_set<Key, Compare, KeyContainer>& lhs,
+          ciel::flat_set<Key, Compare, KeyContainer>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_FLAT_SET_HPP_
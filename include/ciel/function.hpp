@@ -416,6 +416,7 @@ public:
 
 static_assert(sizeof(function<void()>) == 32, "");
 
+// Only trivially relocatable callables are stored in the buffer, and nothing points into it.
 template<class R, class... Args>
 struct is_trivially_relocatable<function<R(Args...)>> : std::true_type {};
 
@@ -0,0 +1,114 @@
+#ifndef CIELLAB_INCLUDE_CIEL_GROWTH_POLICY_HPP_
+#define CIELLAB_INCLUDE_CIEL_GROWTH_POLICY_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+
+NAMESPACE_CIEL_BEGIN
+
+// Growth policies decide how much capacity a container requests when it has to expand.
+//
+// recommend(cap, new_size, max_size, value_size) is called with the current capacity, the size that
+// must fit after expansion (new_size <= max_size), the container's max_size and sizeof(value_type).
+// It returns the number of elements to request, in the range [new_size, max_size].
+// It's only a request, allocate_at_least may hand back more than that.
+
+// growth_policy_2x
+
+struct growth_policy_2x {
+    CIEL_NODISCARD static size_t recommend(const size_t cap, const size_t new_size, const size_t max_size,
+                                           size_t /*unused*/) noexcept {
+        if CIEL_UNLIKELY (cap >= max_size / 2) {
+            return max_size;
+        }
+
+        return ciel::max(cap * 2, new_size);
+    }
+
+}; // struct growth_policy_2x
+
+// growth_policy_1_5x
+// Used by folly::fbvector and MSVC STL, freed blocks can be reused by later expansions.
+
+struct growth_policy_1_5x {
+    CIEL_NODISCARD static size_t recommend(const size_t cap, const size_t new_size, const size_t max_size,
+                                           size_t /*unused*/) noexcept {
+        if CIEL_UNLIKELY (cap >= max_size / 3 * 2) {
+            return max_size;
+        }
+
+        return ciel::max(cap + cap / 2, new_size);
+    }
+
+}; // struct growth_policy_1_5x
+
+// growth_policy_size_class
+// Grow by 1.5x, then round the byte size up to the size class that malloc would serve anyway,
+// so that the tail of the underlying block becomes usable capacity instead of hidden slack.
+// Size classes follow jemalloc's layout: multiples of 16 up to 128 bytes,
+// then four evenly spaced classes between each two adjacent powers of two.
+
+struct growth_policy_size_class {
+    CIEL_NODISCARD static size_t round_up(const size_t bytes) noexcept {
+        constexpr size_t quantum = 16;
+
+        if (bytes <= 128) {
+            return (bytes + quantum - 1) / quantum * quantum;
+        }
+
+        const size_t spacing = size_t{1} << (bit_width(bytes - 1) - 3);
+
+        return (bytes + spacing - 1) / spacing * spacing;
+    }
+
+    CIEL_NODISCARD static size_t recommend(const size_t cap, const size_t new_size, const size_t max_size,
+                                           const size_t value_size) noexcept {
+        const size_t target = growth_policy_1_5x::recommend(cap, new_size, max_size, value_size);
+
+        if CIEL_UNLIKELY (target > max_size / 2) {
+            return target;
+        }
+
+        const size_t res = round_up(target * value_size) / value_size;
+
+        return ciel::min(ciel::max(res, new_size), max_size);
+    }
+
+private:
+    CIEL_NODISCARD static size_t bit_width(size_t x) noexcept {
+        size_t res = 0;
+
+        while (x != 0) {
+            ++res;
+            x >>= 1;
+        }
+
+        return res;
+    }
+
+}; // struct growth_policy_size_class
+
+namespace detail {
+
+// The expansion step shared by vector, small_vector and compact_vector.
+// The caller has already rejected new_size > max_size, with its own message.
+template<class GrowthPolicy>
+CIEL_NODISCARD size_t recommend_cap(const size_t cap, const size_t new_size, const size_t max_size,
+                                    const size_t value_size) noexcept {
+    CIEL_ASSERT(new_size > 0);
+    CIEL_ASSERT(new_size <= max_size);
+
+    const size_t res = GrowthPolicy::recommend(cap, new_size, max_size, value_size);
+    CIEL_ASSERT(new_size <= res);
+    CIEL_ASSERT(res <= max_size);
+
+    return res;
+}
+
+} // namespace detail
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_GROWTH_POLICY_HPP_
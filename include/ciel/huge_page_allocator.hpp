@@ -0,0 +1,227 @@
+#ifndef CIELLAB_INCLUDE_CIEL_HUGE_PAGE_ALLOCATOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_HUGE_PAGE_ALLOCATOR_HPP_
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/core/alignment.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#  include <sys/mman.h>
+#  define CIEL_HAS_HUGE_PAGE_MMAP
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+static constexpr size_t huge_page_size = size_t{2} * 1024 * 1024;
+
+namespace detail {
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+
+// Map len bytes aligned to huge_page_size, return nullptr on failure.
+// mmap only guarantees the alignment of normal pages, so map one more huge page and trim both ends.
+CIEL_NODISCARD inline void* huge_page_map(const size_t len) noexcept {
+    CIEL_ASSERT(len != 0);
+    CIEL_ASSERT(len % huge_page_size == 0);
+
+    if CIEL_UNLIKELY (len > std::numeric_limits<size_t>::max() - huge_page_size) {
+        return nullptr;
+    }
+
+    const size_t mapped_len = len + huge_page_size;
+    void* mapped            = ::mmap(nullptr, mapped_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if CIEL_UNLIKELY (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const uintptr_t begin   = reinterpret_cast<uintptr_t>(mapped);
+    const uintptr_t aligned = ciel::align_up(begin, huge_page_size);
+    const size_t head       = aligned - begin;
+    const size_t tail       = huge_page_size - head;
+
+    if (head != 0) {
+        ::munmap(mapped, head);
+    }
+
+    if (tail != 0) {
+        ::munmap(reinterpret_cast<void*>(aligned + len), tail);
+    }
+
+    void* res = reinterpret_cast<void*>(aligned);
+#  ifdef MADV_HUGEPAGE
+    ::madvise(res, len, MADV_HUGEPAGE);
+#  endif
+
+    return res;
+}
+
+#endif
+
+} // namespace detail
+
+// huge_page_allocator
+// Requests of at least huge_page_size bytes are served by mmap, rounded up to and aligned to huge_page_size,
+// and advised with MADV_HUGEPAGE, so that transparent huge pages can back the whole block.
+// The rounded up size is reported through allocate_at_least.
+//
+// On Linux, reallocate_at_least is provided for containers to grow by remapping the pages via mremap,
+// and to shrink by unmapping the tail huge pages.
+// Smaller requests, and all requests on other platforms, are served by std::allocator.
+
+template<class T>
+class huge_page_allocator {
+    static_assert(alignof(T) <= huge_page_size, "");
+    static_assert(sizeof(T) <= huge_page_size, "");
+
+public:
+    using value_type                             = T;
+    using size_type                              = size_t;
+    using difference_type                        = ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+private:
+    // A block of at least min_huge_count objects is mapped. Since the count of a mapped block is
+    // its length divided by sizeof(T), it never drops below min_huge_count, even after shrinking.
+    static constexpr size_type min_huge_count = huge_page_size / sizeof(T);
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+    CIEL_NODISCARD static bool is_mapped(const size_type n) noexcept {
+        return n >= min_huge_count;
+    }
+
+    // For a mapped block, count * sizeof(T) is less than its length by at most sizeof(T) - 1 bytes.
+    CIEL_NODISCARD static size_t mapped_len(const size_type n) noexcept {
+        return ciel::align_up(n * sizeof(T), huge_page_size);
+    }
+#endif
+
+public:
+    huge_page_allocator() = default;
+
+    template<class U>
+    huge_page_allocator(const huge_page_allocator<U>&) noexcept {}
+
+    CIEL_NODISCARD T* allocate(const size_type n) {
+        return allocate_at_least(n).ptr;
+    }
+
+    CIEL_NODISCARD allocation_result<T*, size_type> allocate_at_least(const size_type n) {
+        if CIEL_UNLIKELY (n > max_size()) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+        if (is_mapped(n)) {
+            const size_t len = mapped_len(n);
+            void* res        = detail::huge_page_map(len);
+
+            if CIEL_UNLIKELY (res == nullptr) {
+                CIEL_THROW_EXCEPTION(std::bad_alloc{});
+            }
+
+            return {static_cast<T*>(res), len / sizeof(T)};
+        }
+#endif
+
+        return {std::allocator<T>{}.allocate(n), n};
+    }
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+    CIEL_NODISCARD allocation_result<T*, size_type> reallocate_at_least(T* p, const size_type old_n,
+                                                                        const size_type n) {
+        CIEL_ASSERT(p != nullptr);
+        CIEL_ASSERT(n != 0);
+
+        if CIEL_UNLIKELY (n > max_size()) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        if (!is_mapped(old_n)) {
+            const auto res = allocate_at_least(n);
+            ciel::memcpy(res.ptr, p, sizeof(T) * ciel::min(old_n, n));
+            deallocate(p, old_n);
+
+            return res;
+        }
+
+        const size_t old_len = mapped_len(old_n);
+        const size_t new_len = mapped_len(is_mapped(n) ? n : size_type{min_huge_count});
+
+        if (new_len == old_len) {
+            return {p, old_n};
+        }
+
+        // Unmap the whole tail huge pages, the partial one is kept so that it won't be split.
+        if (new_len < old_len) {
+            ::munmap(reinterpret_cast<unsigned char*>(p) + new_len, old_len - new_len);
+
+            return {p, new_len / sizeof(T)};
+        }
+
+        // Try to extend the mapping in place first.
+        void* res = ::mremap(p, old_len, new_len, 0);
+
+        if (res != MAP_FAILED) {
+#  ifdef MADV_HUGEPAGE
+            ::madvise(static_cast<unsigned char*>(res) + old_len, new_len - old_len, MADV_HUGEPAGE);
+#  endif
+            return {static_cast<T*>(res), new_len / sizeof(T)};
+        }
+
+        // Otherwise move the pages to the head of a new aligned mapping, without copying them.
+        res = detail::huge_page_map(new_len);
+
+        if CIEL_UNLIKELY (res == nullptr) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        if CIEL_UNLIKELY (::mremap(p, old_len, old_len, MREMAP_MAYMOVE | MREMAP_FIXED, res) == MAP_FAILED) {
+            ::munmap(res, new_len);
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        return {static_cast<T*>(res), new_len / sizeof(T)};
+    }
+#endif
+
+    void deallocate(T* p, const size_type n) noexcept {
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+        if (is_mapped(n)) {
+            ::munmap(p, mapped_len(n));
+            return;
+        }
+#endif
+
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    CIEL_NODISCARD static constexpr size_type max_size() noexcept {
+        return (std::numeric_limits<size_type>::max() - huge_page_size) / sizeof(T);
+    }
+
+}; // class huge_page_allocator
+
+template<class T, class U>
+CIEL_NODISCARD bool operator==(const huge_page_allocator<T>&, const huge_page_allocator<U>&) noexcept {
+    return true;
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool operator!=(const huge_page_allocator<T>&, const huge_page_allocator<U>&) noexcept {
+    return false;
+}
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_HUGE_PAGE_ALLOCATOR_HPP_
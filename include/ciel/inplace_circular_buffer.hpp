@@ -0,0 +1,403 @@
+#ifndef CIELLAB_INCLUDE_CIEL_INPLACE_CIRCULAR_BUFFER_HPP_
+#define CIELLAB_INCLUDE_CIEL_INPLACE_CIRCULAR_BUFFER_HPP_
+
+#include <ciel/circular_buffer.hpp>
+#include <ciel/compare.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/span.hpp>
+#include <ciel/inplace_vector.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+namespace detail {
+
+// inplace_circular_buffer_storage
+// Like inplace_vector_storage, but it also holds head_, so that its destructor
+// doesn't need any state of the derived class, which is already destroyed by then.
+
+template<class T, size_t Capacity, bool = std::is_trivially_destructible<T>::value>
+struct inplace_circular_buffer_storage : inplace_vector_size<Capacity> {
+    narrowest_size_type<Capacity> head_{0};
+
+    union {
+        T data_[Capacity];
+        unsigned char null_state_;
+    };
+
+    inplace_circular_buffer_storage() noexcept
+        : null_state_() {}
+
+    ~inplace_circular_buffer_storage() {
+        size_t i = head_;
+
+        for (size_t n = 0; n < this->size_; ++n) {
+            data_[i].~T();
+
+            if (++i == Capacity) {
+                i = 0;
+            }
+        }
+    }
+
+}; // struct inplace_circular_buffer_storage
+
+template<class T, size_t Capacity>
+struct inplace_circular_buffer_storage<T, Capacity, true> : inplace_vector_size<Capacity> {
+    narrowest_size_type<Capacity> head_{0};
+
+    union {
+        T data_[Capacity];
+        unsigned char null_state_;
+    };
+
+    inplace_circular_buffer_storage() noexcept
+        : null_state_() {}
+
+}; // struct inplace_circular_buffer_storage<T, Capacity, true>
+
+} // namespace detail
+
+// inplace_circular_buffer
+// circular_buffer with the elements stored inside the object, in a storage like inplace_vector's:
+// a union which leaves the elements uninitialized, a size and a head of narrowest_size_type<Capacity>,
+// and a destructor which is trivial if T's is.
+// A power of two Capacity wraps indices around by a mask, which is decided at compile time.
+
+template<class T, size_t Capacity>
+class inplace_circular_buffer : private detail::inplace_circular_buffer_storage<T, Capacity> {
+    static_assert(Capacity != 0, "");
+
+    using base_type = detail::inplace_circular_buffer_storage<T, Capacity>;
+
+    using base_type::head_;
+
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = circular_buffer_iterator<inplace_circular_buffer, reference>;
+    using const_iterator         = circular_buffer_iterator<const inplace_circular_buffer, const_reference>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    static constexpr bool is_power_of_two = (Capacity & (Capacity - 1)) == 0;
+
+    // i < Capacity * 2
+    CIEL_NODISCARD static size_type wrap(const size_type i) noexcept {
+        CIEL_ASSERT(i < Capacity * 2);
+
+        if (is_power_of_two) {
+            return i & (Capacity - 1);
+        }
+
+        return i >= Capacity ? i - Capacity : i;
+    }
+
+    CIEL_NODISCARD size_type physical(const size_type pos) const noexcept {
+        return wrap(head_ + pos);
+    }
+
+    CIEL_NODISCARD pointer slot(const size_type i) noexcept {
+        return this->data_ + i;
+    }
+
+    CIEL_NODISCARD const_pointer slot(const size_type i) const noexcept {
+        return this->data_ + i;
+    }
+
+    template<class Iter>
+    void construct_from(Iter first, Iter last) {
+        CIEL_ASSERT(empty());
+
+        for (; first != last; ++first) {
+            ::new (slot(this->size_)) value_type(*first);
+            ++this->size_;
+        }
+    }
+
+public:
+    inplace_circular_buffer() = default;
+
+    inplace_circular_buffer(const size_type count, const value_type& value) {
+        if CIEL_UNLIKELY (count > Capacity) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        for (size_type i = 0; i < count; ++i) {
+            ::new (slot(i)) value_type(value);
+            ++this->size_;
+        }
+    }
+
+    // Only the last Capacity elements are kept.
+    inplace_circular_buffer(std::initializer_list<value_type> init) {
+        for (const value_type& value : init) {
+            push_back(value);
+        }
+    }
+
+    inplace_circular_buffer(const inplace_circular_buffer& other) {
+        construct_from(other.begin(), other.end());
+    }
+
+    inplace_circular_buffer(inplace_circular_buffer&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        construct_from(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    }
+
+    inplace_circular_buffer& operator=(const inplace_circular_buffer& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        clear();
+        construct_from(other.begin(), other.end());
+
+        return *this;
+    }
+
+    inplace_circular_buffer& operator=(inplace_circular_buffer&& other) noexcept(
+        std::is_nothrow_move_constructible<T>::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        clear();
+        construct_from(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+
+        return *this;
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) noexcept {
+        CIEL_ASSERT(pos < size());
+
+        return *slot(physical(pos));
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const noexcept {
+        CIEL_ASSERT(pos < size());
+
+        return *slot(physical(pos));
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::inplace_circular_buffer"));
+        }
+
+        return operator[](pos);
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::inplace_circular_buffer"));
+        }
+
+        return operator[](pos);
+    }
+
+    CIEL_NODISCARD reference front() noexcept {
+        return operator[](0);
+    }
+
+    CIEL_NODISCARD const_reference front() const noexcept {
+        return operator[](0);
+    }
+
+    CIEL_NODISCARD reference back() noexcept {
+        return operator[](size() - 1);
+    }
+
+    CIEL_NODISCARD const_reference back() const noexcept {
+        return operator[](size() - 1);
+    }
+
+    // The elements are [array_one(), array_two()] in order, array_two() is empty unless they wrap around.
+    CIEL_NODISCARD span<value_type> array_one() noexcept {
+        return span<value_type>(slot(head_), ciel::min(size(), Capacity - head_));
+    }
+
+    CIEL_NODISCARD span<const value_type> array_one() const noexcept {
+        return span<const value_type>(slot(head_), ciel::min(size(), Capacity - head_));
+    }
+
+    CIEL_NODISCARD span<value_type> array_two() noexcept {
+        return span<value_type>(slot(0), size() - ciel::min(size(), Capacity - head_));
+    }
+
+    CIEL_NODISCARD span<const value_type> array_two() const noexcept {
+        return span<const value_type>(slot(0), size() - ciel::min(size(), Capacity - head_));
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return iterator(this, size());
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return this->size_ == 0;
+    }
+
+    CIEL_NODISCARD bool full() const noexcept {
+        return this->size_ == Capacity;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return this->size_;
+    }
+
+    CIEL_NODISCARD static constexpr size_type capacity() noexcept {
+        return Capacity;
+    }
+
+    CIEL_NODISCARD static constexpr size_type max_size() noexcept {
+        return Capacity;
+    }
+
+    void clear() noexcept {
+        if (!std::is_trivially_destructible<value_type>::value) {
+            for (size_type i = 0; i < size(); ++i) {
+                slot(physical(i))->~value_type();
+            }
+        }
+
+        head_       = 0;
+        this->size_ = 0;
+    }
+
+    // Overwrites the front element if full. The new element is built first, so args may refer to the front one.
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if CIEL_UNLIKELY (full()) {
+            const size_type i = head_;
+            *slot(i)          = value_type(std::forward<Args>(args)...);
+            head_             = wrap(i + 1);
+
+            return *slot(i);
+        }
+
+        const size_type i = physical(size());
+        ::new (slot(i)) value_type(std::forward<Args>(args)...);
+        ++this->size_;
+
+        return *slot(i);
+    }
+
+    void push_back(const value_type& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // Overwrites the back element if full.
+    template<class... Args>
+    reference emplace_front(Args&&... args) {
+        const size_type i = wrap(head_ + Capacity - 1);
+
+        if CIEL_UNLIKELY (full()) {
+            *slot(i) = value_type(std::forward<Args>(args)...);
+
+        } else {
+            ::new (slot(i)) value_type(std::forward<Args>(args)...);
+            ++this->size_;
+        }
+
+        head_ = i;
+
+        return *slot(i);
+    }
+
+    void push_front(const value_type& value) {
+        emplace_front(value);
+    }
+
+    void push_front(value_type&& value) {
+        emplace_front(std::move(value));
+    }
+
+    void pop_front() noexcept {
+        CIEL_ASSERT(!empty());
+
+        slot(head_)->~value_type();
+        head_ = wrap(head_ + 1);
+        --this->size_;
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        slot(physical(size() - 1))->~value_type();
+        --this->size_;
+    }
+
+}; // class inplace_circular_buffer
+
+template<class T, size_t Capacity>
+constexpr bool inplace_circular_buffer<T, Capacity>::is_power_of_two;
+
+template<class T, size_t Capacity>
+struct is_trivially_relocatable<inplace_circular_buffer<T, Capacity>> : is_trivially_relocatable<T> {};
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_INPLACE_CIRCULAR_BUFFER_HPP_
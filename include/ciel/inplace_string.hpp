@@ -0,0 +1,499 @@
+#ifndef CIELLAB_INCLUDE_CIEL_INPLACE_STRING_HPP_
+#define CIELLAB_INCLUDE_CIEL_INPLACE_STRING_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/hash_bytes.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/to_chars.hpp>
+#include <ciel/inplace_vector.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if CIEL_STD_VER >= 17
+#  include <string_view>
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+// inplace_string<N> holds up to N chars inside the object, on top of inplace_vector<char, N + 1>,
+// whose size is narrowest_size_type<N + 1>, so that inplace_string<31> is 33 bytes.
+// The chars are always followed by a '\0', so c_str() is data().
+// Exceeding the capacity throws std::length_error.
+//
+// Integers, bools, pointers and nullptr can be formatted into it by append_to_chars(value),
+// which is ciel::to_chars straight into the buffer.
+
+template<size_t N>
+class inplace_string {
+public:
+    using traits_type            = std::char_traits<char>;
+    using value_type             = char;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = char&;
+    using const_reference        = const char&;
+    using pointer                = char*;
+    using const_pointer          = const char*;
+    using iterator               = char*;
+    using const_iterator         = const char*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    inplace_vector<char, N + 1> chars_;
+
+    void set_size(const size_type count) noexcept {
+        CIEL_ASSERT(count <= capacity());
+
+        chars_.size_         = static_cast<narrowest_size_type<N + 1>>(count + 1);
+        chars_.data()[count] = '\0';
+    }
+
+    void check_append(const size_type count) const {
+        if CIEL_UNLIKELY (count > capacity() - size()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::inplace_string exceeds its capacity"));
+        }
+    }
+
+public:
+    inplace_string() noexcept {
+        chars_.unchecked_push_back('\0');
+    }
+
+    inplace_string(const char* s, const size_type count)
+        : inplace_string() {
+        append(s, count);
+    }
+
+    inplace_string(const char* s)
+        : inplace_string(s, traits_type::length(s)) {}
+
+    inplace_string(const size_type count, const char c)
+        : inplace_string() {
+        append(count, c);
+    }
+
+    explicit inplace_string(const std::string& s)
+        : inplace_string(s.data(), s.size()) {}
+
+#if CIEL_STD_VER >= 17
+    explicit inplace_string(const std::string_view sv)
+        : inplace_string(sv.data(), sv.size()) {}
+#endif
+
+    inplace_string(std::initializer_list<char> ilist)
+        : inplace_string(ilist.begin(), ilist.size()) {}
+
+    template<size_t M, enable_if_t<M != N> = 0>
+    explicit inplace_string(const inplace_string<M>& other)
+        : inplace_string(other.data(), other.size()) {}
+
+    inplace_string& operator=(const char* s) {
+        return assign(s);
+    }
+
+    // s may point into *this.
+    inplace_string& assign(const char* s, const size_type count) {
+        if CIEL_UNLIKELY (count > capacity()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::inplace_string exceeds its capacity"));
+        }
+
+        if (count != 0) {
+            ciel::memmove(data(), s, count);
+        }
+
+        set_size(count);
+        return *this;
+    }
+
+    inplace_string& assign(const char* s) {
+        return assign(s, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::inplace_string"));
+        }
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::inplace_string"));
+        }
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) {
+        CIEL_ASSERT(pos <= size());
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const {
+        CIEL_ASSERT(pos <= size());
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD reference front() {
+        CIEL_ASSERT(!empty());
+
+        return data()[0];
+    }
+
+    CIEL_NODISCARD const_reference front() const {
+        CIEL_ASSERT(!empty());
+
+        return data()[0];
+    }
+
+    CIEL_NODISCARD reference back() {
+        CIEL_ASSERT(!empty());
+
+        return data()[size() - 1];
+    }
+
+    CIEL_NODISCARD const_reference back() const {
+        CIEL_ASSERT(!empty());
+
+        return data()[size() - 1];
+    }
+
+    CIEL_NODISCARD char* data() noexcept {
+        return chars_.data();
+    }
+
+    CIEL_NODISCARD const char* data() const noexcept {
+        return chars_.data();
+    }
+
+    CIEL_NODISCARD const char* c_str() const noexcept {
+        return chars_.data();
+    }
+
+#if CIEL_STD_VER >= 17
+    CIEL_NODISCARD operator std::string_view() const noexcept {
+        return std::string_view(data(), size());
+    }
+#endif
+
+    CIEL_NODISCARD std::string str() const {
+        return std::string(data(), size());
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return data();
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return data();
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return data() + size();
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return data() + size();
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return chars_.size() - 1;
+    }
+
+    CIEL_NODISCARD size_type length() const noexcept {
+        return size();
+    }
+
+    CIEL_NODISCARD static constexpr size_type max_size() noexcept {
+        return N;
+    }
+
+    CIEL_NODISCARD static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    void clear() noexcept {
+        set_size(0);
+    }
+
+    void push_back(const char c) {
+        check_append(1);
+
+        const size_type old_size = size();
+        data()[old_size]         = c;
+        set_size(old_size + 1);
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        set_size(size() - 1);
+    }
+
+    void resize(const size_type count, const char c = '\0') {
+        const size_type old_size = size();
+
+        if (count > old_size) {
+            append(count - old_size, c);
+
+        } else {
+            set_size(count);
+        }
+    }
+
+    inplace_string& append(const char* s, const size_type count) {
+        check_append(count);
+
+        const size_type old_size = size();
+
+        if (count != 0) {
+            ciel::memcpy(data() + old_size, s, count);
+        }
+
+        set_size(old_size + count);
+        return *this;
+    }
+
+    inplace_string& append(const char* s) {
+        return append(s, traits_type::length(s));
+    }
+
+    inplace_string& append(const size_type count, const char c) {
+        check_append(count);
+
+        const size_type old_size = size();
+        std::memset(data() + old_size, c, count);
+        set_size(old_size + count);
+        return *this;
+    }
+
+    template<size_t M>
+    inplace_string& append(const inplace_string<M>& other) {
+        return append(other.data(), other.size());
+    }
+
+    inplace_string& append(const std::string& s) {
+        return append(s.data(), s.size());
+    }
+
+#if CIEL_STD_VER >= 17
+    inplace_string& append(const std::string_view sv) {
+        return append(sv.data(), sv.size());
+    }
+#endif
+
+    // Append the characters of ciel::to_chars(value).
+    template<class T, size_t Width = to_chars_width<T>::value, enable_if_t<Width != static_cast<size_t>(-1)> = 0>
+    inplace_string& append_to_chars(const T value) {
+        const size_type old_size = size();
+
+        if CIEL_LIKELY (Width <= capacity() - old_size) {
+            char* last = ciel::to_chars(data() + old_size, value);
+            set_size(static_cast<size_type>(last - data()));
+            return *this;
+        }
+
+        char buffer[Width];
+        const char* last = ciel::to_chars(buffer, value);
+        return append(buffer, static_cast<size_type>(last - buffer));
+    }
+
+    inplace_string& operator+=(const char c) {
+        push_back(c);
+        return *this;
+    }
+
+    inplace_string& operator+=(const char* s) {
+        return append(s);
+    }
+
+    template<size_t M>
+    inplace_string& operator+=(const inplace_string<M>& other) {
+        return append(other);
+    }
+
+    inplace_string& operator+=(const std::string& s) {
+        return append(s);
+    }
+
+#if CIEL_STD_VER >= 17
+    inplace_string& operator+=(const std::string_view sv) {
+        return append(sv);
+    }
+#endif
+
+    CIEL_NODISCARD int compare(const char* s, const size_type count) const noexcept {
+        const size_type lhs_size = size();
+        const int res            = traits_type::compare(data(), s, ciel::min(lhs_size, count));
+
+        if (res != 0) {
+            return res;
+        }
+
+        return lhs_size < count ? -1 : (lhs_size == count ? 0 : 1);
+    }
+
+    CIEL_NODISCARD int compare(const char* s) const noexcept {
+        return compare(s, traits_type::length(s));
+    }
+
+    template<size_t M>
+    CIEL_NODISCARD int compare(const inplace_string<M>& other) const noexcept {
+        return compare(other.data(), other.size());
+    }
+
+    CIEL_NODISCARD size_type find(const char c, const size_type pos = 0) const noexcept {
+        if (pos >= size()) {
+            return npos;
+        }
+
+        const char* res = ciel::find(data() + pos, end(), c);
+        return res == nullptr ? npos : static_cast<size_type>(res - data());
+    }
+
+    CIEL_NODISCARD size_type find(const char* s, const size_type pos, const size_type count) const noexcept {
+        if (pos > size()) {
+            return npos;
+        }
+
+        const char* res = ciel::find(data() + pos, end(), s, s + count);
+        return res == nullptr ? npos : static_cast<size_type>(res - data());
+    }
+
+    CIEL_NODISCARD size_type find(const char* s, const size_type pos = 0) const noexcept {
+        return find(s, pos, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD bool starts_with(const char* s, const size_type count) const noexcept {
+        return count <= size() && traits_type::compare(data(), s, count) == 0;
+    }
+
+    CIEL_NODISCARD bool starts_with(const char* s) const noexcept {
+        return starts_with(s, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD bool ends_with(const char* s, const size_type count) const noexcept {
+        return count <= size() && traits_type::compare(end() - count, s, count) == 0;
+    }
+
+    CIEL_NODISCARD bool ends_with(const char* s) const noexcept {
+        return ends_with(s, traits_type::length(s));
+    }
+
+    void swap(inplace_string& other) noexcept {
+        const inplace_string tmp = *this;
+        *this                    = other;
+        other                    = tmp;
+    }
+
+}; // class inplace_string
+
+template<size_t N>
+constexpr typename inplace_string<N>::size_type inplace_string<N>::npos;
+
+template<size_t N, size_t M>
+CIEL_NODISCARD bool operator==(const inplace_string<N>& lhs, const inplace_string<M>& rhs) noexcept {
+    return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template<size_t N>
+CIEL_NODISCARD bool operator==(const inplace_string<N>& lhs, const char* rhs) noexcept {
+    return lhs.compare(rhs) == 0;
+}
+
+template<size_t N>
+CIEL_NODISCARD bool operator==(const char* lhs, const inplace_string<N>& rhs) noexcept {
+    return rhs.compare(lhs) == 0;
+}
+
+template<size_t N, size_t M>
+CIEL_NODISCARD bool operator<(const inplace_string<N>& lhs, const inplace_string<M>& rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template<size_t N>
+CIEL_NODISCARD bool operator<(const inplace_string<N>& lhs, const char* rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template<size_t N>
+CIEL_NODISCARD bool operator<(const char* lhs, const inplace_string<N>& rhs) noexcept {
+    return rhs.compare(lhs) > 0;
+}
+
+template<size_t N>
+std::ostream& operator<<(std::ostream& out, const inplace_string<N>& s) {
+    return out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<size_t N>
+struct hash<ciel::inplace_string<N>> {
+    CIEL_NODISCARD size_t operator()(const ciel::inplace_string<N>& s) const noexcept {
+        return ciel::hash_bytes(s.data(), s.size());
+    }
+
+}; // struct hash<ciel::inplace_string<N>>
+
+template<size_t N>
+void swap(ciel::inplace_string<N>& lhs, ciel::inplace_string<N>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_INPLACE_STRING_HPP_
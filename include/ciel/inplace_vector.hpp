@@ -11,6 +11,7 @@
 #include <ciel/core/iterator_category.hpp>
 #include <ciel/core/message.hpp>
 #include <ciel/range_destroyer.hpp>
+#include <ciel/relocate.hpp>
 #include <ciel/swap.hpp>
 #include <ciel/to_address.hpp>
 
@@ -107,7 +108,7 @@ struct maybe_has_trivial_move_constructor : maybe_has_trivial_copy_constructor<T
     maybe_has_trivial_move_constructor(maybe_has_trivial_move_constructor&& o) noexcept(
         std::is_nothrow_move_constructible<T>::value || is_trivially_relocatable<T>::value) {
         if (is_trivially_relocatable<T>::value) {
-            ciel::memcpy(std::addressof(this->data_), std::addressof(o.data_), sizeof(T) * o.size_);
+            ciel::uninitialized_relocate_n(o.data_, o.size_, this->data_);
             this->size_ = ciel::exchange(o.size_, 0);
 
         } else {
@@ -183,7 +184,7 @@ struct maybe_has_trivial_move_assignment : maybe_has_trivial_copy_assignment<T,
         if (is_trivially_relocatable<T>::value) {
             self.clear();
 
-            ciel::memcpy(std::addressof(this->data_), std::addressof(o.data_), sizeof(T) * o.size_);
+            ciel::uninitialized_relocate_n(o.data_, o.size_, this->data_);
             this->size_ = ciel::exchange(o.size_, 0);
 
         } else {
@@ -239,6 +240,9 @@ struct conditional_copyable_and_moveable<T, false, true> {
 
 } // namespace detail
 
+template<size_t>
+class inplace_string;
+
 template<class T, size_t Capacity>
 class inplace_vector : private detail::maybe_has_trivial_move_assignment<T, Capacity, inplace_vector<T, Capacity>>,
                        private detail::conditional_copyable_and_moveable<T> {
@@ -256,6 +260,8 @@ class inplace_vector : private detail::maybe_has_trivial_move_assignment<T, Capa
     friend struct detail::maybe_has_trivial_copy_assignment;
     template<class, size_t, class, bool>
     friend struct detail::maybe_has_trivial_move_assignment;
+    template<size_t>
+    friend class inplace_string;
 
 public:
     using base_type::base_type;
@@ -735,7 +741,7 @@ private:
             const size_type pos_end_dis = end_() - pos;
 
             if (is_trivially_relocatable<value_type>::value) {
-                ciel::memmove(pos + count, pos, sizeof(value_type) * pos_end_dis);
+                ciel::uninitialized_relocate_backward(pos, end_(), end_() + count);
                 this->size_ -= pos_end_dis;
                 rd.advance_backward(pos_end_dis);
 
@@ -1039,13 +1045,7 @@ private:
 
         } else if (is_trivially_relocatable<value_type>::value) {
             destroy(first, last);
-
-            if (count >= back_count) {
-                ciel::memcpy(first, last, sizeof(value_type) * back_count);
-
-            } else {
-                ciel::memmove(first, last, sizeof(value_type) * back_count);
-            }
+            ciel::uninitialized_relocate_n(last, back_count, first);
 
         } else {
             pointer new_end = std::move(last, end_(), first);
@@ -0,0 +1,130 @@
+#ifndef CIELLAB_INCLUDE_CIEL_MALLOC_ALLOCATOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_MALLOC_ALLOCATOR_HPP_
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__APPLE__) && __has_include(<malloc/malloc.h>)
+#  include <malloc/malloc.h>
+#  define CIEL_HAS_MALLOC_USABLE_SIZE
+#elif (defined(__GLIBC__) || defined(__linux__) || defined(__FreeBSD__)) && __has_include(<malloc.h>)
+#  include <malloc.h>
+#  define CIEL_HAS_MALLOC_USABLE_SIZE
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+// malloc_usable_size
+// Return the number of usable bytes in the block pointed to by p, which is returned by malloc.
+// Falls back to the requested bytes when the platform can't tell.
+
+CIEL_NODISCARD inline size_t malloc_usable_size(void* p, const size_t requested) noexcept {
+    CIEL_ASSERT(p != nullptr);
+
+#ifdef CIEL_HAS_MALLOC_USABLE_SIZE
+#  ifdef __APPLE__
+    const size_t res = ::malloc_size(p);
+#  else
+    const size_t res = ::malloc_usable_size(p);
+#  endif
+    CIEL_ASSERT(res >= requested);
+    CIEL_UNUSED(requested);
+
+    return res;
+#else
+    CIEL_UNUSED(p);
+
+    return requested;
+#endif
+}
+
+// malloc_allocator
+// Allocate through malloc, and report the whole usable block through allocate_at_least,
+// so that containers can take the slack in malloc's size class as their capacity.
+// reallocate_at_least goes through realloc, which may grow the block in place,
+// or remap the pages of a large block instead of copying them.
+
+template<class T>
+class malloc_allocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator doesn't support over-aligned types");
+
+public:
+    using value_type                             = T;
+    using size_type                              = size_t;
+    using difference_type                        = ptrdiff_t;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal                        = std::true_type;
+
+    malloc_allocator() = default;
+
+    template<class U>
+    malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+    CIEL_NODISCARD T* allocate(const size_type n) {
+        if CIEL_UNLIKELY (n > max_size()) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        void* res = std::malloc(n * sizeof(T));
+
+        if CIEL_UNLIKELY (res == nullptr) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        return static_cast<T*>(res);
+    }
+
+    CIEL_NODISCARD allocation_result<T*, size_type> allocate_at_least(const size_type n) {
+        T* res = allocate(n);
+
+        return {res, ciel::malloc_usable_size(res, n * sizeof(T)) / sizeof(T)};
+    }
+
+    CIEL_NODISCARD allocation_result<T*, size_type> reallocate_at_least(T* p, size_type, const size_type n) {
+        CIEL_ASSERT(p != nullptr);
+        CIEL_ASSERT(n != 0);
+
+        if CIEL_UNLIKELY (n > max_size()) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        // p is still valid when realloc fails.
+        void* res = std::realloc(static_cast<void*>(p), n * sizeof(T));
+
+        if CIEL_UNLIKELY (res == nullptr) {
+            CIEL_THROW_EXCEPTION(std::bad_alloc{});
+        }
+
+        return {static_cast<T*>(res), ciel::malloc_usable_size(res, n * sizeof(T)) / sizeof(T)};
+    }
+
+    void deallocate(T* p, size_type) noexcept {
+        std::free(p);
+    }
+
+    CIEL_NODISCARD static constexpr size_type max_size() noexcept {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+}; // class malloc_allocator
+
+template<class T, class U>
+CIEL_NODISCARD bool operator==(const malloc_allocator<T>&, const malloc_allocator<U>&) noexcept {
+    return true;
+}
+
+template<class T, class U>
+CIEL_NODISCARD bool operator!=(const malloc_allocator<T>&, const malloc_allocator<U>&) noexcept {
+    return false;
+}
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_MALLOC_ALLOCATOR_HPP_
@@ -0,0 +1,82 @@
+#ifndef CIELLAB_INCLUDE_CIEL_PARALLEL_POLICY_HPP_
+#define CIELLAB_INCLUDE_CIEL_PARALLEL_POLICY_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/message.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+NAMESPACE_CIEL_BEGIN
+
+// parallel_policy
+// Opt in to split a bulk operation across threads, e.g. constructing a vector of trivially copyable elements.
+// Each thread writes its own part of the newly allocated buffer first, so that the pages are touched
+// and thus placed on the NUMA node of the thread which uses them.
+
+struct parallel_policy {
+    size_t threads;
+
+    parallel_policy() noexcept
+        : threads(std::thread::hardware_concurrency()) {}
+
+    explicit parallel_policy(const size_t t) noexcept
+        : threads(t) {}
+
+}; // struct parallel_policy
+
+namespace detail {
+
+// Split [0, count) into chunks, call f(first, last) on each of them concurrently.
+// Each chunk has at least min_bytes_per_thread bytes so that small ranges won't pay for thread creation,
+// and is a multiple of page_size bytes (except the last one) so that few pages are shared between threads.
+template<class F>
+void parallel_for(const parallel_policy policy, const size_t count, const size_t value_size, F f) {
+    static constexpr size_t page_size            = 4096;
+    static constexpr size_t min_bytes_per_thread = size_t{1} << 20;
+
+    CIEL_ASSERT(value_size != 0);
+
+    const size_t bytes       = count * value_size;
+    const size_t max_threads = bytes / min_bytes_per_thread;
+    const size_t threads     = ciel::min(policy.threads, max_threads);
+    const size_t page_count  = value_size <= page_size ? page_size / value_size : 1;
+    const size_t raw_chunk   = threads > 1 ? (count + threads - 1) / threads : count;
+    const size_t chunk       = (raw_chunk + page_count - 1) / page_count * page_count;
+
+    if (threads <= 1 || chunk >= count) {
+        if (count != 0) {
+            f(size_t{0}, count);
+        }
+
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    size_t first = 0;
+
+    CIEL_TRY {
+        workers.reserve(threads);
+
+        for (; first + chunk < count; first += chunk) {
+            workers.emplace_back(f, first, first + chunk);
+        }
+    }
+    CIEL_CATCH (...) {
+        // Can't create more threads, the calling thread takes the rest.
+    }
+
+    // The calling thread takes the last chunk.
+    f(first, count);
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace detail
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_PARALLEL_POLICY_HPP_
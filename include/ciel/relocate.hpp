@@ -0,0 +1,203 @@
+#ifndef CIELLAB_INCLUDE_CIEL_RELOCATE_HPP_
+#define CIELLAB_INCLUDE_CIEL_RELOCATE_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/swap.hpp>
+#include <ciel/to_address.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// Relocation algorithms of P1144: https://www.open-std.org/jtc1/sc22/wg21/docs/papers/2024/p1144r10.html
+//
+// Relocating an object moves it to another address and ends the lifetime of the source, which is left as
+// uninitialized storage. Trivially relocatable types are relocated with memmove, the others by move constructing
+// the destination then destroying the source. Source and destination ranges may overlap as they do for memmove,
+// i.e. uninitialized_relocate shifts to the left and uninitialized_relocate_backward shifts to the right.
+// If a move constructor throws, all objects of both ranges are destroyed before rethrowing.
+//
+// Containers which construct and destroy through an allocator only call these
+// when the allocator doesn't customize construct and destroy.
+
+namespace detail {
+
+template<class InputIt, class ForwardIt, class T = typename std::iterator_traits<InputIt>::value_type>
+struct is_relocatable_via_memmove
+    : bool_constant<is_contiguous_iterator<InputIt>::value && is_contiguous_iterator<ForwardIt>::value
+                    && std::is_same<T, typename std::iterator_traits<ForwardIt>::value_type>::value
+                    && is_trivially_relocatable<T>::value> {};
+
+template<class T>
+T* relocate_at(T* source, T* dest, std::true_type) noexcept {
+    if (source != dest) {
+        ciel::memmove(dest, source, sizeof(T));
+    }
+
+    return dest;
+}
+
+template<class T>
+T* relocate_at(T* source, T* dest, std::false_type) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    ::new (static_cast<void*>(dest)) T(std::move(*source));
+    source->~T();
+
+    return dest;
+}
+
+template<class Iter>
+void destroy_range(Iter first, Iter last) noexcept {
+    using T = typename std::iterator_traits<Iter>::value_type;
+
+    for (; first != last; ++first) {
+        std::addressof(*first)->~T();
+    }
+}
+
+template<class InputIt, class ForwardIt>
+ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first, std::true_type) noexcept {
+    using T = typename std::iterator_traits<InputIt>::value_type;
+
+    const auto count = std::distance(first, last);
+
+    if (count != 0) {
+        ciel::memmove(ciel::to_address(d_first), ciel::to_address(first), sizeof(T) * count);
+    }
+
+    return d_first + count;
+}
+
+template<class InputIt, class ForwardIt>
+ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first, std::false_type) {
+    using T = typename std::iterator_traits<ForwardIt>::value_type;
+
+    ForwardIt cur = d_first;
+
+    CIEL_TRY {
+        for (; first != last; ++first, (void)++cur) {
+            ::new (static_cast<void*>(std::addressof(*cur))) T(std::move(*first));
+            std::addressof(*first)->~T();
+        }
+    }
+    CIEL_CATCH (...) {
+        detail::destroy_range(first, last);
+        detail::destroy_range(d_first, cur);
+        CIEL_THROW;
+    }
+
+    return cur;
+}
+
+template<class BidirIt1, class BidirIt2>
+BidirIt2 uninitialized_relocate_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::true_type) noexcept {
+    using T = typename std::iterator_traits<BidirIt1>::value_type;
+
+    const auto count = std::distance(first, last);
+
+    if (count != 0) {
+        ciel::memmove(ciel::to_address(d_last - count), ciel::to_address(first), sizeof(T) * count);
+    }
+
+    return d_last - count;
+}
+
+template<class BidirIt1, class BidirIt2>
+BidirIt2 uninitialized_relocate_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::false_type) {
+    using T = typename std::iterator_traits<BidirIt2>::value_type;
+
+    const BidirIt2 old_d_last = d_last;
+
+    CIEL_TRY {
+        while (first != last) {
+            --last;
+            --d_last;
+
+            ::new (static_cast<void*>(std::addressof(*d_last))) T(std::move(*last));
+            std::addressof(*last)->~T();
+        }
+    }
+    CIEL_CATCH (...) {
+        // *last is still alive, *d_last was not constructed.
+        detail::destroy_range(first, std::next(last));
+        detail::destroy_range(std::next(d_last), old_d_last);
+        CIEL_THROW;
+    }
+
+    return d_last;
+}
+
+template<class T>
+void relocate_swap(T& lhs, T& rhs, std::true_type) noexcept {
+    ciel::relocatable_swap(lhs, rhs);
+}
+
+template<class T>
+void relocate_swap(T& lhs, T& rhs, std::false_type) noexcept(noexcept(std::swap(lhs, rhs))) {
+    using std::swap;
+    swap(lhs, rhs);
+}
+
+} // namespace detail
+
+// relocate_at
+// Relocate *source to dest, which should be uninitialized storage.
+
+template<class T>
+T* relocate_at(T* source, T* dest) noexcept(is_trivially_relocatable<T>::value
+                                            || std::is_nothrow_move_constructible<T>::value) {
+    static_assert(!std::is_const<T>::value, "Relocation ends the lifetime of the source, which can't be const");
+
+    return detail::relocate_at(source, dest, is_trivially_relocatable<T>{});
+}
+
+// uninitialized_relocate
+// Relocate [first, last) to the uninitialized storage starting at d_first, return the end of the destination.
+
+template<class InputIt, class ForwardIt>
+ForwardIt uninitialized_relocate(InputIt first, InputIt last, ForwardIt d_first) {
+    return detail::uninitialized_relocate(first, last, d_first,
+                                          detail::is_relocatable_via_memmove<InputIt, ForwardIt>{});
+}
+
+// uninitialized_relocate_n
+// Relocate [first, first + count) to the uninitialized storage starting at d_first,
+// return the ends of the source and the destination.
+
+template<class InputIt, class Size, class ForwardIt>
+std::pair<InputIt, ForwardIt> uninitialized_relocate_n(InputIt first, const Size count, ForwardIt d_first) {
+    const InputIt last = std::next(first, count);
+
+    return {last, ciel::uninitialized_relocate(first, last, d_first)};
+}
+
+// uninitialized_relocate_backward
+// Relocate [first, last) to the uninitialized storage ending at d_last, from the last element to the first one,
+// return the beginning of the destination.
+
+template<class BidirIt1, class BidirIt2>
+BidirIt2 uninitialized_relocate_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last) {
+    return detail::uninitialized_relocate_backward(first, last, d_last,
+                                                   detail::is_relocatable_via_memmove<BidirIt1, BidirIt2>{});
+}
+
+// relocate_swap
+// Swap through relocation if T is trivially relocatable, which is three memcpys of T's bytes,
+// otherwise through swap.
+
+template<class T>
+void relocate_swap(T& lhs, T& rhs) noexcept(is_trivially_relocatable<T>::value
+                                            || noexcept(detail::relocate_swap(lhs, rhs, std::false_type{}))) {
+    detail::relocate_swap(lhs, rhs, is_trivially_relocatable<T>{});
+}
+
+NAMESPACE_CIEL_END
+
+#endif // CIELLAB_INCLUDE_CIEL_RELOCATE_HPP_
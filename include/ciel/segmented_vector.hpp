@@ -0,0 +1,618 @@
+#ifndef CIELLAB_INCLUDE_CIEL_SEGMENTED_VECTOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_SEGMENTED_VECTOR_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/iterator_category.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+NAMESPACE_CIEL_BEGIN
+
+// segmented_vector
+// Elements live in fixed-size chunks, and only the chunk pointers are kept in a ciel::vector.
+// Growing allocates a new chunk instead of relocating the elements, so push_back is O(1) in the worst case
+// (except for growing the chunk map, which is tiny), and references to elements are never invalidated
+// by push_back or pop_front. pop_front deallocates a chunk as soon as it becomes empty.
+// Iterators are invalidated by push_back and pop_front, like std::deque.
+// Only insertions and erasures at both ends are supported, so that elements never move.
+
+namespace detail {
+
+// The largest power of two not greater than n.
+constexpr size_t segmented_vector_floor_pow2(const size_t n, const size_t res = 1) noexcept {
+    return res * 2 <= n ? segmented_vector_floor_pow2(n, res * 2) : res;
+}
+
+// Chunks of about 4 KiB, and at least 16 elements.
+template<class T>
+struct segmented_vector_default_chunk_size
+    : std::integral_constant<size_t, sizeof(T) <= 4096 / 16 ? segmented_vector_floor_pow2(4096 / sizeof(T)) : 16> {
+};
+
+} // namespace detail
+
+template<class T, class ChunkPointer, class Reference, size_t ChunkSize>
+class segmented_vector_iterator
+    : public random_access_iterator_base<segmented_vector_iterator<T, ChunkPointer, Reference, ChunkSize>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = T;
+    using pointer           = remove_reference_t<Reference>*;
+    using reference         = Reference;
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+
+private:
+    // The element is map_[index_ / ChunkSize][index_ % ChunkSize].
+    const ChunkPointer* map_{nullptr};
+    size_t index_{0};
+
+public:
+    segmented_vector_iterator() = default;
+
+    segmented_vector_iterator(const ChunkPointer* map, const size_t index) noexcept
+        : map_(map), index_(index) {}
+
+    template<class R, enable_if_t<std::is_convertible<remove_reference_t<R>*, pointer>::value> = 0>
+    segmented_vector_iterator(const segmented_vector_iterator<T, ChunkPointer, R, ChunkSize>& other) noexcept
+        : map_(other.map()), index_(other.index()) {}
+
+    void go_next() noexcept {
+        ++index_;
+    }
+
+    void go_prev() noexcept {
+        --index_;
+    }
+
+    void advance(const difference_type n) noexcept {
+        index_ += n;
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        CIEL_ASSERT(map_ != nullptr);
+
+        return map_[index_ / ChunkSize][index_ % ChunkSize];
+    }
+
+    CIEL_NODISCARD pointer operator->() const noexcept {
+        return std::addressof(**this);
+    }
+
+    CIEL_NODISCARD reference operator[](const difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    CIEL_NODISCARD const ChunkPointer* map() const noexcept {
+        return map_;
+    }
+
+    CIEL_NODISCARD size_t index() const noexcept {
+        return index_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const segmented_vector_iterator& lhs,
+                                          const segmented_vector_iterator& rhs) noexcept {
+        return lhs.index() == rhs.index();
+    }
+
+    CIEL_NODISCARD friend bool operator<(const segmented_vector_iterator& lhs,
+                                         const segmented_vector_iterator& rhs) noexcept {
+        return lhs.index() < rhs.index();
+    }
+
+    CIEL_NODISCARD friend segmented_vector_iterator operator+(segmented_vector_iterator iter,
+                                                              const difference_type n) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend segmented_vector_iterator operator+(const difference_type n,
+                                                              segmented_vector_iterator iter) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend segmented_vector_iterator operator-(segmented_vector_iterator iter,
+                                                              const difference_type n) noexcept {
+        iter -= n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend difference_type operator-(const segmented_vector_iterator& lhs,
+                                                    const segmented_vector_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index() - rhs.index());
+    }
+
+}; // class segmented_vector_iterator
+
+template<class T, size_t ChunkSize = detail::segmented_vector_default_chunk_size<T>::value,
+         class Allocator = std::allocator<T>>
+class segmented_vector {
+    static_assert(std::is_same<typename Allocator::value_type, T>::value, "");
+    static_assert(ChunkSize != 0, "");
+
+public:
+    using value_type      = T;
+    using allocator_type  = Allocator;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer   = typename std::allocator_traits<allocator_type>::const_pointer;
+    using iterator               = segmented_vector_iterator<value_type, pointer, value_type&, ChunkSize>;
+    using const_iterator         = segmented_vector_iterator<value_type, pointer, const value_type&, ChunkSize>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type chunk_size = ChunkSize;
+
+private:
+    using alloc_traits  = std::allocator_traits<allocator_type>;
+    using map_allocator = typename alloc_traits::template rebind_alloc<pointer>;
+    using map_type      = vector<pointer, map_allocator>;
+
+    // [0, begin_ / chunk_size) of map_ are already deallocated chunks, which are erased lazily.
+    // [begin_, begin_ + size()) are the elements, the rest of the chunks are spare.
+    map_type map_;
+    size_type begin_{0};
+    compressed_pair<size_type, allocator_type> size_alloc_{0, default_init};
+
+    CIEL_NODISCARD size_type& size_() noexcept {
+        return size_alloc_.first();
+    }
+
+    CIEL_NODISCARD const size_type& size_() const noexcept {
+        return size_alloc_.first();
+    }
+
+    allocator_type& allocator_() noexcept {
+        return size_alloc_.second();
+    }
+
+    const allocator_type& allocator_() const noexcept {
+        return size_alloc_.second();
+    }
+
+    CIEL_NODISCARD pointer slot(const size_type index) const noexcept {
+        return map_[index / chunk_size] + index % chunk_size;
+    }
+
+    CIEL_NODISCARD size_type end_index() const noexcept {
+        return begin_ + size_();
+    }
+
+    // Append one more chunk to map_.
+    void add_chunk() {
+        const pointer chunk = alloc_traits::allocate(allocator_(), chunk_size);
+
+        CIEL_TRY {
+            map_.emplace_back(chunk);
+        }
+        CIEL_CATCH (...) {
+            alloc_traits::deallocate(allocator_(), chunk, chunk_size);
+            CIEL_THROW;
+        }
+    }
+
+    void deallocate_chunks(const size_type first, const size_type last) noexcept {
+        for (size_type i = first; i < last; ++i) {
+            alloc_traits::deallocate(allocator_(), map_[i], chunk_size);
+            map_[i] = nullptr;
+        }
+    }
+
+    // Erase the deallocated chunks at the front of map_ once they outnumber the rest,
+    // so that each of them is shifted at most once on average.
+    void compact_map() noexcept {
+        const size_type dead = begin_ / chunk_size;
+
+        if (dead != 0 && dead >= map_.size() - dead) {
+            map_.erase(map_.begin(), map_.begin() + dead);
+            begin_ -= dead * chunk_size;
+        }
+    }
+
+    void do_destroy() noexcept {
+        clear();
+        deallocate_chunks(begin_ / chunk_size, map_.size());
+        map_.clear();
+        begin_ = 0;
+    }
+
+    // The chunks are deallocated by the old allocator before it's replaced.
+    void copy_assign_alloc(const segmented_vector& other, std::true_type) {
+        if (allocator_() != other.allocator_()) {
+            do_destroy();
+        }
+
+        allocator_() = other.allocator_();
+    }
+
+    void copy_assign_alloc(const segmented_vector&, std::false_type) noexcept {}
+
+    void move_assign_alloc(segmented_vector& other, std::true_type) noexcept {
+        allocator_() = std::move(other.allocator_());
+    }
+
+    void move_assign_alloc(segmented_vector&, std::false_type) noexcept {}
+
+    void swap_alloc(segmented_vector& other, std::true_type) noexcept {
+        using std::swap;
+        swap(allocator_(), other.allocator_());
+    }
+
+    void swap_alloc(segmented_vector&, std::false_type) noexcept {}
+
+    template<class Iter>
+    void construct_at_end(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+public:
+    segmented_vector() = default;
+
+    explicit segmented_vector(const allocator_type& alloc)
+        : map_(map_allocator(alloc)), size_alloc_(0, alloc) {}
+
+    segmented_vector(const size_type count, const value_type& value, const allocator_type& alloc = allocator_type())
+        : segmented_vector(alloc) {
+        reserve(count);
+
+        for (size_type i = 0; i < count; ++i) {
+            emplace_back(value);
+        }
+    }
+
+    explicit segmented_vector(const size_type count, const allocator_type& alloc = allocator_type())
+        : segmented_vector(alloc) {
+        reserve(count);
+
+        for (size_type i = 0; i < count; ++i) {
+            emplace_back();
+        }
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    segmented_vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
+        : segmented_vector(alloc) {
+        construct_at_end(first, last);
+    }
+
+    segmented_vector(const segmented_vector& other)
+        : segmented_vector(other, alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+    segmented_vector(const segmented_vector& other, const allocator_type& alloc)
+        : segmented_vector(alloc) {
+        reserve(other.size());
+        construct_at_end(other.begin(), other.end());
+    }
+
+    segmented_vector(segmented_vector&& other) noexcept
+        : map_(std::move(other.map_)),
+          begin_(ciel::exchange(other.begin_, 0)),
+          size_alloc_(ciel::exchange(other.size_(), 0), std::move(other.allocator_())) {}
+
+    segmented_vector(std::initializer_list<value_type> init, const allocator_type& alloc = allocator_type())
+        : segmented_vector(alloc) {
+        reserve(init.size());
+        construct_at_end(init.begin(), init.end());
+    }
+
+    ~segmented_vector() {
+        do_destroy();
+    }
+
+    segmented_vector& operator=(const segmented_vector& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        copy_assign_alloc(other, typename alloc_traits::propagate_on_container_copy_assignment{});
+
+        clear();
+        construct_at_end(other.begin(), other.end());
+
+        return *this;
+    }
+
+    segmented_vector& operator=(segmented_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        if (alloc_traits::propagate_on_container_move_assignment::value || allocator_() == other.allocator_()) {
+            do_destroy();
+
+            map_    = std::move(other.map_);
+            begin_  = ciel::exchange(other.begin_, 0);
+            size_() = ciel::exchange(other.size_(), 0);
+            move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment{});
+
+        } else {
+            clear();
+            construct_at_end(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+
+        return *this;
+    }
+
+    segmented_vector& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        construct_at_end(ilist.begin(), ilist.end());
+
+        return *this;
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::segmented_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::segmented_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) {
+        CIEL_ASSERT(pos < size());
+
+        return *slot(begin_ + pos);
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const {
+        CIEL_ASSERT(pos < size());
+
+        return *slot(begin_ + pos);
+    }
+
+    CIEL_NODISCARD reference front() {
+        CIEL_ASSERT(!empty());
+
+        return *slot(begin_);
+    }
+
+    CIEL_NODISCARD const_reference front() const {
+        CIEL_ASSERT(!empty());
+
+        return *slot(begin_);
+    }
+
+    CIEL_NODISCARD reference back() {
+        CIEL_ASSERT(!empty());
+
+        return *slot(end_index() - 1);
+    }
+
+    CIEL_NODISCARD const_reference back() const {
+        CIEL_ASSERT(!empty());
+
+        return *slot(end_index() - 1);
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return {map_.data(), begin_};
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return {map_.data(), begin_};
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return {map_.data(), end_index()};
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return {map_.data(), end_index()};
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_();
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return std::min<size_type>(std::numeric_limits<difference_type>::max(), alloc_traits::max_size(allocator_()));
+    }
+
+    // Allocate chunks in advance so that the next new_cap - size() push_backs won't allocate.
+    void reserve(const size_type new_cap) {
+        if CIEL_UNLIKELY (new_cap > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error{"ciel::segmented_vector::reserve capacity beyond max_size"});
+        }
+
+        const size_type chunk_count = (begin_ + new_cap + chunk_size - 1) / chunk_size;
+
+        if (chunk_count <= map_.size()) {
+            return;
+        }
+
+        map_.reserve(chunk_count);
+
+        while (map_.size() < chunk_count) {
+            add_chunk();
+        }
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return map_.size() * chunk_size - begin_;
+    }
+
+    // Deallocate the spare chunks, the elements are not moved.
+    void shrink_to_fit() noexcept {
+        const size_type used = (end_index() + chunk_size - 1) / chunk_size;
+        deallocate_chunks(used, map_.size());
+        map_.erase(map_.begin() + used, map_.end());
+
+        compact_map();
+    }
+
+    void clear() noexcept {
+        for (size_type i = begin_; i != end_index(); ++i) {
+            alloc_traits::destroy(allocator_(), ciel::to_address(slot(i)));
+        }
+
+        size_() = 0;
+
+        // Reuse the whole front chunk.
+        begin_ -= begin_ % chunk_size;
+    }
+
+    template<class... Args>
+    reference emplace_back(Args&&... args) {
+        if (end_index() == map_.size() * chunk_size) {
+            add_chunk();
+        }
+
+        const pointer p = slot(end_index());
+        alloc_traits::construct(allocator_(), ciel::to_address(p), std::forward<Args>(args)...);
+        ++size_();
+
+        return *p;
+    }
+
+    template<class U, class... Args>
+    reference emplace_back(std::initializer_list<U> il, Args&&... args) {
+        if (end_index() == map_.size() * chunk_size) {
+            add_chunk();
+        }
+
+        const pointer p = slot(end_index());
+        alloc_traits::construct(allocator_(), ciel::to_address(p), il, std::forward<Args>(args)...);
+        ++size_();
+
+        return *p;
+    }
+
+    void push_back(const value_type& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        alloc_traits::destroy(allocator_(), ciel::to_address(slot(end_index() - 1)));
+        --size_();
+    }
+
+    // Deallocate the front chunk once its last element is popped, unless it's the only one left.
+    void pop_front() noexcept {
+        CIEL_ASSERT(!empty());
+
+        alloc_traits::destroy(allocator_(), ciel::to_address(slot(begin_)));
+        ++begin_;
+        --size_();
+
+        if (begin_ % chunk_size == 0) {
+            const size_type chunk_index = begin_ / chunk_size - 1;
+
+            if (empty() && chunk_index + 1 == map_.size()) {
+                // Keep the last chunk for the next push_back.
+                begin_ -= chunk_size;
+                return;
+            }
+
+            deallocate_chunks(chunk_index, chunk_index + 1);
+            compact_map();
+        }
+    }
+
+    void swap(segmented_vector& other) noexcept {
+        using std::swap;
+
+        swap(map_, other.map_);
+        swap(begin_, other.begin_);
+        swap(size_(), other.size_());
+
+        swap_alloc(other, typename alloc_traits::propagate_on_container_swap{});
+    }
+
+}; // class segmented_vector
+
+template<class T, size_t ChunkSize, class Allocator>
+constexpr typename segmented_vector<T, ChunkSize, Allocator>::size_type
+    segmented_vector<T, ChunkSize, Allocator>::chunk_size;
+
+template<class T, size_t ChunkSize, class Allocator>
+struct is_trivially_relocatable<segmented_vector<T, ChunkSize, Allocator>>
+    : conjunction<is_trivially_relocatable<Allocator>,
+                  is_trivially_relocatable<typename segmented_vector<T, ChunkSize, Allocator>::pointer>> {};
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class T, size_t ChunkSize, class Allocator>
+void swap(ciel::segmented_vector<T, ChunkSize, Allocator>& lhs,
+          ciel::segmented_vector<T, ChunkSize, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_SEGMENTED_VECTOR_HPP_
@@ -235,7 +235,7 @@ public:
 }; // class control_block_with_instance
 
 template<class T>
-class shared_ptr {
+class CIEL_TRIVIAL_ABI shared_ptr {
 public:
     using element_type = remove_extent_t<T>;
     using pointer      = element_type*;
@@ -572,7 +572,7 @@ shared_ptr(std::unique_ptr<T, D>) -> shared_ptr<T>;
 #endif
 
 template<class T>
-class weak_ptr {
+class CIEL_TRIVIAL_ABI weak_ptr {
 public:
     using element_type = remove_extent_t<T>;
     using pointer      = element_type*;
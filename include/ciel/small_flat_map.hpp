@@ -0,0 +1,431 @@
+#ifndef CIELLAB_INCLUDE_CIEL_SMALL_FLAT_MAP_HPP_
+#define CIELLAB_INCLUDE_CIEL_SMALL_FLAT_MAP_HPP_
+
+#include <ciel/core/config.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/logical.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/find.hpp>
+#include <ciel/flat_map.hpp>
+#include <ciel/inplace_vector.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// small_flat_map
+// A map for a handful of elements. Up to N keys and mapped values are kept unsorted in two inplace_vectors,
+// and looked up by a linear scan of the keys with ciel::find, which compares 16 or 32 bytes at a time
+// for arithmetic keys. Inserting the (N + 1)-th element spills all of them into a ciel::flat_map,
+// i.e. sorted ciel::vectors on the heap, which is used from then on until the map becomes empty again.
+//
+// Keys are compared by operator== while inline and by Compare once spilled, the two must agree.
+// The iteration order is the insertion order while inline, except that erase moves the last element
+// into the erased one's place, and the Compare order once spilled.
+// Iterators are the ones of flat_map, yielding std::pair<const Key&, T&>.
+
+template<class Key, class T, size_t N, class Compare = std::less<Key>>
+class small_flat_map {
+    static_assert(N > 0, "");
+
+public:
+    using key_type               = Key;
+    using mapped_type            = T;
+    using value_type             = std::pair<key_type, mapped_type>;
+    using key_compare            = Compare;
+    using reference              = std::pair<const key_type&, mapped_type&>;
+    using const_reference        = std::pair<const key_type&, const mapped_type&>;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using iterator               = flat_map_iterator<key_type, mapped_type, false>;
+    using const_iterator         = flat_map_iterator<key_type, mapped_type, true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using spill_type             = flat_map<key_type, mapped_type, key_compare>;
+
+private:
+    inplace_vector<key_type, N> keys_;
+    inplace_vector<mapped_type, N> values_;
+    spill_type spilled_;
+
+    CIEL_NODISCARD iterator make_iterator(const size_type i) noexcept {
+        return iterator(keys_.data() + i, values_.data() + i);
+    }
+
+    CIEL_NODISCARD const_iterator make_iterator(const size_type i) const noexcept {
+        return const_iterator(keys_.data() + i, values_.data() + i);
+    }
+
+    CIEL_DIAGNOSTIC_PUSH
+    // GCC warns that the result of key_comp() is ignored when key_compare is an empty class, like std::less.
+    CIEL_GCC_DIAGNOSTIC_IGNORED("-Wunused-result")
+
+    key_compare comp_() const {
+        return spilled_.key_comp();
+    }
+
+    CIEL_DIAGNOSTIC_POP
+
+    CIEL_NODISCARD size_type find_index(const key_type& key) const {
+        CIEL_ASSERT(is_inline());
+
+        return static_cast<size_type>(ciel::find(keys_, key) - keys_.begin());
+    }
+
+    // Move all the elements into spilled_. Nothing is moved from until both vectors are allocated and the order
+    // is known, and elements which may throw on move are copied first, so that *this is unchanged on exception.
+    void spill() {
+        CIEL_ASSERT(is_inline());
+        CIEL_ASSERT(keys_.size() == N);
+
+        const key_compare comp = comp_();
+
+        size_type order[N];
+        std::iota(order, order + N, size_type{0});
+        std::sort(order, order + N, [&](const size_type lhs, const size_type rhs) {
+            return comp(keys_[lhs], keys_[rhs]);
+        });
+
+        vector<key_type> keys(reserve_capacity, N);
+        vector<mapped_type> values(reserve_capacity, N);
+
+        const auto fill_keys = [&] {
+            for (const size_type i : order) {
+                keys.unchecked_emplace_back(std::move_if_noexcept(keys_[i]));
+            }
+        };
+
+        const auto fill_values = [&] {
+            for (const size_type i : order) {
+                values.unchecked_emplace_back(std::move_if_noexcept(values_[i]));
+            }
+        };
+
+        // The copies which may throw go first, before anything is moved from.
+        if (std::is_nothrow_move_constructible<key_type>::value) {
+            fill_values();
+            fill_keys();
+
+        } else {
+            fill_keys();
+            fill_values();
+        }
+
+        spilled_.replace(std::move(keys), std::move(values));
+        keys_.clear();
+        values_.clear();
+    }
+
+    template<class K, class... Args>
+    std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args) {
+        if (is_inline()) {
+            const size_type i = find_index(key);
+
+            if (i != keys_.size()) {
+                return {make_iterator(i), false};
+            }
+
+            if CIEL_LIKELY (i != N) {
+                keys_.unchecked_emplace_back(std::forward<K>(key));
+
+                CIEL_TRY {
+                    values_.unchecked_emplace_back(std::forward<Args>(args)...);
+                }
+                CIEL_CATCH (...) {
+                    keys_.pop_back();
+                    CIEL_THROW;
+                }
+
+                return {make_iterator(i), true};
+            }
+
+            spill();
+        }
+
+        return spilled_.try_emplace(std::forward<K>(key), std::forward<Args>(args)...);
+    }
+
+    template<class K, class M>
+    std::pair<iterator, bool> insert_or_assign_impl(K&& key, M&& obj) {
+        auto res = try_emplace_impl(std::forward<K>(key), std::forward<M>(obj));
+
+        if (!res.second) {
+            res.first->second = std::forward<M>(obj);
+        }
+
+        return res;
+    }
+
+public:
+    small_flat_map() = default;
+
+    explicit small_flat_map(const key_compare& comp)
+        : spilled_(comp) {}
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    small_flat_map(Iter first, Iter last, const key_compare& comp = key_compare())
+        : small_flat_map(comp) {
+        insert(first, last);
+    }
+
+    small_flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : small_flat_map(ilist.begin(), ilist.end(), comp) {}
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return is_inline() ? make_iterator(0) : spilled_.begin();
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return is_inline() ? make_iterator(0) : spilled_.begin();
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return is_inline() ? make_iterator(keys_.size()) : spilled_.end();
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return is_inline() ? make_iterator(keys_.size()) : spilled_.end();
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return is_inline() ? keys_.size() : spilled_.size();
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return spilled_.max_size();
+    }
+
+    // Whether the elements are kept inside the object.
+    CIEL_NODISCARD bool is_inline() const noexcept {
+        return spilled_.empty();
+    }
+
+    CIEL_NODISCARD static constexpr size_type inline_capacity() noexcept {
+        return N;
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace_impl(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace_impl(std::move(key)).first->second;
+    }
+
+    CIEL_NODISCARD mapped_type& at(const key_type& key) {
+        const iterator it = find(key);
+
+        if CIEL_UNLIKELY (it == end()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("key is not found in ciel::small_flat_map"));
+        }
+
+        return it->second;
+    }
+
+    CIEL_NODISCARD const mapped_type& at(const key_type& key) const {
+        const const_iterator it = find(key);
+
+        if CIEL_UNLIKELY (it == end()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("key is not found in ciel::small_flat_map"));
+        }
+
+        return it->second;
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        value_type value(std::forward<Args>(args)...);
+
+        return try_emplace_impl(std::move(value.first), std::move(value.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace_impl(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace_impl(std::move(value.first), std::move(value.second));
+    }
+
+    template<class Iter, enable_if_t<is_input_iterator<Iter>::value> = 0>
+    void insert(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        return insert_or_assign_impl(key, std::forward<M>(obj));
+    }
+
+    template<class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        return insert_or_assign_impl(std::move(key), std::forward<M>(obj));
+    }
+
+    // While inline, the last element is moved into pos, which is returned as the next one to visit.
+    iterator erase(const_iterator pos) {
+        if (is_inline()) {
+            CIEL_ASSERT(keys_.data() <= pos.key() && pos.key() < keys_.data() + keys_.size());
+
+            const size_type i    = static_cast<size_type>(pos.key() - keys_.data());
+            const size_type last = keys_.size() - 1;
+
+            if (i != last) {
+                keys_[i]   = std::move(keys_[last]);
+                values_[i] = std::move(values_[last]);
+            }
+
+            keys_.pop_back();
+            values_.pop_back();
+
+            return make_iterator(i);
+        }
+
+        const iterator res = spilled_.erase(pos);
+
+        return spilled_.empty() ? end() : res;
+    }
+
+    size_type erase(const key_type& key) {
+        const iterator it = find(key);
+
+        if (it == end()) {
+            return 0;
+        }
+
+        erase(it);
+        return 1;
+    }
+
+    // Swapping inline elements moves them when they aren't trivially relocatable.
+    void swap(small_flat_map& other) noexcept(noexcept(keys_.swap(other.keys_))
+                                              && noexcept(values_.swap(other.values_))) {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        spilled_.swap(other.spilled_);
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+        spilled_.clear();
+    }
+
+    CIEL_NODISCARD key_compare key_comp() const {
+        return comp_();
+    }
+
+    CIEL_NODISCARD iterator find(const key_type& key) {
+        return is_inline() ? make_iterator(find_index(key)) : spilled_.find(key);
+    }
+
+    CIEL_NODISCARD const_iterator find(const key_type& key) const {
+        return is_inline() ? make_iterator(find_index(key)) : spilled_.find(key);
+    }
+
+    CIEL_NODISCARD size_type count(const key_type& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    CIEL_NODISCARD bool contains(const key_type& key) const {
+        return is_inline() ? find_index(key) != keys_.size() : spilled_.contains(key);
+    }
+
+}; // class small_flat_map
+
+template<class Key, class T, size_t N, class Compare>
+struct is_trivially_relocatable<small_flat_map<Key, T, N, Compare>>
+    : conjunction<is_trivially_relocatable<inplace_vector<Key, N>>, is_trivially_relocatable<inplace_vector<T, N>>,
+                  is_trivially_relocatable<vector<Key>>, is_trivially_relocatable<vector<T>>,
+                  is_trivially_relocatable<Compare>> {};
+
+template<class Key, class T, size_t N, class Compare, class Pred>
+size_t erase_if(small_flat_map<Key, T, N, Compare>& c, Pred pred) {
+    const size_t old_size = c.size();
+
+    for (auto it = c.begin(); it != c.end();) {
+        if (pred(*it)) {
+            it = c.erase(it);
+
+        } else {
+            ++it;
+        }
+    }
+
+    return old_size - c.size();
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Key, class T, size_t N, class Compare>
+void swap(ciel::small_flat_map<Key, T, N, Compare>& lhs,
+          ciel::small_flat_map<Key, T, N, Compare>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_SMALL_FLAT_MAP_HPP_
@@ -0,0 +1,703 @@
+#ifndef CIELLAB_INCLUDE_CIEL_SOA_VECTOR_HPP_
+#define CIELLAB_INCLUDE_CIEL_SOA_VECTOR_HPP_
+
+#include <ciel/compare.hpp>
+#include <ciel/core/aligned_storage.hpp>
+#include <ciel/core/alignment.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/do_if_noexcept.hpp>
+#include <ciel/core/exchange.hpp>
+#include <ciel/core/integer_sequence.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/iterator_base.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/span.hpp>
+#include <ciel/growth_policy.hpp>
+#include <ciel/relocate.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CIEL_BEGIN
+
+// soa_vector
+// A structure of arrays: soa_vector<Ts...> keeps the i-th fields of all elements in one contiguous column,
+// so iterating over a single field only touches that field's memory. All columns share one allocation.
+// column<I>() exposes a column as a span, and the iterators yield tuples of references.
+// Like ciel::vector, trivially relocatable columns are grown with memcpy.
+
+namespace detail {
+
+template<class... Ts>
+struct soa_max_alignment;
+
+template<class T>
+struct soa_max_alignment<T> : std::integral_constant<size_t, alignof(T)> {};
+
+template<class T, class... Ts>
+struct soa_max_alignment<T, Ts...>
+    : std::integral_constant<size_t, (alignof(T) > soa_max_alignment<Ts...>::value)
+                                         ? alignof(T)
+                                         : soa_max_alignment<Ts...>::value> {};
+
+// Evaluate the expressions of a pack expansion in order, which is guaranteed by braced initialization.
+struct soa_expand {
+    template<class... Args>
+    soa_expand(Args&&...) noexcept {}
+};
+
+} // namespace detail
+
+template<bool Const, class... Ts>
+class soa_vector_iterator : public random_access_iterator_base<soa_vector_iterator<Const, Ts...>> {
+public:
+    using difference_type   = ptrdiff_t;
+    using value_type        = std::tuple<Ts...>;
+    using pointer           = void;
+    using reference         = conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+    using iterator_category = std::random_access_iterator_tag;
+
+private:
+    std::tuple<Ts*...> columns_;
+    size_t index_{0};
+
+    template<size_t... I>
+    CIEL_NODISCARD reference get(const size_t i, index_sequence<I...>) const noexcept {
+        return reference(std::get<I>(columns_)[i]...);
+    }
+
+public:
+    soa_vector_iterator() = default;
+
+    soa_vector_iterator(const std::tuple<Ts*...>& columns, const size_t index) noexcept
+        : columns_(columns), index_(index) {}
+
+    template<bool C, enable_if_t<Const && !C> = 0>
+    soa_vector_iterator(const soa_vector_iterator<C, Ts...>& other) noexcept
+        : columns_(other.columns()), index_(other.index()) {}
+
+    void go_next() noexcept {
+        ++index_;
+    }
+
+    void go_prev() noexcept {
+        --index_;
+    }
+
+    void advance(const difference_type n) noexcept {
+        index_ += n;
+    }
+
+    CIEL_NODISCARD reference operator*() const noexcept {
+        return get(index_, index_sequence_for<Ts...>{});
+    }
+
+    CIEL_NODISCARD reference operator[](const difference_type n) const noexcept {
+        return get(index_ + n, index_sequence_for<Ts...>{});
+    }
+
+    CIEL_NODISCARD const std::tuple<Ts*...>& columns() const noexcept {
+        return columns_;
+    }
+
+    CIEL_NODISCARD size_t index() const noexcept {
+        return index_;
+    }
+
+    CIEL_NODISCARD friend bool operator==(const soa_vector_iterator& lhs, const soa_vector_iterator& rhs) noexcept {
+        return lhs.index() == rhs.index();
+    }
+
+    CIEL_NODISCARD friend bool operator<(const soa_vector_iterator& lhs, const soa_vector_iterator& rhs) noexcept {
+        return lhs.index() < rhs.index();
+    }
+
+    CIEL_NODISCARD friend soa_vector_iterator operator+(soa_vector_iterator iter, const difference_type n) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend soa_vector_iterator operator+(const difference_type n, soa_vector_iterator iter) noexcept {
+        iter += n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend soa_vector_iterator operator-(soa_vector_iterator iter, const difference_type n) noexcept {
+        iter -= n;
+        return iter;
+    }
+
+    CIEL_NODISCARD friend difference_type operator-(const soa_vector_iterator& lhs,
+                                                    const soa_vector_iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index() - rhs.index());
+    }
+
+}; // class soa_vector_iterator
+
+template<class... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) != 0, "");
+
+public:
+    using value_type             = std::tuple<Ts...>;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = std::tuple<Ts&...>;
+    using const_reference        = std::tuple<const Ts&...>;
+    using iterator               = soa_vector_iterator<false, Ts...>;
+    using const_iterator         = soa_vector_iterator<true, Ts...>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template<size_t I>
+    using column_type = typename std::tuple_element<I, value_type>::type;
+
+private:
+    using columns_type = std::tuple<Ts*...>;
+    using indices      = index_sequence_for<Ts...>;
+
+    template<size_t I>
+    using index_constant = std::integral_constant<size_t, I>;
+
+    // Each column starts at a multiple of the largest alignment.
+    static constexpr size_t alignment = detail::soa_max_alignment<Ts...>::value;
+    using block_type                  = typename aligned_storage<alignment, alignment>::type;
+
+    // A column may be grown without throwing, so it's relocated after all the others succeed.
+    template<class T>
+    using nothrow_relocatable = bool_constant<is_trivially_relocatable<T>::value
+                                              || std::is_nothrow_move_constructible<T>::value>;
+
+    columns_type columns_;
+    size_type size_{0};
+    size_type capacity_{0};
+
+    CIEL_NODISCARD static size_type column_bytes(const size_type cap, const size_t value_size) noexcept {
+        return ciel::align_up(cap * value_size, alignment);
+    }
+
+    // Byte offset of each column, and the total bytes at the end.
+    static void column_offsets(const size_type cap, size_type (&offsets)[sizeof...(Ts) + 1]) noexcept {
+        constexpr size_t sizes[] = {sizeof(Ts)...};
+
+        offsets[0] = 0;
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            offsets[i + 1] = offsets[i] + column_bytes(cap, sizes[i]);
+        }
+    }
+
+    CIEL_NODISCARD static size_type block_count(const size_type cap) noexcept {
+        size_type offsets[sizeof...(Ts) + 1];
+        column_offsets(cap, offsets);
+
+        return offsets[sizeof...(Ts)] / sizeof(block_type);
+    }
+
+    template<size_t... I>
+    CIEL_NODISCARD static columns_type allocate(const size_type cap, index_sequence<I...>) {
+        CIEL_ASSERT(cap != 0);
+
+        size_type offsets[sizeof...(Ts) + 1];
+        column_offsets(cap, offsets);
+
+        auto* p = reinterpret_cast<unsigned char*>(
+            std::allocator<block_type>().allocate(offsets[sizeof...(Ts)] / sizeof(block_type)));
+
+        return columns_type(reinterpret_cast<Ts*>(p + offsets[I])...);
+    }
+
+    static void deallocate(const columns_type& columns, const size_type cap) noexcept {
+        if (cap != 0) {
+            std::allocator<block_type>().deallocate(reinterpret_cast<block_type*>(std::get<0>(columns)),
+                                                    block_count(cap));
+        }
+    }
+
+    template<class T>
+    static void destroy_range(T* first, T* last) noexcept {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+    }
+
+    template<size_t... I>
+    void destroy(const size_type first, const size_type last, index_sequence<I...>) noexcept {
+        detail::soa_expand{(destroy_range(std::get<I>(columns_) + first, std::get<I>(columns_) + last), 0)...};
+    }
+
+    template<size_t I, class Tuple>
+    static void construct_field(column_type<I>* p, Tuple& args, std::false_type /* empty */) {
+        using U = typename std::tuple_element<I, Tuple>::type;
+
+        ::new (static_cast<void*>(p)) column_type<I>(std::forward<U>(std::get<I>(args)));
+    }
+
+    template<size_t I, class Tuple>
+    static void construct_field(column_type<I>* p, Tuple&, std::true_type /* empty */) {
+        ::new (static_cast<void*>(p)) column_type<I>();
+    }
+
+    // Construct the I-th and later fields of the element at index from args, or value-initialize them
+    // if args is empty. The constructed fields are destroyed if a later one throws.
+    template<class Tuple>
+    static void construct_fields(const columns_type&, size_type, Tuple&, index_constant<sizeof...(Ts)>) noexcept {}
+
+    template<class Tuple, size_t I>
+    static void construct_fields(const columns_type& columns, const size_type index, Tuple& args, index_constant<I>) {
+        using T = column_type<I>;
+
+        T* const p = std::get<I>(columns) + index;
+        construct_field<I>(p, args, bool_constant<std::tuple_size<Tuple>::value == 0>{});
+
+        CIEL_TRY {
+            construct_fields(columns, index, args, index_constant<I + 1>{});
+        }
+        CIEL_CATCH (...) {
+            p->~T();
+            CIEL_THROW;
+        }
+    }
+
+    // Relocate [0, size_) of the I-th and later columns whose nothrow_relocatable equals Nothrow to new_columns.
+    // The old elements are left intact, so the columns relocated so far can be dropped if a later one throws.
+    template<bool Nothrow>
+    void relocate_columns(const columns_type&, bool_constant<Nothrow>, index_constant<sizeof...(Ts)>) noexcept {}
+
+    template<bool Nothrow, size_t I>
+    void relocate_columns(const columns_type& new_columns, bool_constant<Nothrow> pass, index_constant<I>) {
+        using T = column_type<I>;
+
+        if (nothrow_relocatable<T>::value != Nothrow) {
+            relocate_columns(new_columns, pass, index_constant<I + 1>{});
+            return;
+        }
+
+        T* const dst = std::get<I>(new_columns);
+        T* const src = std::get<I>(columns_);
+
+        if (is_trivially_relocatable<T>::value) {
+            ciel::uninitialized_relocate_n(src, size_, dst);
+
+            relocate_columns(new_columns, pass, index_constant<I + 1>{});
+            return;
+        }
+
+        size_type i = 0;
+
+        CIEL_TRY {
+            for (; i < size_; ++i) {
+                ::new (static_cast<void*>(dst + i)) T(ciel::move_if_noexcept(src[i]));
+            }
+
+            relocate_columns(new_columns, pass, index_constant<I + 1>{});
+        }
+        CIEL_CATCH (...) {
+            destroy_range(dst, dst + i);
+            CIEL_THROW;
+        }
+    }
+
+    // The old elements which were not memcpy'd are moved from or copied, destroy them.
+    template<size_t... I>
+    void destroy_relocated(index_sequence<I...>) noexcept {
+        detail::soa_expand{(destroy_range(std::get<I>(columns_),
+                                          std::get<I>(columns_) + (is_trivially_relocatable<Ts>::value ? 0 : size_)),
+                            0)...};
+    }
+
+    // The columns that may throw are copied first, so that the strong exception guarantee holds.
+    void relocate_to(const columns_type& new_columns, const size_type new_cap) {
+        relocate_columns(new_columns, std::false_type{}, index_constant<0>{});
+        relocate_columns(new_columns, std::true_type{}, index_constant<0>{});
+
+        destroy_relocated(indices{});
+        deallocate(columns_, capacity_);
+
+        columns_  = new_columns;
+        capacity_ = new_cap;
+    }
+
+    void reallocate(const size_type new_cap) {
+        CIEL_ASSERT(new_cap >= size_);
+        CIEL_ASSERT(new_cap != 0);
+
+        const columns_type new_columns = allocate(new_cap, indices{});
+
+        CIEL_TRY {
+            relocate_to(new_columns, new_cap);
+        }
+        CIEL_CATCH (...) {
+            deallocate(new_columns, new_cap);
+            CIEL_THROW;
+        }
+    }
+
+    CIEL_NODISCARD size_type recommend_cap(const size_type new_size) const {
+        const size_type ms = max_size();
+
+        if CIEL_UNLIKELY (new_size > ms) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::soa_vector expanding size is beyond max_size"));
+        }
+
+        return growth_policy_2x::recommend(capacity_, new_size, ms, 0);
+    }
+
+    template<class Tuple>
+    void emplace_back_tuple(Tuple args) {
+        if (size_ == capacity_) {
+            // args may refer to the old elements, so construct the new element first.
+            const size_type new_cap        = recommend_cap(size_ + 1);
+            const columns_type new_columns = allocate(new_cap, indices{});
+
+            CIEL_TRY {
+                construct_fields(new_columns, size_, args, index_constant<0>{});
+
+                CIEL_TRY {
+                    relocate_to(new_columns, new_cap);
+                }
+                CIEL_CATCH (...) {
+                    destroy_element(new_columns, size_, indices{});
+                    CIEL_THROW;
+                }
+            }
+            CIEL_CATCH (...) {
+                deallocate(new_columns, new_cap);
+                CIEL_THROW;
+            }
+
+        } else {
+            construct_fields(columns_, size_, args, index_constant<0>{});
+        }
+
+        ++size_;
+    }
+
+    template<size_t... I>
+    static void destroy_element(const columns_type& columns, const size_type index, index_sequence<I...>) noexcept {
+        detail::soa_expand{(destroy_range(std::get<I>(columns) + index, std::get<I>(columns) + index + 1), 0)...};
+    }
+
+    template<size_t... I>
+    CIEL_NODISCARD reference get(const size_type pos, index_sequence<I...>) noexcept {
+        return reference(std::get<I>(columns_)[pos]...);
+    }
+
+    template<size_t... I>
+    CIEL_NODISCARD const_reference get(const size_type pos, index_sequence<I...>) const noexcept {
+        return const_reference(std::get<I>(columns_)[pos]...);
+    }
+
+    template<size_t... I>
+    void copy_from(const soa_vector& other, index_sequence<I...>) {
+        for (size_type i = 0; i < other.size(); ++i) {
+            emplace_back(std::get<I>(other.columns_)[i]...);
+        }
+    }
+
+public:
+    soa_vector() = default;
+
+    explicit soa_vector(const size_type count)
+        : soa_vector() {
+        resize(count);
+    }
+
+    soa_vector(const soa_vector& other)
+        : soa_vector() {
+        reserve(other.size());
+        copy_from(other, indices{});
+    }
+
+    soa_vector(soa_vector&& other) noexcept
+        : columns_(ciel::exchange(other.columns_, columns_type{})),
+          size_(ciel::exchange(other.size_, 0)),
+          capacity_(ciel::exchange(other.capacity_, 0)) {}
+
+    ~soa_vector() {
+        clear();
+        deallocate(columns_, capacity_);
+    }
+
+    soa_vector& operator=(const soa_vector& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        clear();
+        reserve(other.size());
+        copy_from(other, indices{});
+
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& other) noexcept {
+        soa_vector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    // column<I>() returns all the I-th fields.
+    template<size_t I>
+    CIEL_NODISCARD span<column_type<I>> column() noexcept {
+        return {std::get<I>(columns_), size_};
+    }
+
+    template<size_t I>
+    CIEL_NODISCARD span<const column_type<I>> column() const noexcept {
+        return {std::get<I>(columns_), size_};
+    }
+
+    template<size_t I>
+    CIEL_NODISCARD column_type<I>* data() noexcept {
+        return std::get<I>(columns_);
+    }
+
+    template<size_t I>
+    CIEL_NODISCARD const column_type<I>* data() const noexcept {
+        return std::get<I>(columns_);
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::soa_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::soa_vector"));
+        }
+
+        return (*this)[pos];
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) noexcept {
+        CIEL_ASSERT(pos < size());
+
+        return get(pos, indices{});
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const noexcept {
+        CIEL_ASSERT(pos < size());
+
+        return get(pos, indices{});
+    }
+
+    CIEL_NODISCARD reference front() noexcept {
+        CIEL_ASSERT(!empty());
+
+        return get(0, indices{});
+    }
+
+    CIEL_NODISCARD const_reference front() const noexcept {
+        CIEL_ASSERT(!empty());
+
+        return get(0, indices{});
+    }
+
+    CIEL_NODISCARD reference back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        return get(size_ - 1, indices{});
+    }
+
+    CIEL_NODISCARD const_reference back() const noexcept {
+        CIEL_ASSERT(!empty());
+
+        return get(size_ - 1, indices{});
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return {columns_, 0};
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return {columns_, 0};
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return {columns_, size_};
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return {columns_, size_};
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return size_;
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        constexpr size_t sizes[] = {sizeof(Ts)...};
+
+        size_type bytes_per_element = 0;
+        for (const size_t sz : sizes) {
+            bytes_per_element += sz;
+        }
+
+        return (std::numeric_limits<difference_type>::max() - alignment * sizeof...(Ts)) / bytes_per_element;
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    void reserve(const size_type new_cap) {
+        if (new_cap <= capacity_) {
+            return;
+        }
+
+        if CIEL_UNLIKELY (new_cap > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error{"ciel::soa_vector::reserve capacity beyond max_size"});
+        }
+
+        reallocate(new_cap);
+    }
+
+    void shrink_to_fit() {
+        if (size_ == capacity_) {
+            return;
+        }
+
+        if (size_ == 0) {
+            deallocate(columns_, capacity_);
+            columns_  = columns_type{};
+            capacity_ = 0;
+            return;
+        }
+
+        CIEL_TRY {
+            reallocate(size_);
+        }
+        CIEL_CATCH (...) {}
+    }
+
+    void clear() noexcept {
+        destroy(0, size_, indices{});
+        size_ = 0;
+    }
+
+    // Construct each field from the corresponding argument, or value-initialize all of them.
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == 0 || sizeof...(Args) == sizeof...(Ts),
+                      "ciel::soa_vector::emplace_back takes one argument for each field");
+
+        emplace_back_tuple(std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    void push_back(const value_type& value) {
+        push_back_impl(value, indices{});
+    }
+
+    void push_back(value_type&& value) {
+        push_back_impl(std::move(value), indices{});
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        --size_;
+        destroy(size_, size_ + 1, indices{});
+    }
+
+    void resize(const size_type count) {
+        if (count <= size_) {
+            destroy(count, size_, indices{});
+            size_ = count;
+            return;
+        }
+
+        reserve(count);
+
+        while (size_ < count) {
+            emplace_back();
+        }
+    }
+
+    void swap(soa_vector& other) noexcept {
+        using std::swap;
+
+        swap(columns_, other.columns_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+    }
+
+private:
+    template<size_t... I>
+    void push_back_impl(const value_type& value, index_sequence<I...>) {
+        emplace_back(std::get<I>(value)...);
+    }
+
+    template<size_t... I>
+    void push_back_impl(value_type&& value, index_sequence<I...>) {
+        emplace_back(std::get<I>(std::move(value))...);
+    }
+
+}; // class soa_vector
+
+template<class... Ts>
+constexpr size_t soa_vector<Ts...>::alignment;
+
+template<class... Ts>
+struct is_trivially_relocatable<soa_vector<Ts...>> : std::true_type {};
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class... Ts>
+void swap(ciel::soa_vector<Ts...>& lhs, ciel::soa_vector<Ts...>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_SOA_VECTOR_HPP_
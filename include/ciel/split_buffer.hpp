@@ -14,9 +14,15 @@ NAMESPACE_CIEL_BEGIN
 
 // Inspired by LLVM libc++'s implementation.
 
-template<class, class>
+template<class, class, class>
 class vector;
 
+template<class, class, class>
+class compact_vector;
+
+template<class, size_t, class, class>
+class small_vector;
+
 template<class T, class Allocator>
 class split_buffer {
     static_assert(std::is_lvalue_reference<Allocator>::value,
@@ -41,7 +47,14 @@ private:
     pointer end_cap_{nullptr};
     Allocator allocator_;
 
-    friend class vector<value_type, allocator_type>;
+    template<class, class, class>
+    friend class vector;
+
+    template<class, class, class>
+    friend class compact_vector;
+
+    template<class, size_t, class, class>
+    friend class small_vector;
 
     template<class... Args>
     void construct(pointer p, Args&&... args) {
@@ -0,0 +1,801 @@
+#ifndef CIELLAB_INCLUDE_CIEL_STRING_HPP_
+#define CIELLAB_INCLUDE_CIEL_STRING_HPP_
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/compare.hpp>
+#include <ciel/core/compressed_pair.hpp>
+#include <ciel/core/config.hpp>
+#include <ciel/core/cstring.hpp>
+#include <ciel/core/hash_bytes.hpp>
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/core/message.hpp>
+#include <ciel/core/to_chars.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if CIEL_STD_VER >= 17
+#  include <string_view>
+#endif
+
+NAMESPACE_CIEL_BEGIN
+
+// basic_string is a string of chars with small string optimization, which, unlike libstdc++'s std::string,
+// never points into itself, so that it's trivially relocatable and ciel::vector<ciel::string> grows with memcpy.
+//
+// Similar to libc++'s layout, it's three words:
+// a long string is {data, size, capacity}, a short string is up to sizeof(void*) * 3 - 1 chars in place,
+// followed by a byte of the remaining capacity, which is also the terminator of a full short string.
+// That last byte overlaps the capacity of a long string, whose highest bit is set to tell them apart.
+
+template<class Allocator = std::allocator<char>>
+class basic_string {
+    static_assert(std::is_same<typename Allocator::value_type, char>::value, "");
+    static_assert(std::is_same<typename std::allocator_traits<Allocator>::pointer, char*>::value,
+                  "ciel::basic_string doesn't support fancy pointers");
+
+public:
+    using traits_type            = std::char_traits<char>;
+    using value_type             = char;
+    using allocator_type         = Allocator;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = char&;
+    using const_reference        = const char&;
+    using pointer                = char*;
+    using const_pointer          = const char*;
+    using iterator               = char*;
+    using const_iterator         = const char*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    struct long_rep {
+        char* data;
+        size_type size;
+        size_type cap; // Encoded by encode_cap.
+
+    }; // struct long_rep
+
+    static constexpr size_type short_capacity = sizeof(long_rep) - 1;
+
+    struct short_rep {
+        char data[short_capacity];
+        unsigned char remaining;
+
+    }; // struct short_rep
+
+    union rep {
+        long_rep l;
+        short_rep s;
+
+    }; // union rep
+
+    static_assert(sizeof(short_rep) == sizeof(long_rep), "");
+
+    compressed_pair<rep, allocator_type> rep_alloc_{default_init, default_init};
+
+    rep& rep_() noexcept {
+        return rep_alloc_.first();
+    }
+
+    const rep& rep_() const noexcept {
+        return rep_alloc_.first();
+    }
+
+    allocator_type& allocator_() noexcept {
+        return rep_alloc_.second();
+    }
+
+    const allocator_type& allocator_() const noexcept {
+        return rep_alloc_.second();
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // The last byte is the lowest one of cap.
+    static constexpr size_type long_flag = 0x80;
+
+    CIEL_NODISCARD static size_type encode_cap(const size_type cap) noexcept {
+        return (cap << 8) | long_flag;
+    }
+
+    CIEL_NODISCARD static size_type decode_cap(const size_type cap) noexcept {
+        return cap >> 8;
+    }
+#else
+    // The last byte is the highest one of cap.
+    static constexpr size_type long_flag = static_cast<size_type>(1) << (std::numeric_limits<size_type>::digits - 1);
+
+    CIEL_NODISCARD static size_type encode_cap(const size_type cap) noexcept {
+        return cap | long_flag;
+    }
+
+    CIEL_NODISCARD static size_type decode_cap(const size_type cap) noexcept {
+        return cap & ~long_flag;
+    }
+#endif
+
+    CIEL_NODISCARD bool is_long() const noexcept {
+        return (reinterpret_cast<const unsigned char*>(&rep_())[sizeof(rep) - 1] & 0x80) != 0;
+    }
+
+    void set_short_empty() noexcept {
+        rep_().s.data[0]   = '\0';
+        rep_().s.remaining = static_cast<unsigned char>(short_capacity);
+    }
+
+    void set_size(const size_type count) noexcept {
+        CIEL_ASSERT(count <= capacity());
+
+        if (is_long()) {
+            rep_().l.size        = count;
+            rep_().l.data[count] = '\0';
+
+        } else {
+            if (count != short_capacity) {
+                rep_().s.data[count] = '\0';
+            }
+
+            rep_().s.remaining = static_cast<unsigned char>(short_capacity - count);
+        }
+    }
+
+    void deallocate() noexcept {
+        if (is_long()) {
+            alloc_traits::deallocate(allocator_(), rep_().l.data, decode_cap(rep_().l.cap) + 1);
+            set_short_empty();
+        }
+    }
+
+    // Move the chars into a buffer of at least new_cap chars, and append [s, s + count) to them.
+    // s may point into this string.
+    void reallocate(const size_type new_cap, const char* s = nullptr, const size_type count = 0) {
+        const size_type old_size = size();
+
+        CIEL_ASSERT(new_cap >= old_size + count);
+
+        if CIEL_UNLIKELY (new_cap > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::basic_string exceeds its max_size"));
+        }
+
+        if (new_cap <= short_capacity) {
+            CIEL_ASSERT(count == 0);
+
+            if (is_long()) {
+                const long_rep old = rep_().l;
+
+                ciel::memcpy(rep_().s.data, old.data, old_size);
+                rep_().s.remaining = static_cast<unsigned char>(short_capacity);
+                set_size(old_size);
+
+                alloc_traits::deallocate(allocator_(), old.data, decode_cap(old.cap) + 1);
+            }
+
+            return;
+        }
+
+        const auto allocation_res = ciel::allocate_at_least(allocator_(), new_cap + 1);
+
+        ciel::memcpy(allocation_res.ptr, data(), old_size);
+        if (count != 0) {
+            ciel::memcpy(allocation_res.ptr + old_size, s, count);
+        }
+
+        deallocate();
+
+        // Written through the long rep directly, set_size can't be proven to take its long branch.
+        long_rep& l    = rep_().l;
+        l.data         = allocation_res.ptr;
+        l.size         = old_size + count;
+        l.cap          = encode_cap(ciel::min<size_type>(allocation_res.count - 1, max_size()));
+        l.data[l.size] = '\0';
+    }
+
+    CIEL_NODISCARD size_type recommend_cap(const size_type new_size) const {
+        if CIEL_UNLIKELY (new_size > max_size()) {
+            CIEL_THROW_EXCEPTION(std::length_error("ciel::basic_string exceeds its max_size"));
+        }
+
+        const size_type cap = capacity();
+
+        if CIEL_UNLIKELY (cap >= max_size() / 2) {
+            return max_size();
+        }
+
+        return ciel::max(cap * 2, new_size);
+    }
+
+    // Make room for count more chars, return where they go.
+    char* grow_by(const size_type count) {
+        const size_type old_size = size();
+
+        if CIEL_UNLIKELY (count > capacity() - old_size) {
+            reallocate(recommend_cap(old_size + count));
+        }
+
+        return data() + old_size;
+    }
+
+    // The short rep has at most one char left, or the long one is full.
+    void push_back_slow(const char c) {
+        const size_type old_size = size();
+
+        if (!is_long() && old_size < short_capacity) {
+            // The last char, remaining becomes the null terminator.
+            rep_().s.data[old_size] = c;
+            rep_().s.remaining      = 0;
+            return;
+        }
+
+        reallocate(recommend_cap(old_size + 1));
+
+        long_rep& l          = rep_().l;
+        l.data[old_size]     = c;
+        l.data[old_size + 1] = '\0';
+        l.size               = old_size + 1;
+    }
+
+    void copy_assign_alloc(const basic_string& other, std::true_type) {
+        if (allocator_() != other.allocator_()) {
+            deallocate();
+        }
+
+        allocator_() = other.allocator_();
+    }
+
+    void copy_assign_alloc(const basic_string&, std::false_type) noexcept {}
+
+    void move_assign_alloc(basic_string& other, std::true_type) noexcept {
+        allocator_() = std::move(other.allocator_());
+    }
+
+    void move_assign_alloc(basic_string&, std::false_type) noexcept {}
+
+    void swap_alloc(basic_string& other, std::true_type) noexcept {
+        using std::swap;
+        swap(allocator_(), other.allocator_());
+    }
+
+    void swap_alloc(basic_string&, std::false_type) noexcept {}
+
+public:
+    basic_string() noexcept(noexcept(allocator_type())) {
+        set_short_empty();
+    }
+
+    explicit basic_string(const allocator_type& alloc) noexcept
+        : rep_alloc_(default_init, alloc) {
+        set_short_empty();
+    }
+
+    basic_string(const char* s, const size_type count, const allocator_type& alloc = allocator_type())
+        : basic_string(alloc) {
+        append(s, count);
+    }
+
+    basic_string(const char* s, const allocator_type& alloc = allocator_type())
+        : basic_string(s, traits_type::length(s), alloc) {}
+
+    basic_string(const size_type count, const char c, const allocator_type& alloc = allocator_type())
+        : basic_string(alloc) {
+        append(count, c);
+    }
+
+    explicit basic_string(const std::string& s, const allocator_type& alloc = allocator_type())
+        : basic_string(s.data(), s.size(), alloc) {}
+
+#if CIEL_STD_VER >= 17
+    explicit basic_string(const std::string_view sv, const allocator_type& alloc = allocator_type())
+        : basic_string(sv.data(), sv.size(), alloc) {}
+#endif
+
+    basic_string(std::initializer_list<char> ilist, const allocator_type& alloc = allocator_type())
+        : basic_string(ilist.begin(), ilist.size(), alloc) {}
+
+    basic_string(const basic_string& other)
+        : basic_string(other.data(), other.size(),
+                       alloc_traits::select_on_container_copy_construction(other.get_allocator())) {}
+
+    basic_string(const basic_string& other, const allocator_type& alloc)
+        : basic_string(other.data(), other.size(), alloc) {}
+
+    basic_string(basic_string&& other) noexcept
+        : rep_alloc_(other.rep_(), std::move(other.allocator_())) {
+        other.set_short_empty();
+    }
+
+    ~basic_string() {
+        deallocate();
+    }
+
+    basic_string& operator=(const basic_string& other) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        copy_assign_alloc(other, typename alloc_traits::propagate_on_container_copy_assignment{});
+        return assign(other.data(), other.size());
+    }
+
+    basic_string& operator=(basic_string&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if CIEL_UNLIKELY (this == std::addressof(other)) {
+            return *this;
+        }
+
+        if (alloc_traits::propagate_on_container_move_assignment::value || allocator_() == other.allocator_()) {
+            deallocate();
+            move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment{});
+
+            rep_() = other.rep_();
+            other.set_short_empty();
+
+        } else {
+            assign(other.data(), other.size());
+        }
+
+        return *this;
+    }
+
+    basic_string& operator=(const char* s) {
+        return assign(s);
+    }
+
+    basic_string& assign(const char* s, const size_type count) {
+        if (count > capacity()) {
+            clear();
+            reallocate(recommend_cap(count));
+        }
+
+        if (count != 0) {
+            ciel::memmove(data(), s, count);
+        }
+
+        set_size(count);
+        return *this;
+    }
+
+    basic_string& assign(const char* s) {
+        return assign(s, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD allocator_type get_allocator() const noexcept {
+        return allocator_();
+    }
+
+    CIEL_NODISCARD reference at(const size_type pos) {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::basic_string"));
+        }
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD const_reference at(const size_type pos) const {
+        if CIEL_UNLIKELY (pos >= size()) {
+            CIEL_THROW_EXCEPTION(std::out_of_range("pos is not within the range of ciel::basic_string"));
+        }
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD reference operator[](const size_type pos) {
+        CIEL_ASSERT(pos <= size());
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD const_reference operator[](const size_type pos) const {
+        CIEL_ASSERT(pos <= size());
+
+        return data()[pos];
+    }
+
+    CIEL_NODISCARD reference front() {
+        CIEL_ASSERT(!empty());
+
+        return data()[0];
+    }
+
+    CIEL_NODISCARD const_reference front() const {
+        CIEL_ASSERT(!empty());
+
+        return data()[0];
+    }
+
+    CIEL_NODISCARD reference back() {
+        CIEL_ASSERT(!empty());
+
+        return data()[size() - 1];
+    }
+
+    CIEL_NODISCARD const_reference back() const {
+        CIEL_ASSERT(!empty());
+
+        return data()[size() - 1];
+    }
+
+    CIEL_NODISCARD char* data() noexcept {
+        return is_long() ? rep_().l.data : rep_().s.data;
+    }
+
+    CIEL_NODISCARD const char* data() const noexcept {
+        return is_long() ? rep_().l.data : rep_().s.data;
+    }
+
+    CIEL_NODISCARD const char* c_str() const noexcept {
+        return data();
+    }
+
+#if CIEL_STD_VER >= 17
+    CIEL_NODISCARD operator std::string_view() const noexcept {
+        return std::string_view(data(), size());
+    }
+#endif
+
+    CIEL_NODISCARD std::string str() const {
+        return std::string(data(), size());
+    }
+
+    CIEL_NODISCARD iterator begin() noexcept {
+        return data();
+    }
+
+    CIEL_NODISCARD const_iterator begin() const noexcept {
+        return data();
+    }
+
+    CIEL_NODISCARD const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    CIEL_NODISCARD iterator end() noexcept {
+        return data() + size();
+    }
+
+    CIEL_NODISCARD const_iterator end() const noexcept {
+        return data() + size();
+    }
+
+    CIEL_NODISCARD const_iterator cend() const noexcept {
+        return end();
+    }
+
+    CIEL_NODISCARD reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    CIEL_NODISCARD reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    CIEL_NODISCARD const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    CIEL_NODISCARD bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    CIEL_NODISCARD size_type size() const noexcept {
+        return is_long() ? rep_().l.size : short_capacity - rep_().s.remaining;
+    }
+
+    CIEL_NODISCARD size_type length() const noexcept {
+        return size();
+    }
+
+    CIEL_NODISCARD size_type max_size() const noexcept {
+        return ciel::min<size_type>(alloc_traits::max_size(allocator_()) - 1, decode_cap(npos));
+    }
+
+    CIEL_NODISCARD size_type capacity() const noexcept {
+        return is_long() ? decode_cap(rep_().l.cap) : short_capacity;
+    }
+
+    CIEL_NODISCARD static constexpr size_type inline_capacity() noexcept {
+        return short_capacity;
+    }
+
+    CIEL_NODISCARD bool is_inline() const noexcept {
+        return !is_long();
+    }
+
+    void reserve(const size_type new_cap) {
+        if (new_cap > capacity()) {
+            reallocate(new_cap);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (is_long() && capacity() > size()) {
+            reallocate(size());
+        }
+    }
+
+    void clear() noexcept {
+        set_size(0);
+    }
+
+    void push_back(const char c) {
+        if (is_long()) {
+            long_rep& l = rep_().l;
+
+            if CIEL_LIKELY (l.size != decode_cap(l.cap)) {
+                char* p = l.data + l.size;
+                ++l.size;
+                p[0] = c;
+                p[1] = '\0';
+                return;
+            }
+
+        } else {
+            short_rep& r = rep_().s;
+
+            if CIEL_LIKELY (r.remaining > 1) {
+                char* p = r.data + (short_capacity - r.remaining);
+                --r.remaining;
+                p[0] = c;
+                p[1] = '\0';
+                return;
+            }
+        }
+
+        push_back_slow(c);
+    }
+
+    void pop_back() noexcept {
+        CIEL_ASSERT(!empty());
+
+        set_size(size() - 1);
+    }
+
+    void resize(const size_type count, const char c = '\0') {
+        const size_type old_size = size();
+
+        if (count > old_size) {
+            append(count - old_size, c);
+
+        } else {
+            set_size(count);
+        }
+    }
+
+    basic_string& append(const char* s, const size_type count) {
+        if (count == 0) {
+            return *this;
+        }
+
+        const size_type old_size = size();
+
+        if CIEL_UNLIKELY (count > capacity() - old_size) {
+            reallocate(recommend_cap(old_size + count), s, count);
+            return *this;
+        }
+
+        ciel::memmove(data() + old_size, s, count);
+        set_size(old_size + count);
+        return *this;
+    }
+
+    basic_string& append(const char* s) {
+        return append(s, traits_type::length(s));
+    }
+
+    basic_string& append(const size_type count, const char c) {
+        std::memset(grow_by(count), c, count);
+        set_size(size() + count);
+        return *this;
+    }
+
+    basic_string& append(const basic_string& other) {
+        return append(other.data(), other.size());
+    }
+
+    basic_string& append(const std::string& s) {
+        return append(s.data(), s.size());
+    }
+
+#if CIEL_STD_VER >= 17
+    basic_string& append(const std::string_view sv) {
+        return append(sv.data(), sv.size());
+    }
+#endif
+
+    // Append the characters of ciel::to_chars(value).
+    template<class T, size_t Width = to_chars_width<T>::value, enable_if_t<Width != static_cast<size_t>(-1)> = 0>
+    basic_string& append_to_chars(const T value) {
+        const size_type old_size = size();
+
+        if CIEL_LIKELY (Width <= capacity() - old_size) {
+            char* last = ciel::to_chars(data() + old_size, value);
+            set_size(static_cast<size_type>(last - data()));
+            return *this;
+        }
+
+        char buffer[Width];
+        const char* last = ciel::to_chars(buffer, value);
+        return append(buffer, static_cast<size_type>(last - buffer));
+    }
+
+    basic_string& operator+=(const char c) {
+        push_back(c);
+        return *this;
+    }
+
+    basic_string& operator+=(const char* s) {
+        return append(s);
+    }
+
+    basic_string& operator+=(const basic_string& other) {
+        return append(other);
+    }
+
+    basic_string& operator+=(const std::string& s) {
+        return append(s);
+    }
+
+#if CIEL_STD_VER >= 17
+    basic_string& operator+=(const std::string_view sv) {
+        return append(sv);
+    }
+#endif
+
+    CIEL_NODISCARD int compare(const char* s, const size_type count) const noexcept {
+        const size_type lhs_size = size();
+        const int res            = traits_type::compare(data(), s, ciel::min(lhs_size, count));
+
+        if (res != 0) {
+            return res;
+        }
+
+        return lhs_size < count ? -1 : (lhs_size == count ? 0 : 1);
+    }
+
+    CIEL_NODISCARD int compare(const char* s) const noexcept {
+        return compare(s, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD int compare(const basic_string& other) const noexcept {
+        return compare(other.data(), other.size());
+    }
+
+    CIEL_NODISCARD size_type find(const char c, const size_type pos = 0) const noexcept {
+        if (pos >= size()) {
+            return npos;
+        }
+
+        const char* res = ciel::find(data() + pos, end(), c);
+        return res == nullptr ? npos : static_cast<size_type>(res - data());
+    }
+
+    CIEL_NODISCARD size_type find(const char* s, const size_type pos, const size_type count) const noexcept {
+        if (pos > size()) {
+            return npos;
+        }
+
+        const char* res = ciel::find(data() + pos, end(), s, s + count);
+        return res == nullptr ? npos : static_cast<size_type>(res - data());
+    }
+
+    CIEL_NODISCARD size_type find(const char* s, const size_type pos = 0) const noexcept {
+        return find(s, pos, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD bool starts_with(const char* s, const size_type count) const noexcept {
+        return count <= size() && traits_type::compare(data(), s, count) == 0;
+    }
+
+    CIEL_NODISCARD bool starts_with(const char* s) const noexcept {
+        return starts_with(s, traits_type::length(s));
+    }
+
+    CIEL_NODISCARD bool ends_with(const char* s, const size_type count) const noexcept {
+        return count <= size() && traits_type::compare(end() - count, s, count) == 0;
+    }
+
+    CIEL_NODISCARD bool ends_with(const char* s) const noexcept {
+        return ends_with(s, traits_type::length(s));
+    }
+
+    void swap(basic_string& other) noexcept {
+        CIEL_ASSERT(alloc_traits::propagate_on_container_swap::value || allocator_() == other.allocator_());
+
+        const rep tmp = rep_();
+        rep_()        = other.rep_();
+        other.rep_()  = tmp;
+
+        swap_alloc(other, typename alloc_traits::propagate_on_container_swap{});
+    }
+
+}; // class basic_string
+
+template<class Allocator>
+constexpr typename basic_string<Allocator>::size_type basic_string<Allocator>::npos;
+
+using string = basic_string<>;
+
+template<class Allocator>
+struct is_trivially_relocatable<basic_string<Allocator>> : is_trivially_relocatable<Allocator> {};
+
+template<class Allocator>
+CIEL_NODISCARD bool operator==(const basic_string<Allocator>& lhs, const basic_string<Allocator>& rhs) noexcept {
+    return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template<class Allocator>
+CIEL_NODISCARD bool operator==(const basic_string<Allocator>& lhs, const char* rhs) noexcept {
+    return lhs.compare(rhs) == 0;
+}
+
+template<class Allocator>
+CIEL_NODISCARD bool operator==(const char* lhs, const basic_string<Allocator>& rhs) noexcept {
+    return rhs.compare(lhs) == 0;
+}
+
+template<class Allocator>
+CIEL_NODISCARD bool operator<(const basic_string<Allocator>& lhs, const basic_string<Allocator>& rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template<class Allocator>
+CIEL_NODISCARD bool operator<(const basic_string<Allocator>& lhs, const char* rhs) noexcept {
+    return lhs.compare(rhs) < 0;
+}
+
+template<class Allocator>
+CIEL_NODISCARD bool operator<(const char* lhs, const basic_string<Allocator>& rhs) noexcept {
+    return rhs.compare(lhs) > 0;
+}
+
+template<class Allocator>
+std::ostream& operator<<(std::ostream& out, const basic_string<Allocator>& s) {
+    return out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+NAMESPACE_CIEL_END
+
+namespace std {
+
+template<class Allocator>
+struct hash<ciel::basic_string<Allocator>> {
+    CIEL_NODISCARD size_t operator()(const ciel::basic_string<Allocator>& s) const noexcept {
+        return ciel::hash_bytes(s.data(), s.size());
+    }
+
+}; // struct hash<ciel::basic_string<Allocator>>
+
+template<class Allocator>
+void swap(ciel::basic_string<Allocator>& lhs, ciel::basic_string<Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace std
+
+#endif // CIELLAB_INCLUDE_CIEL_STRING_HPP_
@@ -5,6 +5,7 @@
 #include <ciel/allocator_traits.hpp>
 #include <ciel/compare.hpp>
 #include <ciel/copy_n.hpp>
+#include <ciel/core/aligned_storage.hpp>
 #include <ciel/core/compressed_pair.hpp>
 #include <ciel/core/config.hpp>
 #include <ciel/core/cstring.hpp>
@@ -15,7 +16,10 @@
 #include <ciel/core/iterator_category.hpp>
 #include <ciel/core/message.hpp>
 #include <ciel/demangle.hpp>
+#include <ciel/growth_policy.hpp>
+#include <ciel/parallel_policy.hpp>
 #include <ciel/range_destroyer.hpp>
+#include <ciel/relocate.hpp>
 #include <ciel/split_buffer.hpp>
 #include <ciel/to_address.hpp>
 
@@ -35,13 +39,14 @@ struct reserve_capacity_t {};
 
 static constexpr reserve_capacity_t reserve_capacity;
 
-template<class T, class Allocator = std::allocator<T>>
+template<class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth_policy_2x>
 class vector {
     static_assert(std::is_same<typename Allocator::value_type, T>::value, "");
 
 public:
     using value_type             = T;
     using allocator_type         = Allocator;
+    using growth_policy          = GrowthPolicy;
     using size_type              = size_t;
     using difference_type        = ptrdiff_t;
     using reference              = value_type&;
@@ -67,6 +72,10 @@ private:
         && via_trivial_construct<decltype(ciel::move_if_noexcept(*std::declval<pointer>()))>::value
         && via_trivial_destroy::value;
 
+    // Grow the buffer through Allocator::reallocate_at_least, which may extend it in place or remap it.
+    static constexpr bool expand_via_realloc =
+        expand_via_memcpy && allocator_has_reallocate_at_least<allocator_type>::value;
+
     static constexpr bool move_via_memmove = is_trivially_relocatable<value_type>::value
                                           && via_trivial_construct<decltype(std::move(*std::declval<pointer>()))>::value
                                           && via_trivial_destroy::value;
@@ -120,13 +129,7 @@ private:
             CIEL_THROW_EXCEPTION(std::length_error("ciel::vector expanding size is beyond max_size"));
         }
 
-        const size_type cap = capacity();
-
-        if CIEL_UNLIKELY (cap >= ms / 2) {
-            return ms;
-        }
-
-        return std::max(cap * 2, new_size);
+        return detail::recommend_cap<growth_policy>(capacity(), new_size, ms, sizeof(value_type));
     }
 
     template<class... Args>
@@ -215,7 +218,8 @@ private:
         // If either dest or src is an invalid or null pointer, memcpy's behavior is undefined, even if count is zero.
         if (begin_) {
             if (expand_via_memcpy) {
-                ciel::memcpy(ciel::to_address(sb.begin_cap_), ciel::to_address(begin_), sizeof(value_type) * size());
+                ciel::uninitialized_relocate(ciel::to_address(begin_), ciel::to_address(end_),
+                                             ciel::to_address(sb.begin_cap_));
                 // sb.begin_ = sb.begin_cap_;
 
             } else {
@@ -246,13 +250,14 @@ private:
 
             CIEL_ASSERT(sb.front_spare() == front_count);
             CIEL_ASSERT(sb.back_spare() >= back_count);
+            CIEL_UNUSED(front_count);
 
             if (expand_via_memcpy) {
-                ciel::memcpy(ciel::to_address(sb.begin_cap_), ciel::to_address(begin_),
-                             sizeof(value_type) * front_count);
+                ciel::uninitialized_relocate(ciel::to_address(begin_), ciel::to_address(pos),
+                                             ciel::to_address(sb.begin_cap_));
                 // sb.begin_ = sb.begin_cap_;
 
-                ciel::memcpy(ciel::to_address(sb.end_), ciel::to_address(pos), sizeof(value_type) * back_count);
+                ciel::uninitialized_relocate(ciel::to_address(pos), ciel::to_address(end_), ciel::to_address(sb.end_));
                 sb.end_ += back_count;
 
             } else {
@@ -277,9 +282,79 @@ private:
         sb.begin_cap_ = nullptr; // enough for split_buffer's destructor
     }
 
+    static void check_parallel_requirements() noexcept {
+        static_assert(std::is_trivially_copyable<value_type>::value && via_trivial_construct<const value_type&>::value,
+                      "parallel_policy requires trivially copyable value_type, "
+                      "and the allocator should not customize construct");
+    }
+
+    // Fill [begin_, begin_ + count) with value, which may be uninitialized storage.
+    void parallel_fill(const parallel_policy policy, const size_type count, const value_type value) {
+        check_parallel_requirements();
+        CIEL_ASSERT(count <= capacity());
+
+        value_type* const p = data();
+
+        detail::parallel_for(policy, count, sizeof(value_type), [p, value](const size_t first, const size_t last) {
+            std::fill(p + first, p + last, value);
+        });
+
+        end_ = begin_ + count;
+    }
+
+    // Copy [src, src + count) to [begin_, begin_ + count), which may be uninitialized storage.
+    void parallel_copy(const parallel_policy policy, const value_type* src, const size_type count) {
+        check_parallel_requirements();
+        CIEL_ASSERT(count <= capacity());
+
+        value_type* const p = data();
+
+        detail::parallel_for(policy, count, sizeof(value_type), [p, src](const size_t first, const size_t last) {
+            ciel::memcpy(p + first, src + first, sizeof(value_type) * (last - first));
+        });
+
+        end_ = begin_ + count;
+    }
+
+    // Relocate the whole buffer to hold at least new_cap elements, only called when expand_via_realloc.
+    void reallocate(const size_type new_cap, std::true_type) {
+        CIEL_ASSERT(begin_ != nullptr);
+        CIEL_ASSERT(new_cap >= size());
+        CIEL_ASSERT(new_cap != 0);
+
+        const size_type old_size  = size();
+        const auto allocation_res = allocator_().reallocate_at_least(begin_, capacity(), new_cap);
+
+        begin_     = allocation_res.ptr;
+        end_       = begin_ + old_size;
+        end_cap_() = begin_ + allocation_res.count;
+    }
+
+    void reallocate(size_type, std::false_type) noexcept {
+        unreachable();
+    }
+
     template<class... Args>
     void emplace_back_aux(Args&&... args) {
-        if (end_ == end_cap_()) {
+        if (expand_via_realloc && end_ == end_cap_() && begin_ != nullptr) {
+            // args may refer to an element, which would be invalidated by reallocate,
+            // so construct the new element aside first, then relocate it into place.
+            typename aligned_storage<sizeof(value_type), alignof(value_type)>::type buffer;
+            value_type* tmp = reinterpret_cast<value_type*>(&buffer);
+            alloc_traits::construct(allocator_(), tmp, std::forward<Args>(args)...);
+
+            CIEL_TRY {
+                reallocate(recommend_cap(size() + 1), std::integral_constant<bool, expand_via_realloc>{});
+            }
+            CIEL_CATCH (...) {
+                alloc_traits::destroy(allocator_(), tmp);
+                CIEL_THROW;
+            }
+
+            ciel::relocate_at(tmp, ciel::to_address(end_));
+            ++end_;
+
+        } else if (end_ == end_cap_()) {
             split_buffer<value_type, allocator_type&> sb(allocator_(), recommend_cap(size() + 1), size());
             sb.unchecked_emplace_back(std::forward<Args>(args)...);
             swap_out_buffer(std::move(sb));
@@ -343,6 +418,26 @@ public:
         }
     }
 
+    // The parallel_policy overloads split the work across threads, see parallel_policy.hpp.
+    // They are only available for trivially copyable value_type.
+
+    vector(const parallel_policy policy, const size_type count, lvalue value,
+           const allocator_type& alloc = allocator_type())
+        : vector(alloc) {
+        if CIEL_LIKELY (count > 0) {
+            init(count);
+            parallel_fill(policy, count, value);
+        }
+    }
+
+    vector(const parallel_policy policy, const vector& other)
+        : vector(alloc_traits::select_on_container_copy_construction(other.get_allocator())) {
+        if CIEL_LIKELY (!other.empty()) {
+            init(other.size());
+            parallel_copy(policy, other.data(), other.size());
+        }
+    }
+
     template<class Iter, enable_if_t<is_exactly_input_iterator<Iter>::value> = 0>
     vector(Iter first, Iter last, const allocator_type& alloc = allocator_type())
         : vector(alloc) {
@@ -481,6 +576,38 @@ public:
         }
     }
 
+    void assign(const parallel_policy policy, const size_type count, lvalue value) {
+        // value may be an element of this vector.
+        const value_type copy = value;
+
+        if (capacity() < count) {
+            reset(count);
+        }
+
+        parallel_fill(policy, count, copy);
+    }
+
+    void assign(const parallel_policy policy, const value_type* first, const value_type* last) {
+        const size_type count = last - first;
+
+        if (capacity() < count) {
+            reset(count);
+
+        } else if (data() < last && first < data() + capacity()) {
+            // Overlapping with this vector's own buffer.
+            check_parallel_requirements();
+
+            if (count != 0) {
+                ciel::memmove(data(), first, sizeof(value_type) * count);
+            }
+
+            end_ = begin_ + count;
+            return;
+        }
+
+        parallel_copy(policy, first, count);
+    }
+
 private:
     template<class Iter>
     void assign(Iter first, Iter last, const size_type count) {
@@ -688,6 +815,11 @@ public:
             CIEL_THROW_EXCEPTION(std::length_error{"ciel::vector::reserve capacity beyond max_size"});
         }
 
+        if (expand_via_realloc && begin_ != nullptr) {
+            reallocate(new_cap, std::integral_constant<bool, expand_via_realloc>{});
+            return;
+        }
+
         split_buffer<value_type, allocator_type&> sb(allocator_(), new_cap, size());
         swap_out_buffer(std::move(sb));
     }
@@ -703,8 +835,13 @@ public:
 
         if (size() > 0) {
             CIEL_TRY {
-                split_buffer<value_type, allocator_type&> sb(allocator_(), size(), size());
-                swap_out_buffer(std::move(sb));
+                if (expand_via_realloc) {
+                    reallocate(size(), std::integral_constant<bool, expand_via_realloc>{});
+
+                } else {
+                    split_buffer<value_type, allocator_type&> sb(allocator_(), size(), size());
+                    swap_out_buffer(std::move(sb));
+                }
             }
             CIEL_CATCH (...) {}
 
@@ -719,6 +856,66 @@ public:
     }
 
 private:
+    template<class U, class A, class G, class Pred>
+    friend typename vector<U, A, G>::size_type erase_if(vector<U, A, G>&, Pred);
+
+    template<class Pred>
+    size_type erase_if_impl(Pred& pred, std::false_type) {
+        const pointer it = std::remove_if(begin_, end_, pred);
+        const auto res   = end_ - it;
+        end_             = destroy(it, end_);
+        return res;
+    }
+
+    // Relocate the survivors into place run by run, instead of move assigning each of them.
+    template<class Pred>
+    size_type erase_if_impl(Pred& pred, std::true_type) {
+        pointer out = std::find_if(begin_, end_, pred);
+
+        if (out == end_) {
+            return 0;
+        }
+
+        destroy(out);
+
+        pointer run_begin = out + 1;
+        pointer p         = run_begin;
+
+        CIEL_TRY {
+            while (p != end_) {
+                run_begin = p;
+
+                while (p != end_ && !pred(*p)) {
+                    ++p;
+                }
+
+                const size_type run_size = p - run_begin;
+
+                if (run_size != 0) {
+                    ciel::uninitialized_relocate_n(ciel::to_address(run_begin), run_size, ciel::to_address(out));
+                    out += run_size;
+                }
+
+                if (p != end_) {
+                    destroy(p);
+                    ++p;
+                }
+            }
+        }
+        CIEL_CATCH (...) {
+            // [out, run_begin) are destroyed or relocated, close the gap.
+            const size_type tail_size = end_ - run_begin;
+            ciel::uninitialized_relocate_n(ciel::to_address(run_begin), tail_size, ciel::to_address(out));
+            end_ = out + tail_size;
+            CIEL_THROW;
+        }
+
+        const size_type res = end_ - out;
+        end_                = out;
+
+        return res;
+    }
+
     template<class ExpansionCallback, class AppendCallback, class InsertCallback, class IsInternalValueCallback>
     iterator insert_impl(pointer pos, const size_type count, ExpansionCallback&& expansion_callback,
                          AppendCallback&& append_callback, InsertCallback&& insert_callback,
@@ -755,7 +952,8 @@ private:
             //                       |  count |
             if (move_via_memmove) {
                 const size_type pos_end_dis = end_ - pos;
-                ciel::memmove(ciel::to_address(pos + count), ciel::to_address(pos), sizeof(value_type) * pos_end_dis);
+                ciel::uninitialized_relocate_backward(ciel::to_address(pos), ciel::to_address(end_),
+                                                      ciel::to_address(end_ + count));
                 end_ = pos;
                 rd.advance_backward(pos_end_dis);
 
@@ -798,7 +996,8 @@ public:
                 unchecked_emplace_back(value);
             },
             [&] {
-                unchecked_emplace_back(*(std::addressof(value) + 1));
+                // value was relocated one unit later, indexing from pos lets the compiler see it's in bounds.
+                unchecked_emplace_back(pos[std::addressof(value) - ciel::to_address(pos) + 1]);
             },
             [&] {
                 return internal_value(value, pos);
@@ -818,7 +1017,7 @@ public:
                 unchecked_emplace_back(std::move(value));
             },
             [&] {
-                unchecked_emplace_back(std::move(*(std::addressof(value) + 1)));
+                unchecked_emplace_back(std::move(pos[std::addressof(value) - ciel::to_address(pos) + 1]));
             },
             [&] {
                 return internal_value(value, pos);
@@ -841,7 +1040,7 @@ public:
                 construct_at_end(count, value);
             },
             [&] {
-                construct_at_end(count, *(std::addressof(value) + count));
+                construct_at_end(count, pos[std::addressof(value) - ciel::to_address(pos) + count]);
             },
             [&] {
                 return internal_value(value, pos);
@@ -917,6 +1116,86 @@ public:
         return insert(pos, std::make_move_iterator(rg.begin()), std::make_move_iterator(rg.end()));
     }
 
+private:
+    // Walk positions and values backward, relocate each run of elements to its final place
+    // and construct the value right before it, so every element is relocated at most once.
+    template<class PosIter, class ValueIter>
+    void insert_batch_impl(const PosIter pos_first, PosIter pos_last, ValueIter value_last, const size_type count) {
+        if CIEL_UNLIKELY (count == 0) {
+            return;
+        }
+
+        if (size() + count > capacity()) {
+            reserve(recommend_cap(size() + count));
+        }
+
+        const pointer old_end = end_;
+        pointer src           = end_;         // [begin_, src) are not relocated yet
+        pointer dst           = end_ + count; // [dst, old_end + count) are in their final places
+
+        range_destroyer<value_type, allocator_type&> rd{dst, dst, allocator_()};
+
+        while (pos_last != pos_first) {
+            --pos_last;
+            --value_last;
+
+            const pointer pos = begin_ + *pos_last;
+            CIEL_ASSERT(begin_ <= pos);
+            CIEL_ASSERT(pos <= src); // positions should be sorted and no greater than size()
+
+            const size_type n = src - pos;
+
+            if (move_via_memmove) {
+                ciel::uninitialized_relocate_backward(ciel::to_address(pos), ciel::to_address(src),
+                                                      ciel::to_address(dst));
+                dst -= n;
+                rd.advance_backward(n);
+
+                src  = pos;
+                end_ = src;
+
+            } else {
+                while (src != pos) {
+                    construct(dst - 1, std::move(*(src - 1)));
+                    --dst;
+                    rd.advance_backward();
+
+                    --src;
+                    destroy(src);
+                    end_ = src;
+                }
+            }
+
+            construct(dst - 1, *value_last);
+            --dst;
+            rd.advance_backward();
+        }
+
+        CIEL_ASSERT(src == dst);
+
+        end_ = old_end + count;
+        rd.release();
+    }
+
+public:
+    // Insert values[i] before the element at index positions[i] of the original vector, for every i.
+    // positions should be sorted in ascending order, values with equal positions keep their order.
+    // It reallocates at most once and relocates each element at most once, unlike calling insert K times.
+    // Both ranges should be bidirectional, and values can't refer to elements of this vector.
+    template<class PosRange, class ValueRange,
+             enable_if_t<is_range<const PosRange&>::value && is_range<ValueRange>::value> = 0>
+    void insert_batch(const PosRange& positions, ValueRange&& values) {
+        const size_type count = ciel::distance(positions);
+        CIEL_ASSERT(count == static_cast<size_type>(ciel::distance(values)));
+
+        if (std::is_lvalue_reference<ValueRange>::value) {
+            insert_batch_impl(positions.begin(), positions.end(), values.end(), count);
+
+        } else {
+            insert_batch_impl(positions.begin(), positions.end(), std::make_move_iterator(values.end()), count);
+        }
+    }
+
     template<class... Args>
     iterator emplace(const_iterator p, Args&&... args) {
         const pointer pos = begin_ + (p - begin());
@@ -979,12 +1258,7 @@ private:
             destroy(first, last);
             end_ -= count;
 
-            if (count >= back_count) {
-                ciel::memcpy(ciel::to_address(first), ciel::to_address(last), sizeof(value_type) * back_count);
-
-            } else {
-                ciel::memmove(ciel::to_address(first), ciel::to_address(last), sizeof(value_type) * back_count);
-            }
+            ciel::uninitialized_relocate_n(ciel::to_address(last), back_count, ciel::to_address(first));
 
         } else {
             const pointer new_end = std::move(last, end_, first);
@@ -1018,6 +1292,52 @@ public:
         return erase_impl(first, last, count);
     }
 
+    // Erase the element at p by moving the last element into its place, so the order is not preserved.
+    iterator unstable_erase(const_iterator p) {
+        const pointer pos = begin_ + (p - begin());
+        CIEL_ASSERT(begin_ <= pos);
+        CIEL_ASSERT(pos < end_);
+
+        const pointer last = end_ - 1;
+
+        if (move_via_memmove) {
+            destroy(pos);
+
+            ciel::relocate_at(ciel::to_address(last), ciel::to_address(pos));
+
+        } else {
+            if (pos != last) {
+                *pos = std::move(*last);
+            }
+
+            destroy(last);
+        }
+
+        --end_;
+
+        return begin() + (pos - begin_);
+    }
+
+    // Erase all elements satisfying pred by moving the last elements into their places,
+    // so the order is not preserved. Return the number of erased elements.
+    template<class Pred>
+    size_type unstable_erase_if(Pred pred) {
+        const size_type old_size = size();
+
+        pointer p = begin_;
+        while (p != end_) {
+            if (!pred(*p)) {
+                ++p;
+                continue;
+            }
+
+            // The element moved from the back is checked in the next round.
+            unstable_erase(p);
+        }
+
+        return old_size - size();
+    }
+
     void push_back(lvalue value) {
         emplace_back(value);
     }
@@ -1091,6 +1411,41 @@ public:
         }
     }
 
+    // Default-initialize the new elements instead of value-initializing them,
+    // i.e. leave them uninitialized, so that they can be overwritten without zeroing them first.
+    void resize(const size_type count, default_init_t) {
+        static_assert(std::is_trivially_default_constructible<value_type>::value && via_trivial_construct<>::value,
+                      "resize(count, default_init) requires trivially default constructible value_type, "
+                      "and the allocator should not customize construct");
+
+        if (size() >= count) {
+            end_ = destroy(begin_ + count, end_);
+
+        } else {
+            reserve(count);
+            end_ = begin_ + count;
+        }
+    }
+
+    // Similar to std::basic_string::resize_and_overwrite. After making room for count elements,
+    // std::move(op)(data(), count) writes to [data(), data() + count) and returns the new size r <= count.
+    // Elements in [data(), data() + min(size(), count)) keep their values, the others are uninitialized.
+    template<class Operation>
+    void resize_and_overwrite(const size_type count, Operation op) {
+        static_assert(std::is_trivially_default_constructible<value_type>::value
+                          && std::is_trivially_destructible<value_type>::value && via_trivial_construct<>::value
+                          && via_trivial_destroy::value,
+                      "resize_and_overwrite requires trivial value_type, "
+                      "and the allocator should not customize construct or destroy");
+
+        reserve(count);
+
+        const size_type new_size = std::move(op)(data(), count);
+        CIEL_ASSERT(new_size <= count);
+
+        end_ = begin_ + new_size;
+    }
+
     void swap(vector& other) noexcept {
         using std::swap;
 
@@ -1103,8 +1458,8 @@ public:
 
 }; // class vector
 
-template<class T, class Allocator>
-std::ostream& operator<<(std::ostream& out, const vector<T, Allocator>& v) {
+template<class T, class Allocator, class GrowthPolicy>
+std::ostream& operator<<(std::ostream& out, const vector<T, Allocator, GrowthPolicy>& v) {
 #ifdef CIEL_HAS_RTTI
     out << ciel::demangle(typeid(v).name()) << ": ";
 #endif
@@ -1118,25 +1473,22 @@ std::ostream& operator<<(std::ostream& out, const vector<T, Allocator>& v) {
     return out;
 }
 
-template<class T, class Allocator>
-struct is_trivially_relocatable<vector<T, Allocator>>
+template<class T, class Allocator, class GrowthPolicy>
+struct is_trivially_relocatable<vector<T, Allocator, GrowthPolicy>>
     : conjunction<is_trivially_relocatable<Allocator>,
                   is_trivially_relocatable<typename std::allocator_traits<remove_reference_t<Allocator>>::pointer>> {};
 
-template<class T, class Alloc, class U>
-typename vector<T, Alloc>::size_type erase(vector<T, Alloc>& c, const U& value) {
+template<class T, class Alloc, class GrowthPolicy, class U>
+typename vector<T, Alloc, GrowthPolicy>::size_type erase(vector<T, Alloc, GrowthPolicy>& c, const U& value) {
     auto it        = std::remove(c.begin(), c.end(), value);
     const auto res = std::distance(it, c.end());
     c.erase(it, c.end());
     return res;
 }
 
-template<class T, class Alloc, class Pred>
-typename vector<T, Alloc>::size_type erase_if(vector<T, Alloc>& c, Pred pred) {
-    auto it        = std::remove_if(c.begin(), c.end(), pred);
-    const auto res = std::distance(it, c.end());
-    c.erase(it, c.end());
-    return res;
+template<class T, class Alloc, class GrowthPolicy, class Pred>
+typename vector<T, Alloc, GrowthPolicy>::size_type erase_if(vector<T, Alloc, GrowthPolicy>& c, Pred pred) {
+    return c.erase_if_impl(pred, std::integral_constant<bool, vector<T, Alloc, GrowthPolicy>::move_via_memmove>{});
 }
 
 #if CIEL_STD_VER >= 17
@@ -1150,8 +1502,9 @@ NAMESPACE_CIEL_END
 
 namespace std {
 
-template<class T, class Alloc>
-void swap(ciel::vector<T, Alloc>& lhs, ciel::vector<T, Alloc>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+template<class T, class Alloc, class GrowthPolicy>
+void swap(ciel::vector<T, Alloc, GrowthPolicy>& lhs,
+          ciel::vector<T, Alloc, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
     lhs.swap(rhs);
 }
 
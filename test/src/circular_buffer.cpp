@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <ciel/circular_buffer.hpp>
+#include <ciel/inplace_circular_buffer.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+// Elements in order, through array_one() and array_two().
+template<class B>
+ciel::vector<int> linearize(const B& b) {
+    ciel::vector<int> res;
+    for (const auto& value : b.array_one()) {
+        res.emplace_back(value);
+    }
+
+    for (const auto& value : b.array_two()) {
+        res.emplace_back(value);
+    }
+
+    return res;
+}
+
+template<class B>
+void test_overwrite_impl(::testing::Test*, B b) {
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(b.begin(), b.end());
+
+    for (int i = 0; i < 3; ++i) {
+        b.push_back(i);
+    }
+    ASSERT_EQ(b, std::initializer_list<int>({0, 1, 2}));
+    ASSERT_TRUE(b.array_two().empty());
+
+    // Wraps around and overwrites the oldest ones.
+    for (int i = 3; i < 10; ++i) {
+        b.push_back(i);
+    }
+    ASSERT_TRUE(b.full());
+    ASSERT_EQ(b.size(), b.capacity());
+    ASSERT_EQ(b.front(), 10 - static_cast<int>(b.capacity()));
+    ASSERT_EQ(b.back(), 9);
+    ASSERT_EQ(linearize(b), ciel::vector<int>(b.begin(), b.end()));
+
+    b.push_front(-1);
+    ASSERT_EQ(b.front(), -1);
+    ASSERT_EQ(b.back(), 8);
+    ASSERT_EQ(linearize(b), ciel::vector<int>(b.begin(), b.end()));
+
+    b.pop_front();
+    b.pop_back();
+    ASSERT_EQ(b.size(), b.capacity() - 2);
+    ASSERT_EQ(b.back(), 7);
+    ASSERT_EQ(b.at(0), b[0]);
+    ASSERT_EQ(*b.rbegin(), 7);
+    ASSERT_EQ(b.end() - b.begin(), static_cast<ptrdiff_t>(b.size()));
+
+    // Refers to the element being overwritten.
+    while (!b.full()) {
+        b.push_back(0);
+    }
+    const int front = b.front();
+    b.push_back(b.front());
+    ASSERT_EQ(b.back(), front);
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(CIEL_UNUSED(b.at(b.size())), std::out_of_range);
+#endif
+
+    b.clear();
+    ASSERT_TRUE(b.empty());
+}
+
+} // namespace
+
+TEST(circular_buffer, overwrite) {
+    // Power of two capacity takes the mask path.
+    test_overwrite_impl(this, circular_buffer<int>(4));
+    test_overwrite_impl(this, circular_buffer<int>(5));
+    test_overwrite_impl(this, circular_buffer<Int>(4));
+    test_overwrite_impl(this, circular_buffer<TMInt>(5));
+}
+
+TEST(inplace_circular_buffer, overwrite) {
+    test_overwrite_impl(this, inplace_circular_buffer<int, 4>());
+    test_overwrite_impl(this, inplace_circular_buffer<int, 5>());
+    test_overwrite_impl(this, inplace_circular_buffer<Int, 4>());
+    test_overwrite_impl(this, inplace_circular_buffer<TMInt, 5>());
+}
+
+TEST(circular_buffer, copy_and_move) {
+    circular_buffer<std::string> b1(3);
+    for (int i = 0; i < 5; ++i) {
+        b1.push_back(std::to_string(i));
+    }
+
+    circular_buffer<std::string> b2(b1);
+    ASSERT_EQ(b2, b1);
+    ASSERT_EQ(b2.capacity(), 3);
+
+    circular_buffer<std::string> b3(std::move(b2));
+    ASSERT_EQ(b3, b1);
+    ASSERT_EQ(b2.capacity(), 0);
+
+    b2 = b3;
+    ASSERT_EQ(b2, b1);
+
+    circular_buffer<std::string> b4(10);
+    b4 = std::move(b3);
+    ASSERT_EQ(b4, b1);
+    ASSERT_EQ(b4.capacity(), 3);
+
+    std::swap(b3, b4);
+    ASSERT_TRUE(b4.empty());
+    ASSERT_EQ(b3, std::initializer_list<std::string>({"2", "3", "4"}));
+}
+
+TEST(inplace_circular_buffer, copy_and_move) {
+    inplace_circular_buffer<std::string, 3> b1{"0", "1", "2", "3", "4"};
+    ASSERT_EQ(b1, std::initializer_list<std::string>({"2", "3", "4"}));
+
+    inplace_circular_buffer<std::string, 3> b2(b1);
+    ASSERT_EQ(b2, b1);
+
+    const inplace_circular_buffer<std::string, 3> b3(std::move(b2));
+    ASSERT_EQ(b3, b1);
+
+    b2 = b3;
+    ASSERT_EQ(b2, b1);
+
+    b2.push_back("5");
+    b2 = std::move(b1);
+    ASSERT_EQ(b2, b3);
+
+    static_assert(sizeof(inplace_circular_buffer<char, 100>) == 102, "");
+    static_assert(std::is_trivially_destructible<inplace_circular_buffer<int, 8>>::value, "");
+}
+
+TEST(inplace_circular_buffer, destructor) {
+    const std::shared_ptr<int> p = std::make_shared<int>(0);
+
+    {
+        // Wrapped around, head is 2.
+        inplace_circular_buffer<std::shared_ptr<int>, 3> b{p, p, p, p, p};
+        b.pop_front();
+        ASSERT_EQ(p.use_count(), 3);
+    }
+
+    ASSERT_EQ(p.use_count(), 1);
+}
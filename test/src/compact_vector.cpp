@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <ciel/compact_vector.hpp>
+#include <ciel/growth_policy.hpp>
+#include <ciel/malloc_allocator.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class C>
+void test_modifiers_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    C v;
+    for (int i = 0; i < 5; ++i) {
+        v.emplace_back(i);
+    }
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1, 2, 3, 4}));
+
+    // Refers to an element, while expanding.
+    v.shrink_to_fit();
+    v.push_back(v.front());
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1, 2, 3, 4, 0}));
+
+    v.insert(v.begin() + 1, v.back());
+    v.emplace(v.begin(), 5);
+    ASSERT_EQ(v, std::initializer_list<T>({5, 0, 0, 1, 2, 3, 4, 0}));
+
+    v.shrink_to_fit();
+    v.insert(v.begin() + 2, v[3]);
+    ASSERT_EQ(v, std::initializer_list<T>({5, 0, 1, 0, 1, 2, 3, 4, 0}));
+
+    v.erase(v.begin(), v.begin() + 3);
+    v.erase(v.end() - 1);
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1, 2, 3, 4}));
+
+    v.pop_back();
+    v.resize(6, 7);
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1, 2, 3, 7, 7}));
+
+    v.resize(2);
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1}));
+
+    v.assign(10, v[1]);
+    ASSERT_EQ(v.size(), 10);
+    ASSERT_EQ(v.back(), 1);
+
+    v = {4, 3, 2};
+    ASSERT_EQ(v, std::initializer_list<T>({4, 3, 2}));
+
+    v.clear();
+    ASSERT_TRUE(v.empty());
+}
+
+} // namespace
+
+TEST(compact_vector, footprint) {
+    static_assert(sizeof(compact_vector<int>) == sizeof(void*) + 8, "");
+    static_assert(sizeof(compact_vector<int>) < sizeof(vector<int>), "");
+}
+
+TEST(compact_vector, modifiers) {
+    test_modifiers_impl<compact_vector<int>>(this);
+    test_modifiers_impl<compact_vector<Int>>(this);
+    test_modifiers_impl<compact_vector<TRInt>>(this);
+    test_modifiers_impl<compact_vector<TMInt>>(this);
+    test_modifiers_impl<compact_vector<TRInt, malloc_allocator<TRInt>>>(this);
+}
+
+TEST(compact_vector, constructor) {
+    const compact_vector<int> v1(3, 42);
+    ASSERT_EQ(v1, std::initializer_list<int>({42, 42, 42}));
+
+    compact_vector<int> v2(v1);
+    ASSERT_EQ(v2, v1);
+
+    const compact_vector<int> v3(std::move(v2));
+    ASSERT_EQ(v3, v1);
+    ASSERT_TRUE(v2.empty());
+    ASSERT_EQ(v2.capacity(), 0);
+
+    v2 = v3;
+    ASSERT_EQ(v2, v1);
+
+    const compact_vector<int> v4(reserve_capacity, 100);
+    ASSERT_TRUE(v4.empty());
+    ASSERT_GE(v4.capacity(), 100);
+
+    const compact_vector<int> v5(v1.begin(), v1.end());
+    ASSERT_EQ(v5, v1);
+
+    compact_vector<std::string> v6{"a", "b"};
+    compact_vector<std::string> v7;
+    v7 = std::move(v6);
+    ASSERT_EQ(v7, std::initializer_list<std::string>({"a", "b"}));
+
+    std::swap(v6, v7);
+    ASSERT_TRUE(v7.empty());
+    ASSERT_EQ(v6.size(), 2);
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(CIEL_UNUSED(v1.at(3)), std::out_of_range);
+#endif
+}
+
+TEST(compact_vector, unique_ptr) {
+    compact_vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 10; ++i) {
+        v.emplace(v.begin(), new int{i});
+    }
+
+    v.erase(v.begin() + 2, v.begin() + 5);
+    ASSERT_EQ(v.size(), 7);
+    ASSERT_EQ(*v.front(), 9);
+    ASSERT_EQ(*v[2], 4);
+}
+
+TEST(compact_vector, growth_policy) {
+    compact_vector<int, std::allocator<int>, growth_policy_1_5x> v1;
+    compact_vector<Int, std::allocator<Int>, growth_policy_size_class> v2;
+    vector<int, std::allocator<int>, growth_policy_1_5x> expected1;
+    vector<Int, std::allocator<Int>, growth_policy_size_class> expected2;
+
+    // Grows exactly like vector with the same policy.
+    for (int i = 0; i < 100; ++i) {
+        v1.emplace_back(i);
+        v2.emplace_back(i);
+        expected1.emplace_back(i);
+        expected2.emplace_back(i);
+
+        ASSERT_EQ(v1.capacity(), expected1.capacity());
+        ASSERT_EQ(v2.capacity(), expected2.capacity());
+    }
+}
+
+TEST(compact_vector, erase_if) {
+    compact_vector<int> v{0, 1, 2, 3, 4, 5, 6};
+
+    ASSERT_EQ(erase_if(v, [](const int i) {
+                  return i % 2 == 0;
+              }),
+              4);
+    ASSERT_EQ(erase(v, 3), 1);
+    ASSERT_EQ(v, std::initializer_list<int>({1, 5}));
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+TEST(compact_vector, beyond_max_size) {
+    // Counts beyond uint32_t used to be truncated, e.g. reserve(1 << 32) reserved nothing.
+    const size_t count = static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1;
+    if (count == 0) {
+        return;
+    }
+
+    compact_vector<int> v{0, 1, 2};
+    ASSERT_THROW(v.reserve(count), std::length_error);
+    ASSERT_THROW(v.resize(count), std::length_error);
+    ASSERT_THROW(v.resize(count, 1), std::length_error);
+    ASSERT_THROW(v.assign(count, 1), std::length_error);
+    ASSERT_EQ(v, std::initializer_list<int>({0, 1, 2}));
+
+    ASSERT_THROW(CIEL_UNUSED(compact_vector<int>(count)), std::length_error);
+    ASSERT_THROW(compact_vector<int>(count, 1), std::length_error);
+    ASSERT_THROW(compact_vector<int>(reserve_capacity, count), std::length_error);
+}
+#endif
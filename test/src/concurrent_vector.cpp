@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <ciel/concurrent_vector.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/test/simple_latch.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+
+using namespace ciel;
+
+TEST(concurrent_vector, singlethread) {
+    concurrent_vector<Int> v;
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.capacity(), 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(v.push_back(i), static_cast<size_t>(i));
+    }
+
+    ASSERT_EQ(v.size(), 1000);
+    ASSERT_GE(v.capacity(), 1000);
+    ASSERT_EQ(v.front(), 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(v[i], i);
+    }
+
+    ASSERT_EQ(v.end() - v.begin(), 1000);
+    ASSERT_EQ(*v.rbegin(), 999);
+    ASSERT_EQ(std::distance(v.cbegin(), v.cend()), 1000);
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    concurrent_vector<Int> v2(v);
+    ASSERT_TRUE(std::equal(v.begin(), v.end(), v2.begin()));
+
+    concurrent_vector<Int> v3(std::move(v2));
+    ASSERT_TRUE(v2.empty());
+    ASSERT_EQ(v2.capacity(), 0);
+    ASSERT_TRUE(std::equal(v.begin(), v.end(), v3.begin()));
+
+    const size_t cap = v.capacity();
+    v.clear();
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.capacity(), cap);
+
+    v.emplace_back(42);
+    ASSERT_EQ(v.size(), 1);
+    ASSERT_EQ(v.front(), 42);
+}
+
+TEST(concurrent_vector, reserve) {
+    concurrent_vector<int> v;
+    v.reserve(100);
+    ASSERT_GE(v.capacity(), 100);
+    ASSERT_TRUE(v.empty());
+
+    v.push_back(1);
+    const int* p = &v[0];
+
+    for (int i = 0; i < 10000; ++i) {
+        v.push_back(i);
+    }
+
+    // Never relocated.
+    ASSERT_EQ(p, &v[0]);
+    ASSERT_EQ(*p, 1);
+}
+
+TEST(concurrent_vector, multithread) {
+    constexpr size_t threads_num    = 8;
+    constexpr size_t operations_num = 10000;
+
+    concurrent_vector<size_t> v;
+    SimpleLatch go{threads_num + 1};
+    std::atomic<bool> done{false};
+
+    ciel::vector<std::thread> writers(reserve_capacity, threads_num);
+    for (size_t i = 0; i < threads_num; ++i) {
+        writers.unchecked_emplace_back([&, i] {
+            go.arrive_and_wait();
+
+            for (size_t j = 0; j < operations_num; ++j) {
+                v.push_back(i * operations_num + j + 1);
+            }
+        });
+    }
+
+    // Every published element is fully constructed, and each writer's elements keep their order.
+    std::thread reader([&] {
+        go.arrive_and_wait();
+
+        while (!done.load()) {
+            const size_t sz = v.size();
+            size_t last[threads_num]{};
+
+            for (size_t i = 0; i < sz; ++i) {
+                const size_t value = v[i];
+                ASSERT_NE(value, 0);
+                ASSERT_LE(value, threads_num * operations_num);
+
+                const size_t t = (value - 1) / operations_num;
+                ASSERT_LT(last[t], value);
+                last[t] = value;
+            }
+        }
+    });
+
+    for (auto& t : writers) {
+        t.join();
+    }
+
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(v.size(), threads_num * operations_num);
+
+    ciel::vector<size_t> values(v.begin(), v.end());
+    std::sort(values.begin(), values.end());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], i + 1);
+    }
+}
+
+TEST(concurrent_vector, multithread_nontrivial) {
+    constexpr size_t threads_num    = 8;
+    constexpr size_t operations_num = 1000;
+
+    // vector's constructor may throw, so each element is built before claiming an index, then moved in.
+    concurrent_vector<ciel::vector<size_t>> v;
+    SimpleLatch go{threads_num};
+
+    ciel::vector<std::thread> writers(reserve_capacity, threads_num);
+    for (size_t i = 0; i < threads_num; ++i) {
+        writers.unchecked_emplace_back([&, i] {
+            go.arrive_and_wait();
+
+            for (size_t j = 0; j < operations_num; ++j) {
+                v.emplace_back(j % 8 + 1, i * operations_num + j);
+            }
+        });
+    }
+
+    for (auto& t : writers) {
+        t.join();
+    }
+
+    ASSERT_EQ(v.size(), threads_num * operations_num);
+
+    size_t sum = 0;
+    for (const auto& e : v) {
+        ASSERT_EQ(e.size(), e.front() % operations_num % 8 + 1);
+        sum += e.front();
+    }
+
+    ASSERT_EQ(sum, threads_num * operations_num * (threads_num * operations_num - 1) / 2);
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+namespace {
+
+struct throw_on_third_copy {
+    static size_t copies;
+    static size_t alive;
+
+    throw_on_third_copy() noexcept {
+        ++alive;
+    }
+
+    throw_on_third_copy(const throw_on_third_copy&) {
+        if (++copies == 3) {
+            throw 0;
+        }
+
+        ++alive;
+    }
+
+    throw_on_third_copy(throw_on_third_copy&&) noexcept {
+        ++alive;
+    }
+
+    ~throw_on_third_copy() {
+        --alive;
+    }
+
+}; // struct throw_on_third_copy
+
+size_t throw_on_third_copy::copies = 0;
+size_t throw_on_third_copy::alive  = 0;
+
+} // namespace
+
+TEST(concurrent_vector, copy_constructor_throws) {
+    {
+        concurrent_vector<throw_on_third_copy> v;
+        for (int i = 0; i < 5; ++i) {
+            v.emplace_back();
+        }
+        ASSERT_EQ(throw_on_third_copy::alive, 5);
+
+        ASSERT_THROW(concurrent_vector<throw_on_third_copy>{v}, int);
+        ASSERT_EQ(throw_on_third_copy::alive, 5);
+    }
+
+    ASSERT_EQ(throw_on_third_copy::alive, 0);
+}
+#endif
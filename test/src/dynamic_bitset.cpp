@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <ciel/dynamic_bitset.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <random>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+// Bits from a fixed seed, with the given density in percent.
+ciel::vector<bool> make_bools(const size_t n, const unsigned density) {
+    std::mt19937 g(42);
+
+    ciel::vector<bool> res(ciel::reserve_capacity, n);
+    for (size_t i = 0; i < n; ++i) {
+        res.unchecked_emplace_back(g() % 100 < density);
+    }
+
+    return res;
+}
+
+dynamic_bitset<> make_bitset(const ciel::vector<bool>& bools) {
+    dynamic_bitset<> res;
+    for (const bool b : bools) {
+        res.push_back(b);
+    }
+
+    return res;
+}
+
+} // namespace
+
+TEST(dynamic_bitset, constructor) {
+    const dynamic_bitset<> b1;
+    ASSERT_TRUE(b1.empty());
+    ASSERT_EQ(b1.count(), 0);
+    ASSERT_TRUE(b1.all());
+    ASSERT_TRUE(b1.none());
+
+    const dynamic_bitset<> b2(100, true);
+    ASSERT_EQ(b2.size(), 100);
+    ASSERT_EQ(b2.num_words(), 2);
+    ASSERT_EQ(b2.count(), 100);
+    ASSERT_TRUE(b2.all());
+
+    dynamic_bitset<> b3(b2);
+    ASSERT_EQ(b3, b2);
+
+    const dynamic_bitset<> b4(std::move(b3));
+    ASSERT_EQ(b4, b2);
+    ASSERT_TRUE(b3.empty());
+
+    b3 = b4;
+    b3.reset(99);
+    ASSERT_NE(b3, b4);
+}
+
+TEST(dynamic_bitset, modifiers) {
+    dynamic_bitset<> b(70);
+    ASSERT_TRUE(b.none());
+
+    b[3] = true;
+    b.set(64);
+    b.flip(69);
+    ASSERT_TRUE(b[3]);
+    ASSERT_TRUE(b.test(64));
+    ASSERT_TRUE(b[69]);
+    ASSERT_EQ(b.count(), 3);
+
+    b[4] = b[3];
+    b[3].flip();
+    ASSERT_FALSE(b[3]);
+    ASSERT_TRUE(b[4]);
+
+    b.flip();
+    ASSERT_EQ(b.count(), 67);
+    b.set();
+    ASSERT_TRUE(b.all());
+    b.reset();
+    ASSERT_TRUE(b.none());
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(CIEL_UNUSED(b.test(70)), std::out_of_range);
+#endif
+}
+
+TEST(dynamic_bitset, resize) {
+    dynamic_bitset<> b;
+
+    for (size_t i = 0; i < 200; ++i) {
+        b.push_back(i % 3 == 0);
+    }
+    ASSERT_EQ(b.size(), 200);
+    ASSERT_EQ(b.count(), 67);
+
+    b.resize(10);
+    ASSERT_EQ(b.count(), 4);
+    ASSERT_EQ(b.num_words(), 1);
+
+    b.resize(130, true);
+    ASSERT_EQ(b.count(), 124);
+    ASSERT_TRUE(b[129]);
+    ASSERT_FALSE(b[8]);
+
+    b.pop_back();
+    b.pop_back();
+    ASSERT_EQ(b.size(), 128);
+    ASSERT_EQ(b.num_words(), 2);
+    ASSERT_EQ(b.count(), 122);
+
+    // Bits past size() are dropped, so growing again yields zeros.
+    b.resize(100);
+    b.resize(128);
+    ASSERT_EQ(b.count(), 94);
+
+    b.clear();
+    ASSERT_TRUE(b.empty());
+}
+
+TEST(dynamic_bitset, bulk_operations) {
+    const auto x = make_bools(1000, 50);
+    const auto y = make_bools(1000, 30);
+
+    dynamic_bitset<> a = make_bitset(x);
+    dynamic_bitset<> b(1000);
+    for (size_t i = 0; i < 1000; ++i) {
+        b[i] = y[(i * 7) % 1000];
+    }
+
+    const dynamic_bitset<> band    = a & b;
+    const dynamic_bitset<> bor     = a | b;
+    const dynamic_bitset<> bxor    = a ^ b;
+    const dynamic_bitset<> bandnot = dynamic_bitset<>(a).and_not(b);
+    const dynamic_bitset<> bnot    = ~a;
+
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(band[i], a[i] && b[i]);
+        ASSERT_EQ(bor[i], a[i] || b[i]);
+        ASSERT_EQ(bxor[i], a[i] != b[i]);
+        ASSERT_EQ(bandnot[i], a[i] && !b[i]);
+        ASSERT_EQ(bnot[i], !a[i]);
+    }
+
+    ASSERT_EQ(bnot.count(), 1000 - a.count());
+    ASSERT_EQ(band.count() + bor.count(), a.count() + b.count());
+}
+
+TEST(dynamic_bitset, find_rank_select) {
+    for (const unsigned density : {1u, 50u, 99u}) {
+        const auto bools         = make_bools(5000, density);
+        const dynamic_bitset<> b = make_bitset(bools);
+        const bitset_rank_index<> index(b);
+        ASSERT_EQ(index.count(), b.count());
+
+        size_t ones = 0;
+        size_t next = b.find_first();
+
+        for (size_t i = 0; i < bools.size(); ++i) {
+            ASSERT_EQ(b.rank(i), ones);
+            ASSERT_EQ(index.rank(i), ones);
+
+            if (bools[i]) {
+                ASSERT_EQ(next, i);
+                ASSERT_EQ(b.select(ones), i);
+                ASSERT_EQ(index.select(ones), i);
+
+                next = b.find_next(i + 1);
+                ++ones;
+            }
+        }
+
+        ASSERT_EQ(next, b.size());
+        ASSERT_EQ(b.rank(b.size()), ones);
+        ASSERT_EQ(index.rank(b.size()), ones);
+        ASSERT_EQ(b.select(ones), b.size());
+        ASSERT_EQ(index.select(ones), b.size());
+    }
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <ciel/find.hpp>
+#include <ciel/inplace_vector.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <list>
+
+using namespace ciel;
+
+namespace {
+
+template<class T>
+void test_find_impl(::testing::Test*) {
+    // Every length around the vector widths, every position of the match.
+    for (size_t n = 0; n < 150; ++n) {
+        for (size_t pos = 0; pos <= n; ++pos) {
+            vector<T> v(n, T(1));
+            if (pos != n) {
+                v[pos] = T(2);
+            }
+
+            ASSERT_EQ(ciel::find(v, T(2)), v.begin() + pos);
+            ASSERT_EQ(ciel::contains(v, T(2)), pos != n);
+            ASSERT_EQ(ciel::count(v, T(1)), pos != n ? n - 1 : n);
+        }
+    }
+
+    vector<T> v(1000);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = T(i % 100);
+    }
+
+    const vector<T>& cv = v;
+    ASSERT_EQ(ciel::find(cv, T(42)), cv.begin() + 42);
+    ASSERT_EQ(ciel::count(cv, T(42)), 10);
+    ASSERT_FALSE(ciel::contains(cv, T(100)));
+}
+
+template<class T>
+void test_find_first_of_impl(::testing::Test*) {
+    for (size_t n = 0; n < 100; ++n) {
+        vector<T> v(n);
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = T(i);
+        }
+
+        const vector<T> values{T(200), T(n / 2), T(n / 3), T(300)};
+
+        ASSERT_EQ(ciel::find_first_of(v, values),
+                  std::find_first_of(v.begin(), v.end(), values.begin(), values.end()));
+    }
+}
+
+} // namespace
+
+TEST(find, arithmetic) {
+    test_find_impl<char>(this);
+    test_find_impl<int8_t>(this);
+    test_find_impl<uint16_t>(this);
+    test_find_impl<int32_t>(this);
+    test_find_impl<uint32_t>(this);
+    test_find_impl<int64_t>(this);
+    test_find_impl<float>(this);
+    test_find_impl<double>(this);
+}
+
+TEST(find, find_first_of) {
+    test_find_first_of_impl<char>(this);
+    test_find_first_of_impl<uint16_t>(this);
+    test_find_first_of_impl<uint32_t>(this);
+    test_find_first_of_impl<uint64_t>(this);
+    test_find_first_of_impl<double>(this);
+
+    // More than 16 values.
+    const vector<int> v{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+    const vector<int> values{30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 19, 20};
+    ASSERT_EQ(ciel::find_first_of(v, values), v.begin() + 19);
+}
+
+TEST(find, mixed_types) {
+    const vector<uint8_t> v{0, 1, 2, 255};
+
+    // Same as comparing with operator==, where uint8_t is promoted to int.
+    ASSERT_EQ(ciel::find(v, 255), v.begin() + 3);
+    ASSERT_EQ(ciel::find(v, -1), v.end());
+    ASSERT_EQ(ciel::find(v, 256 + 1), v.end());
+    ASSERT_EQ(ciel::count(v, -1), 0);
+
+    const vector<uint32_t> v2{0, 1, std::numeric_limits<uint32_t>::max()};
+
+    // -1 is converted to uint32_t.
+    ASSERT_EQ(ciel::find(v2, -1), v2.begin() + 2);
+    ASSERT_EQ(ciel::find(v2, int64_t{-1}), v2.end());
+
+    const vector<int16_t> v3{-1, 0, 1};
+    ASSERT_EQ(ciel::find(v3, uint16_t{65535}), v3.end());
+}
+
+TEST(find, floating_point) {
+    const vector<double> v{1.0, -0.0, std::numeric_limits<double>::quiet_NaN(), 2.0};
+
+    ASSERT_EQ(ciel::find(v, 0.0), v.begin() + 1);
+    ASSERT_EQ(ciel::find(v, std::numeric_limits<double>::quiet_NaN()), v.end());
+    ASSERT_EQ(ciel::count(v, 2.0), 1);
+}
+
+TEST(find, inplace_vector) {
+    inplace_vector<char, 64> v(50, 'a');
+    v[33] = 'b';
+
+    ASSERT_EQ(ciel::find(v, 'b'), v.begin() + 33);
+    ASSERT_EQ(ciel::count(v, 'a'), 49);
+    ASSERT_TRUE(ciel::contains(v, 'b'));
+    ASSERT_EQ(ciel::find_first_of(v, std::initializer_list<char>({'c', 'b'})), v.begin() + 33);
+}
+
+TEST(find, fallback) {
+    const std::list<int> l{0, 1, 2, 3};
+
+    ASSERT_EQ(ciel::find(l, 2), std::next(l.begin(), 2));
+    ASSERT_EQ(ciel::count(l, 2), 1);
+    ASSERT_TRUE(ciel::contains(l, 3));
+}
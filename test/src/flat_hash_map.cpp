@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <ciel/flat_hash_map.hpp>
+#include <ciel/test/int_wrapper.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+struct int_hash {
+    size_t operator()(const int i) const noexcept {
+        return std::hash<int>()(i);
+    }
+
+}; // struct int_hash
+
+// Copying may allocate, and there is no move constructor.
+struct copy_only_hash {
+    copy_only_hash() = default;
+
+    copy_only_hash(const copy_only_hash&) {}
+
+    copy_only_hash& operator=(const copy_only_hash&) {
+        return *this;
+    }
+
+    size_t operator()(const int i) const noexcept {
+        return std::hash<int>()(i);
+    }
+
+}; // struct copy_only_hash
+
+template<class M>
+void test_insert_impl(::testing::Test*) {
+    M m;
+    ASSERT_TRUE(m.empty());
+
+    ASSERT_TRUE(m.insert({3, 30}).second);
+    ASSERT_TRUE(m.emplace(1, 10).second);
+    ASSERT_TRUE(m.try_emplace(2, 20).second);
+    ASSERT_FALSE(m.try_emplace(2, 21).second);
+    ASSERT_FALSE(m.insert({1, 11}).second);
+    ASSERT_EQ(m.size(), 3);
+    ASSERT_EQ(m.at(1), 10);
+    ASSERT_EQ(m.at(2), 20);
+
+    ASSERT_FALSE(m.insert_or_assign(2, 22).second);
+    ASSERT_EQ(m.at(2), 22);
+    m[4] = 40;
+    ASSERT_EQ(m.size(), 4);
+    ASSERT_EQ(m[4], 40);
+
+    ASSERT_TRUE(m.contains(3));
+    ASSERT_FALSE(m.contains(5));
+    ASSERT_EQ(m.find(5), m.end());
+    ASSERT_EQ(m.find(3)->second, 30);
+
+    m.find(3)->second = 33;
+    ASSERT_EQ(m.at(3), 33);
+
+    ASSERT_EQ(m.erase(2), 1);
+    ASSERT_EQ(m.erase(2), 0);
+    ASSERT_EQ(m.size(), 3);
+
+    m.clear();
+    ASSERT_TRUE(m.empty());
+}
+
+template<class M>
+void test_grow_impl(::testing::Test*) {
+    M m;
+
+    for (int i = 0; i < 10000; ++i) {
+        m[i] = i * 2;
+
+        if (i % 3 == 0) {
+            ASSERT_EQ(m.erase(i / 2), 1);
+        }
+    }
+
+    for (const auto& p : m) {
+        ASSERT_EQ(p.second, p.first * 2);
+    }
+
+    for (int i = 0; i < 10000; ++i) {
+        const auto it = m.find(i);
+        if (it != m.end()) {
+            ASSERT_EQ(it->second, i * 2);
+        }
+    }
+}
+
+} // namespace
+
+TEST(flat_hash_map, insert) {
+    test_insert_impl<flat_hash_map<int, int>>(this);
+    test_insert_impl<flat_hash_map<Int, Int, int_hash>>(this);
+    test_insert_impl<flat_hash_map<TRInt, TMInt, int_hash>>(this);
+}
+
+TEST(flat_hash_map, grow) {
+    test_grow_impl<flat_hash_map<int, int>>(this);
+    test_grow_impl<flat_hash_map<Int, Int, int_hash>>(this);
+    test_grow_impl<flat_hash_map<TRInt, TRInt, int_hash>>(this);
+    test_grow_impl<flat_hash_map<TMInt, TMInt, int_hash>>(this);
+}
+
+TEST(flat_hash_map, string) {
+    flat_hash_map<std::string, std::string> m{{"b", "2"}, {"a", "1"}, {"c", "3"}};
+
+    for (auto& p : m) {
+        p.second += "!";
+    }
+    ASSERT_EQ(m.at("a"), "1!");
+
+    for (int i = 0; i < 1000; ++i) {
+        m[std::to_string(i)] = std::to_string(i * 2);
+    }
+    ASSERT_EQ(m.size(), 1003);
+    ASSERT_EQ(m["999"], "1998");
+    ASSERT_EQ(m["c"], "3!");
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(CIEL_UNUSED(m.at("x")), std::out_of_range);
+#endif
+}
+
+TEST(flat_hash_map, constructor) {
+    const flat_hash_map<int, int> m1{{1, 10}, {2, 20}};
+
+    flat_hash_map<int, int> m2(m1);
+    ASSERT_EQ(m2, m1);
+
+    m2[2] = 21;
+    ASSERT_NE(m2, m1);
+
+    flat_hash_map<int, int> m3(std::move(m2));
+    ASSERT_TRUE(m2.empty());
+    ASSERT_EQ(m3.at(2), 21);
+
+    m2 = m1;
+    ASSERT_EQ(m2, m1);
+
+    const auto is_odd = [](const std::pair<const int, int>& p) {
+        return p.first % 2 == 1;
+    };
+    ASSERT_EQ(erase_if(m2, is_odd), 1);
+    ASSERT_EQ(m2, (flat_hash_map<int, int>{{2, 20}}));
+}
+
+TEST(flat_hash_map, move_noexcept) {
+    static_assert(std::is_nothrow_move_constructible<flat_hash_map<int, int>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<flat_hash_map<int, int>>::value, "");
+
+    // Moving the table moves its hasher.
+    static_assert(!std::is_nothrow_move_constructible<flat_hash_map<int, int, copy_only_hash>>::value, "");
+    static_assert(!std::is_nothrow_move_assignable<flat_hash_map<int, int, copy_only_hash>>::value, "");
+
+    flat_hash_map<int, int, copy_only_hash> m1{{1, 10}, {2, 20}};
+    flat_hash_map<int, int, copy_only_hash> m2(std::move(m1));
+    ASSERT_EQ(m2.at(2), 20);
+
+    m1 = std::move(m2);
+    ASSERT_EQ(m1.at(1), 10);
+}
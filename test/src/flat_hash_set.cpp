@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <ciel/flat_hash_set.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+struct int_hash {
+    size_t operator()(const int i) const noexcept {
+        return std::hash<int>()(i);
+    }
+
+}; // struct int_hash
+
+struct transparent_hash {
+    using is_transparent = void;
+
+    size_t operator()(const std::string& s) const noexcept {
+        return std::hash<std::string>()(s);
+    }
+
+    size_t operator()(const char* s) const noexcept {
+        return std::hash<std::string>()(s);
+    }
+
+}; // struct transparent_hash
+
+struct transparent_equal {
+    using is_transparent = void;
+
+    template<class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const {
+        return lhs == rhs;
+    }
+
+}; // struct transparent_equal
+
+template<class S>
+void test_insert_impl(::testing::Test*) {
+    S s;
+    ASSERT_TRUE(s.empty());
+    ASSERT_EQ(s.begin(), s.end());
+    ASSERT_FALSE(s.contains(1));
+
+    ASSERT_TRUE(s.insert(3).second);
+    ASSERT_TRUE(s.insert(1).second);
+    ASSERT_TRUE(s.emplace(2).second);
+    ASSERT_FALSE(s.insert(1).second);
+    ASSERT_EQ(s.size(), 3);
+    ASSERT_EQ(std::distance(s.begin(), s.end()), 3);
+
+    ASSERT_TRUE(s.contains(2));
+    ASSERT_FALSE(s.contains(5));
+    ASSERT_EQ(s.count(3), 1);
+    ASSERT_EQ(s.find(5), s.end());
+    ASSERT_EQ(*s.find(3), 3);
+
+    ASSERT_EQ(s.erase(2), 1);
+    ASSERT_EQ(s.erase(2), 0);
+    s.erase(s.find(1));
+    ASSERT_EQ(s.size(), 1);
+    ASSERT_EQ(*s.begin(), 3);
+
+    s.clear();
+    ASSERT_TRUE(s.empty());
+    ASSERT_EQ(s.begin(), s.end());
+}
+
+// Grows through many rehashes with erasures in between, which leave deleted slots behind.
+template<class S>
+void test_grow_impl(::testing::Test*) {
+    S s;
+
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_TRUE(s.insert(i).second);
+
+        if (i % 3 == 0) {
+            ASSERT_EQ(s.erase(i / 2), 1);
+        }
+    }
+
+    ciel::vector<bool> seen(10000, false);
+    for (const int i : s) {
+        ASSERT_FALSE(seen[i]);
+        seen[i] = true;
+    }
+
+    size_t count = 0;
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(seen[i], s.contains(i));
+        count += seen[i];
+    }
+    ASSERT_EQ(count, s.size());
+    ASSERT_LE(s.load_factor(), s.max_load_factor());
+}
+
+} // namespace
+
+TEST(flat_hash_set, insert) {
+    test_insert_impl<flat_hash_set<int>>(this);
+    test_insert_impl<flat_hash_set<Int, int_hash>>(this);
+    test_insert_impl<flat_hash_set<TRInt, int_hash>>(this);
+    test_insert_impl<flat_hash_set<TMInt, int_hash>>(this);
+}
+
+TEST(flat_hash_set, grow) {
+    test_grow_impl<flat_hash_set<int>>(this);
+    test_grow_impl<flat_hash_set<Int, int_hash>>(this);
+    test_grow_impl<flat_hash_set<TRInt, int_hash>>(this);
+    test_grow_impl<flat_hash_set<TMInt, int_hash>>(this);
+}
+
+TEST(flat_hash_set, constructor) {
+    const flat_hash_set<int> s1{5, 1, 3, 1};
+    ASSERT_EQ(s1.size(), 3);
+
+    const ciel::vector<int> v{3, 5, 1};
+    flat_hash_set<int> s2(v.begin(), v.end());
+    ASSERT_EQ(s1, s2);
+
+    flat_hash_set<int> s3(s2);
+    ASSERT_EQ(s3, s2);
+
+    const flat_hash_set<int> s4(std::move(s3));
+    ASSERT_EQ(s4, s1);
+    ASSERT_TRUE(s3.empty());
+
+    s3 = s4;
+    ASSERT_EQ(s3, s4);
+    s3 = {7};
+    ASSERT_NE(s3, s4);
+
+    s2 = std::move(s3);
+    ASSERT_EQ(s2, flat_hash_set<int>{7});
+
+    std::swap(s2, s3);
+    ASSERT_TRUE(s2.empty());
+    ASSERT_TRUE(s3.contains(7));
+}
+
+TEST(flat_hash_set, reserve) {
+    flat_hash_set<int> s;
+    s.reserve(1000);
+
+    const auto capacity = s.capacity();
+    ASSERT_GE(capacity, 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        s.insert(i);
+    }
+    ASSERT_EQ(s.capacity(), capacity);
+
+    for (int i = 0; i < 990; ++i) {
+        s.erase(i);
+    }
+
+    s.rehash(0);
+    ASSERT_LT(s.capacity(), capacity);
+    ASSERT_EQ(s.size(), 10);
+    ASSERT_TRUE(s.contains(995));
+
+    s.clear();
+    s.rehash(0);
+    ASSERT_EQ(s.capacity(), 0);
+}
+
+TEST(flat_hash_set, erase_if) {
+    flat_hash_set<int> s{1, 2, 3, 4, 5, 6, 7};
+
+    const auto is_even = [](int i) {
+        return i % 2 == 0;
+    };
+    ASSERT_EQ(erase_if(s, is_even), 3);
+    ASSERT_EQ(s, flat_hash_set<int>({1, 3, 5, 7}));
+}
+
+TEST(flat_hash_set, transparent) {
+    flat_hash_set<std::string, transparent_hash, transparent_equal> s{"a", "bc", "def"};
+
+    ASSERT_TRUE(s.contains("bc"));
+    ASSERT_EQ(s.count("a"), 1);
+    ASSERT_EQ(s.find("x"), s.end());
+    ASSERT_EQ(s.erase("def"), 1);
+    ASSERT_EQ(s.size(), 2);
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+
+#include <ciel/flat_map.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/test/propagate_allocator.hpp>
+#include <ciel/vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class M>
+void test_insert_impl(::testing::Test*) {
+    M m;
+    ASSERT_TRUE(m.empty());
+
+    ASSERT_TRUE(m.insert({3, 30}).second);
+    ASSERT_TRUE(m.emplace(1, 10).second);
+    ASSERT_TRUE(m.try_emplace(2, 20).second);
+    ASSERT_FALSE(m.try_emplace(2, 21).second);
+    ASSERT_FALSE(m.insert({1, 11}).second);
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({1, 2, 3}));
+    ASSERT_EQ(m.values(), std::initializer_list<int>({10, 20, 30}));
+
+    ASSERT_FALSE(m.insert_or_assign(2, 22).second);
+    ASSERT_EQ(m.at(2), 22);
+    m[4] = 40;
+    ASSERT_EQ(m.size(), 4);
+    ASSERT_EQ(m[4], 40);
+
+    ASSERT_TRUE(m.contains(3));
+    ASSERT_FALSE(m.contains(5));
+    ASSERT_EQ(m.count(3), 1);
+    ASSERT_EQ(m.find(5), m.end());
+    ASSERT_EQ(m.find(3)->second, 30);
+    ASSERT_EQ(m.lower_bound(2)->first, 2);
+    ASSERT_EQ(m.upper_bound(2)->first, 3);
+
+    m.find(3)->second = 33;
+    ASSERT_EQ(m.at(3), 33);
+
+    ASSERT_EQ(m.erase(2), 1);
+    ASSERT_EQ(m.erase(2), 0);
+    ASSERT_EQ(m.erase(m.begin())->first, 3);
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({3, 4}));
+    ASSERT_EQ(m.values(), std::initializer_list<int>({33, 40}));
+
+    m.clear();
+    ASSERT_TRUE(m.empty());
+}
+
+} // namespace
+
+TEST(flat_map, insert) {
+    test_insert_impl<flat_map<int, int>>(this);
+    test_insert_impl<flat_map<Int, Int>>(this);
+    test_insert_impl<flat_map<TRInt, TMInt>>(this);
+}
+
+TEST(flat_map, iterator) {
+    flat_map<int, std::string> m{{2, "b"}, {1, "a"}, {3, "c"}};
+
+    ASSERT_EQ(m.end() - m.begin(), 3);
+    ASSERT_EQ(m.begin()->second, "a");
+    ASSERT_EQ(m.rbegin()->second, "c");
+    ASSERT_EQ((*(m.begin() + 1)).first, 2);
+    ASSERT_EQ(m.begin()[2].second, "c");
+
+    std::string s;
+    for (auto p : m) {
+        s += p.second;
+        p.second += "!";
+    }
+    ASSERT_EQ(s, "abc");
+    ASSERT_EQ(m.at(1), "a!");
+
+    const flat_map<int, std::string>& cm = m;
+    flat_map<int, std::string>::const_iterator it = m.begin();
+    ASSERT_EQ(it, cm.begin());
+    ASSERT_EQ(std::distance(it, cm.end()), 3);
+    static_assert(std::is_same<decltype(cm.begin()->second), const std::string&>::value, "");
+}
+
+TEST(flat_map, insert_range) {
+    flat_map<int, int> m{{1, 1}, {5, 5}, {9, 9}};
+
+    // The old element wins, then the first one among the new ones.
+    m.insert_range(vector<std::pair<int, int>>{{7, 7}, {5, 50}, {3, 3}, {3, 30}, {11, 11}, {0, 0}});
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({0, 1, 3, 5, 7, 9, 11}));
+    ASSERT_EQ(m.values(), std::initializer_list<int>({0, 1, 3, 5, 7, 9, 11}));
+
+    const auto key_is_odd = [](std::pair<const int&, int&> p) {
+        return p.first % 2 == 1;
+    };
+    ASSERT_EQ(erase_if(m, key_is_odd), 6);
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({0}));
+}
+
+TEST(flat_map, insert_range_move_only) {
+    flat_map<int, std::unique_ptr<int>> m;
+
+    vector<std::pair<int, std::unique_ptr<int>>> v;
+    v.emplace_back(2, new int(2));
+    v.emplace_back(1, new int(1));
+    v.emplace_back(2, new int(3));
+
+    m.insert_range(std::move(v));
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({1, 2}));
+    ASSERT_EQ(*m.at(1), 1);
+    ASSERT_EQ(*m.at(2), 2);
+}
+
+TEST(flat_map, insert_range_keeps_allocator) {
+    // Propagated on move assignment and swap, so that the temporary containers' allocators would replace them.
+    using allocator        = propagate_allocator<int, false, true, true>;
+    using key_container    = vector<int, allocator>;
+    using mapped_container = vector<int, allocator>;
+
+    flat_map<int, int, std::less<int>, key_container, mapped_container> m(key_container(allocator(1)),
+                                                                          mapped_container(allocator(2)));
+
+    m.insert_range(vector<std::pair<int, int>>{{3, 3}, {1, 1}, {2, 2}});
+    ASSERT_EQ(m.keys(), std::initializer_list<int>({1, 2, 3}));
+    ASSERT_EQ(m.keys().get_allocator().id(), 1);
+    ASSERT_EQ(m.values().get_allocator().id(), 2);
+}
+
+TEST(flat_map, constructor) {
+    const flat_map<int, int> m1(vector<int>{3, 1, 2, 1}, vector<int>{30, 10, 20, 11});
+    ASSERT_EQ(m1.keys(), std::initializer_list<int>({1, 2, 3}));
+    ASSERT_EQ(m1.values(), std::initializer_list<int>({10, 20, 30}));
+
+    const flat_map<int, int> m2(sorted_unique, vector<int>{1, 2}, vector<int>{10, 20});
+    ASSERT_EQ(m2.at(2), 20);
+
+    flat_map<int, int> m3(m1.begin(), m1.end());
+    ASSERT_EQ(m3, m1);
+
+    m3 = {{5, 50}};
+    ASSERT_EQ(m3.size(), 1);
+
+    flat_map<int, int> m4(from_range, m1);
+    m4.swap(m3);
+    ASSERT_EQ(m3, m1);
+
+    auto conts = std::move(m3).extract();
+    ASSERT_TRUE(m3.empty());
+    ASSERT_EQ(conts.keys, std::initializer_list<int>({1, 2, 3}));
+
+    m3.replace(std::move(conts.keys), std::move(conts.values));
+    ASSERT_EQ(m3, m1);
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+namespace {
+
+// Throws on the countdown-th comparison, if countdown isn't 0.
+struct throwing_less {
+    static size_t countdown;
+
+    bool operator()(const int lhs, const int rhs) const {
+        if (countdown != 0 && --countdown == 0) {
+            throw 0;
+        }
+
+        return lhs < rhs;
+    }
+
+}; // struct throwing_less
+
+size_t throwing_less::countdown = 0;
+
+} // namespace
+
+TEST(flat_map, insert_comparator_throws) {
+    const vector<std::pair<int, int>> v{{8, 8}, {7, 7}, {6, 6}, {4, 4}, {3, 3}, {2, 2}};
+    bool kept  = false;
+    bool clear = false;
+
+    for (size_t n = 1;; ++n) {
+        flat_map<int, int, throwing_less> m{{1, 1}, {5, 5}, {9, 9}};
+
+        throwing_less::countdown = n;
+        try {
+            m.insert(v.begin(), v.end());
+
+        } catch (int) {
+            // Either the new elements are dropped, or it's cleared if they were already being merged.
+            kept  = kept || m.keys() == std::initializer_list<int>({1, 5, 9});
+            clear = clear || m.empty();
+            ASSERT_EQ(m.keys().size(), m.values().size());
+            ASSERT_TRUE(m.empty() || m.values() == std::initializer_list<int>({1, 5, 9}));
+            continue;
+        }
+
+        throwing_less::countdown = 0;
+        ASSERT_EQ(m.keys(), std::initializer_list<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        ASSERT_EQ(m.values(), std::initializer_list<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        break;
+    }
+
+    ASSERT_TRUE(kept);
+    ASSERT_TRUE(clear);
+}
+#endif
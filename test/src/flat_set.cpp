@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <ciel/flat_set.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+struct transparent_less {
+    using is_transparent = void;
+
+    template<class T, class U>
+    bool operator()(const T& lhs, const U& rhs) const {
+        return lhs < rhs;
+    }
+
+}; // struct transparent_less
+
+template<class S>
+void test_insert_impl(::testing::Test*) {
+    S s;
+    ASSERT_TRUE(s.empty());
+
+    ASSERT_TRUE(s.insert(3).second);
+    ASSERT_TRUE(s.insert(1).second);
+    ASSERT_TRUE(s.emplace(2).second);
+    ASSERT_FALSE(s.insert(1).second);
+    ASSERT_EQ(s, std::initializer_list<int>({1, 2, 3}));
+
+    ASSERT_EQ(*s.insert(s.end(), 0), 0);
+    ASSERT_EQ(s.size(), 4);
+
+    ASSERT_TRUE(s.contains(2));
+    ASSERT_FALSE(s.contains(5));
+    ASSERT_EQ(s.count(3), 1);
+    ASSERT_EQ(s.find(5), s.end());
+    ASSERT_EQ(*s.lower_bound(2), 2);
+    ASSERT_EQ(*s.upper_bound(2), 3);
+    ASSERT_EQ(std::distance(s.equal_range(2).first, s.equal_range(2).second), 1);
+
+    ASSERT_EQ(s.erase(2), 1);
+    ASSERT_EQ(s.erase(2), 0);
+    ASSERT_EQ(*s.erase(s.begin()), 1);
+    ASSERT_EQ(s, std::initializer_list<int>({1, 3}));
+
+    s.clear();
+    ASSERT_TRUE(s.empty());
+}
+
+} // namespace
+
+TEST(flat_set, insert) {
+    test_insert_impl<flat_set<int>>(this);
+    test_insert_impl<flat_set<Int>>(this);
+    test_insert_impl<flat_set<TRInt>>(this);
+}
+
+TEST(flat_set, constructor) {
+    const flat_set<int> s1{5, 3, 1, 3, 5, 2};
+    ASSERT_EQ(s1, std::initializer_list<int>({1, 2, 3, 5}));
+
+    const flat_set<int, std::greater<int>> s2(vector<int>{5, 3, 1, 3, 5, 2});
+    ASSERT_EQ(s2, std::initializer_list<int>({5, 3, 2, 1}));
+
+    const flat_set<int> s3(sorted_unique, vector<int>{1, 2, 3});
+    ASSERT_EQ(s3.size(), 3);
+
+    const vector<int> v{4, 4, 0};
+    flat_set<int> s4(from_range, v);
+    ASSERT_EQ(s4, std::initializer_list<int>({0, 4}));
+
+    flat_set<int> s5 = s1;
+    s5               = {9, 8};
+    ASSERT_EQ(s5, std::initializer_list<int>({8, 9}));
+
+    s5.swap(s4);
+    ASSERT_EQ(s5, std::initializer_list<int>({0, 4}));
+
+    const vector<int> c = std::move(s5).extract();
+    ASSERT_EQ(c, std::initializer_list<int>({0, 4}));
+    ASSERT_TRUE(s5.empty());
+}
+
+TEST(flat_set, insert_range) {
+    flat_set<int> s{1, 5, 9};
+
+    s.insert_range(vector<int>{7, 5, 3, 3, 11, 0});
+    ASSERT_EQ(s, std::initializer_list<int>({0, 1, 3, 5, 7, 9, 11}));
+
+    const vector<int> sorted{2, 4, 5};
+    s.insert(sorted_unique, sorted.begin(), sorted.end());
+    ASSERT_EQ(s, std::initializer_list<int>({0, 1, 2, 3, 4, 5, 7, 9, 11}));
+
+    const auto is_even = [](int i) {
+        return i % 2 == 0;
+    };
+    ASSERT_EQ(erase_if(s, is_even), 3);
+    ASSERT_EQ(s, std::initializer_list<int>({1, 3, 5, 7, 9, 11}));
+}
+
+TEST(flat_set, transparent) {
+    flat_set<std::string, transparent_less> s{"a", "bc", "def"};
+
+    ASSERT_TRUE(s.contains("bc"));
+    ASSERT_EQ(s.count("a"), 1);
+    ASSERT_EQ(s.find("x"), s.end());
+    ASSERT_EQ(*s.lower_bound("b"), "bc");
+}
+
+TEST(flat_set, insert_keeps_first_equivalent) {
+    const auto first_less = [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    flat_set<std::pair<int, int>, decltype(first_less)> s({{3, -1}}, first_less);
+
+    // Enough equivalent keys that an unstable sort would reorder them.
+    vector<std::pair<int, int>> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i % 10, i);
+    }
+    s.insert(v.begin(), v.end());
+
+    ASSERT_EQ(s.size(), 10);
+    for (const auto& p : s) {
+        ASSERT_EQ(p.second, p.first == 3 ? -1 : p.first);
+    }
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+namespace {
+
+// Throws on the countdown-th comparison, if countdown isn't 0.
+struct throwing_less {
+    static size_t countdown;
+
+    bool operator()(const int lhs, const int rhs) const {
+        if (countdown != 0 && --countdown == 0) {
+            throw 0;
+        }
+
+        return lhs < rhs;
+    }
+
+}; // struct throwing_less
+
+size_t throwing_less::countdown = 0;
+
+} // namespace
+
+TEST(flat_set, insert_comparator_throws) {
+    const vector<int> v{8, 7, 6, 4, 3, 2};
+    bool kept  = false;
+    bool clear = false;
+
+    for (size_t n = 1;; ++n) {
+        flat_set<int, throwing_less> s{1, 5, 9};
+
+        throwing_less::countdown = n;
+        try {
+            s.insert(v.begin(), v.end());
+
+        } catch (int) {
+            // Either the new keys are dropped, or it's cleared if the keys were already mixed up.
+            kept  = kept || s == std::initializer_list<int>({1, 5, 9});
+            clear = clear || s.empty();
+            ASSERT_TRUE(s.empty() || s == std::initializer_list<int>({1, 5, 9}));
+            continue;
+        }
+
+        throwing_less::countdown = 0;
+        ASSERT_EQ(s, std::initializer_list<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+        break;
+    }
+
+    ASSERT_TRUE(kept);
+    ASSERT_TRUE(clear);
+}
+#endif
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/core/alignment.hpp>
+#include <ciel/huge_page_allocator.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace ciel;
+
+TEST(huge_page_allocator, allocate_at_least) {
+    huge_page_allocator<int> alloc;
+
+    {
+        const auto res = alloc.allocate_at_least(100);
+        ASSERT_EQ(res.count, 100);
+
+        alloc.deallocate(res.ptr, res.count);
+    }
+    {
+        const size_t n = huge_page_size / sizeof(int) + 1;
+        const auto res = alloc.allocate_at_least(n);
+        ASSERT_GE(res.count, n);
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+        ASSERT_EQ(res.count, huge_page_size * 2 / sizeof(int));
+        ASSERT_TRUE(ciel::is_aligned(res.ptr, huge_page_size));
+#endif
+
+        // The whole block is usable.
+        for (size_t i = 0; i < res.count; i += 1024) {
+            res.ptr[i] = static_cast<int>(i);
+        }
+        res.ptr[res.count - 1] = 0;
+
+        alloc.deallocate(res.ptr, res.count);
+    }
+}
+
+#ifdef CIEL_HAS_HUGE_PAGE_MMAP
+TEST(huge_page_allocator, reallocate_at_least) {
+    static_assert(allocator_has_reallocate_at_least<huge_page_allocator<int>>::value, "");
+
+    // sizeof(T) doesn't divide huge_page_size.
+    struct Triple {
+        uint32_t a, b, c;
+    };
+
+    huge_page_allocator<Triple> alloc;
+
+    auto res = alloc.allocate_at_least(10);
+    for (size_t i = 0; i < 10; ++i) {
+        res.ptr[i].a = static_cast<uint32_t>(i);
+    }
+
+    // Grow to be mapped.
+    res = alloc.reallocate_at_least(res.ptr, res.count, huge_page_size / sizeof(Triple) * 3);
+    ASSERT_TRUE(ciel::is_aligned(res.ptr, huge_page_size));
+    ASSERT_EQ(res.count, huge_page_size * 3 / sizeof(Triple));
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(res.ptr[i].a, i);
+    }
+    res.ptr[res.count - 1].a = 42;
+
+    // Grow through remapping.
+    res = alloc.reallocate_at_least(res.ptr, res.count, huge_page_size / sizeof(Triple) * 7);
+    ASSERT_TRUE(ciel::is_aligned(res.ptr, huge_page_size));
+    ASSERT_EQ(res.count, huge_page_size * 7 / sizeof(Triple));
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(res.ptr[i].a, i);
+    }
+    ASSERT_EQ(res.ptr[huge_page_size * 3 / sizeof(Triple) - 1].a, 42);
+
+    // Shrink, it's still mapped with at least one huge page.
+    res = alloc.reallocate_at_least(res.ptr, res.count, 10);
+    ASSERT_EQ(res.count, huge_page_size / sizeof(Triple));
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(res.ptr[i].a, i);
+    }
+
+    alloc.deallocate(res.ptr, res.count);
+}
+#endif
+
+TEST(huge_page_allocator, vector) {
+    const size_t n = huge_page_size / sizeof(size_t) * 3;
+
+    vector<size_t, huge_page_allocator<size_t>> v;
+
+    for (size_t i = 0; i < n; ++i) {
+        v.emplace_back(i);
+    }
+
+    v.erase(v.begin() + 10, v.end());
+    v.shrink_to_fit();
+    ASSERT_EQ(v.size(), 10);
+
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(v[i], i);
+    }
+
+    v.resize(n, default_init);
+    v.back() = 42;
+    ASSERT_EQ(v[9], 9);
+}
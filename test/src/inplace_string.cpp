@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/inplace_string.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if CIEL_STD_VER >= 17
+#  include <string_view>
+#endif
+
+using namespace ciel;
+
+static_assert(sizeof(inplace_string<31>) == 33, "");
+static_assert(std::is_trivially_copyable<inplace_string<31>>::value, "");
+static_assert(is_trivially_relocatable<inplace_string<31>>::value, "");
+
+TEST(inplace_string, constructor) {
+    const inplace_string<8> empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.size(), 0);
+    ASSERT_STREQ(empty.c_str(), "");
+
+    const inplace_string<8> s("key");
+    ASSERT_EQ(s.size(), 3);
+    ASSERT_EQ(s, "key");
+    ASSERT_STREQ(s.c_str(), "key");
+
+    const inplace_string<8> full(8, 'a');
+    ASSERT_EQ(full, "aaaaaaaa");
+    ASSERT_EQ(full.c_str()[8], '\0');
+
+    const inplace_string<16> wider(s);
+    ASSERT_EQ(wider, s);
+
+    ASSERT_EQ(inplace_string<8>(std::string("abc")), "abc");
+    ASSERT_EQ(inplace_string<8>({'a', 'b'}), "ab");
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(inplace_string<2>("abc"), std::length_error);
+#endif
+}
+
+TEST(inplace_string, append) {
+    inplace_string<16> s;
+
+    s += "user";
+    s += ':';
+    s.append_to_chars(uint32_t{42});
+    s.push_back('/');
+    s.append_to_chars(-7);
+    ASSERT_EQ(s, "user:42/-7");
+    ASSERT_STREQ(s.c_str(), "user:42/-7");
+
+    s.pop_back();
+    s.append(2, '0');
+    ASSERT_EQ(s, "user:42/-00");
+
+    s.resize(4);
+    ASSERT_EQ(s, "user");
+    s.resize(6, '.');
+    ASSERT_EQ(s, "user..");
+
+    s.clear();
+    ASSERT_TRUE(s.empty());
+    ASSERT_STREQ(s.c_str(), "");
+
+    // Falls back to a temporary buffer when the widest value may not fit, but the actual one does.
+    inplace_string<4> small("ab");
+    small.append_to_chars(12);
+    ASSERT_EQ(small, "ab12");
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(small.append_to_chars(1), std::length_error);
+    ASSERT_THROW(small.push_back('c'), std::length_error);
+    ASSERT_EQ(small, "ab12");
+#endif
+
+    inplace_string<32> formatted;
+    formatted.append_to_chars(true);
+    formatted += ',';
+    formatted.append_to_chars(UINT64_MAX);
+    ASSERT_EQ(formatted, "true,18446744073709551615");
+}
+
+TEST(inplace_string, assign_self) {
+    inplace_string<16> s("abcdef");
+
+    s = s.c_str();
+    ASSERT_EQ(s, "abcdef");
+
+    s.assign(s.data() + 1, 4);
+    ASSERT_EQ(s, "bcde");
+    ASSERT_STREQ(s.c_str(), "bcde");
+
+    s.assign(s.data() + 2);
+    ASSERT_EQ(s, "de");
+
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(s.assign("0123456789abcdefg"), std::length_error);
+    ASSERT_EQ(s, "de");
+#endif
+}
+
+TEST(inplace_string, compare) {
+    const inplace_string<8> a("abc");
+    const inplace_string<16> b("abd");
+
+    ASSERT_TRUE(a < b);
+    ASSERT_TRUE(a != b);
+    ASSERT_TRUE(a <= "abc");
+    ASSERT_TRUE("ab" < a);
+    ASSERT_TRUE(a > "ab");
+    ASSERT_EQ(a.compare("abc"), 0);
+    ASSERT_LT(a.compare("abcd"), 0);
+    ASSERT_GT(b.compare(a), 0);
+
+    // Compared as unsigned char, the same as std::string.
+    const inplace_string<8> high("\xff");
+    ASSERT_TRUE(a < high);
+    ASSERT_EQ(a < high, std::string("abc") < std::string("\xff"));
+
+    ASSERT_EQ(a.find('c'), 2);
+    ASSERT_EQ(a.find('z'), inplace_string<8>::npos);
+    ASSERT_EQ(a.find("bc"), 1);
+    ASSERT_TRUE(a.starts_with("ab"));
+    ASSERT_TRUE(a.ends_with("bc"));
+    ASSERT_FALSE(a.ends_with("abcd"));
+}
+
+TEST(inplace_string, hash_and_conversion) {
+    const inplace_string<8> a("abc");
+    const inplace_string<16> b("abc");
+
+    ASSERT_EQ(std::hash<inplace_string<8>>{}(a), std::hash<inplace_string<16>>{}(b));
+    ASSERT_NE(std::hash<inplace_string<8>>{}(a), std::hash<inplace_string<8>>{}(inplace_string<8>("abd")));
+    ASSERT_EQ(a.str(), "abc");
+
+    std::ostringstream out;
+    out << a;
+    ASSERT_EQ(out.str(), "abc");
+
+#if CIEL_STD_VER >= 17
+    const std::string_view sv = a;
+    ASSERT_EQ(sv, "abc");
+    ASSERT_EQ(std::hash<inplace_string<8>>{}(a), std::hash<std::string>{}("abc"));
+#endif
+
+    inplace_string<8> c("xyz");
+    inplace_string<8> d(a);
+    std::swap(c, d);
+    ASSERT_EQ(c, "abc");
+    ASSERT_EQ(d, "xyz");
+}
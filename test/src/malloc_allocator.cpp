@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <ciel/allocate_at_least.hpp>
+#include <ciel/malloc_allocator.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+
+using namespace ciel;
+
+TEST(malloc_allocator, allocate_at_least) {
+    malloc_allocator<int> alloc;
+
+    for (size_t n = 1; n < 100; ++n) {
+        const auto res = ciel::allocate_at_least(alloc, n);
+        ASSERT_NE(res.ptr, nullptr);
+        ASSERT_GE(res.count, n);
+        ASSERT_LE(res.count * sizeof(int), ciel::malloc_usable_size(res.ptr, n * sizeof(int)));
+
+        // The whole block is usable.
+        for (size_t i = 0; i < res.count; ++i) {
+            res.ptr[i] = static_cast<int>(i);
+        }
+
+        alloc.deallocate(res.ptr, res.count);
+    }
+}
+
+TEST(malloc_allocator, vector_takes_usable_size) {
+    {
+        vector<int, malloc_allocator<int>> v;
+        v.reserve(5);
+        ASSERT_GE(v.capacity(), 5);
+        ASSERT_EQ(v.capacity(), ciel::malloc_usable_size(v.data(), 5 * sizeof(int)) / sizeof(int));
+
+        const size_t cap = v.capacity();
+        for (size_t i = 0; i < cap; ++i) {
+            v.emplace_back(static_cast<int>(i));
+        }
+        ASSERT_EQ(v.capacity(), cap);
+    }
+    {
+        vector<TRInt, malloc_allocator<TRInt>> v{0, 1, 2, 3, 4};
+
+        for (int i = 5; i < 100; ++i) {
+            v.emplace_back(i);
+        }
+
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(v[i], i);
+        }
+
+        v.erase(v.begin(), v.begin() + 95);
+        v.shrink_to_fit();
+        ASSERT_EQ(v, std::initializer_list<TRInt>({95, 96, 97, 98, 99}));
+    }
+    {
+        vector<Int, malloc_allocator<Int>> v(10, 42);
+        v.insert(v.begin(), 20, 0);
+        ASSERT_EQ(v.size(), 30);
+        ASSERT_EQ(v[19], 0);
+        ASSERT_EQ(v[20], 42);
+    }
+}
+
+TEST(malloc_allocator, reallocate_at_least) {
+    static_assert(allocator_has_reallocate_at_least<malloc_allocator<int>>::value, "");
+    static_assert(!allocator_has_reallocate_at_least<std::allocator<int>>::value, "");
+
+    malloc_allocator<int> alloc;
+
+    auto res = ciel::allocate_at_least(alloc, size_t{4});
+    for (size_t i = 0; i < 4; ++i) {
+        res.ptr[i] = static_cast<int>(i);
+    }
+
+    res = alloc.reallocate_at_least(res.ptr, res.count, 100000);
+    ASSERT_GE(res.count, 100000);
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(res.ptr[i], i);
+    }
+
+    alloc.deallocate(res.ptr, res.count);
+}
+
+TEST(malloc_allocator, vector_grows_via_realloc) {
+    {
+        vector<TRInt, malloc_allocator<TRInt>> v{0, 1, 2};
+        v.shrink_to_fit();
+
+        for (int i = 3; i < 1000; ++i) {
+            // The argument refers to an element which is relocated during expansion.
+            if (v.size() == v.capacity()) {
+                v.emplace_back(v[i - 3]);
+                v.back() = i;
+
+            } else {
+                v.emplace_back(i);
+            }
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(v[i], i);
+        }
+
+        v.reserve(100000);
+        ASSERT_GE(v.capacity(), 100000);
+        ASSERT_EQ(v.size(), 1000);
+        ASSERT_EQ(v.front(), 0);
+        ASSERT_EQ(v.back(), 999);
+    }
+    {
+        vector<TRInt, malloc_allocator<TRInt>> v{0, 1, 2};
+        while (v.size() < v.capacity()) {
+            v.emplace_back(1);
+        }
+
+        const size_t cap = v.capacity();
+        v.push_back(v.front());
+        ASSERT_GT(v.capacity(), cap);
+        ASSERT_EQ(v.back(), 0);
+    }
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <ciel/core/aligned_storage.hpp>
+#include <ciel/relocate.hpp>
+#include <ciel/shared_ptr.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <new>
+#include <string>
+
+using namespace ciel;
+
+namespace {
+
+// Uninitialized storage for N objects of T.
+template<class T, size_t N>
+struct storage {
+    typename aligned_storage<sizeof(T), alignof(T)>::type buffer[N];
+
+    T* data() noexcept {
+        return reinterpret_cast<T*>(buffer);
+    }
+
+    void destroy(const size_t first, const size_t last) noexcept {
+        for (size_t i = first; i < last; ++i) {
+            data()[i].~T();
+        }
+    }
+
+}; // struct storage
+
+template<class T>
+void test_shift_impl(::testing::Test*) {
+    storage<T, 8> s;
+    T* p = s.data();
+
+    for (int i = 0; i < 4; ++i) {
+        ::new (p + i) T(i);
+    }
+
+    // [0, 4) -> [3, 7), overlapping.
+    ASSERT_EQ(ciel::uninitialized_relocate_backward(p, p + 4, p + 7), p + 3);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(p[i + 3], i);
+    }
+
+    // [3, 7) -> [1, 5), overlapping.
+    ASSERT_EQ(ciel::uninitialized_relocate(p + 3, p + 7, p + 1), p + 5);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(p[i + 1], i);
+    }
+
+    // [1, 5) -> [0, 4), overlapping.
+    const auto res = ciel::uninitialized_relocate_n(p + 1, 4, p);
+    ASSERT_EQ(res.first, p + 5);
+    ASSERT_EQ(res.second, p + 4);
+
+    ASSERT_EQ(ciel::relocate_at(p + 3, p + 7), p + 7);
+    ASSERT_EQ(p[7], 3);
+    ASSERT_EQ(p[2], 2);
+
+    s.destroy(0, 3);
+    s.destroy(7, 8);
+}
+
+struct declared {
+    CIEL_TRIVIALLY_RELOCATABLE(declared, ciel::shared_ptr<int>, int);
+
+    ciel::shared_ptr<int> p;
+    int i;
+};
+
+struct declared_nested {
+    CIEL_TRIVIALLY_RELOCATABLE(declared_nested, declared, TRInt);
+
+    declared d;
+    TRInt t;
+};
+
+struct declared_with_non_relocatable {
+    CIEL_TRIVIALLY_RELOCATABLE(declared_with_non_relocatable, declared, Int);
+
+    declared d;
+    Int t;
+};
+
+struct declared_unconditionally {
+    CIEL_TRIVIALLY_RELOCATABLE(declared_unconditionally);
+
+    declared_unconditionally() = default;
+
+    declared_unconditionally(declared_unconditionally&&) noexcept {}
+
+    ~declared_unconditionally() {}
+};
+
+// The declaration isn't inherited, the derived class may add members which aren't trivially relocatable.
+struct derived_from_declared : declared {
+    std::list<int> l;
+};
+
+static_assert(is_trivially_relocatable<declared>::value, "");
+static_assert(is_trivially_relocatable<declared_nested>::value, "");
+static_assert(!is_trivially_relocatable<declared_with_non_relocatable>::value, "");
+static_assert(is_trivially_relocatable<declared_unconditionally>::value, "");
+static_assert(!is_trivially_relocatable<derived_from_declared>::value, "");
+#if CIEL_STD_VER >= 17
+static_assert(std::is_aggregate<declared>::value, "");
+#endif
+
+#ifdef CIEL_HAS_EXCEPTIONS
+struct throw_on_move {
+    static size_t alive;
+
+    int i;
+
+    throw_on_move(const int v) noexcept
+        : i(v) {
+        ++alive;
+    }
+
+    throw_on_move(throw_on_move&& other)
+        : i(other.i) {
+        if (i == 2) {
+            throw 0;
+        }
+
+        ++alive;
+    }
+
+    ~throw_on_move() {
+        --alive;
+    }
+
+}; // struct throw_on_move
+
+size_t throw_on_move::alive = 0;
+#endif
+
+} // namespace
+
+TEST(relocate, shift) {
+    test_shift_impl<int>(this);
+    test_shift_impl<Int>(this);
+    test_shift_impl<TRInt>(this);
+    test_shift_impl<TMInt>(this);
+}
+
+TEST(relocate, relocate_at) {
+    storage<std::string, 2> s;
+    std::string* p = s.data();
+
+    ::new (p) std::string(100, 'a');
+    ciel::relocate_at(p, p + 1);
+    ASSERT_EQ(p[1], std::string(100, 'a'));
+
+    s.destroy(1, 2);
+}
+
+TEST(relocate, relocate_swap) {
+    std::unique_ptr<int> a(new int{1});
+    std::unique_ptr<int> b(new int{2});
+    ciel::relocate_swap(a, b);
+    ASSERT_EQ(*a, 2);
+    ASSERT_EQ(*b, 1);
+
+    std::string c(100, 'c');
+    std::string d = "d";
+    ciel::relocate_swap(c, d);
+    ASSERT_EQ(c, "d");
+    ASSERT_EQ(d, std::string(100, 'c'));
+}
+
+TEST(relocate, declared_trivially_relocatable) {
+    ciel::vector<declared> v;
+
+    for (int i = 0; i < 100; ++i) {
+        v.push_back({ciel::make_shared<int>(i), i});
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(*v[i].p, i);
+        ASSERT_EQ(v[i].p.use_count(), 1);
+        ASSERT_EQ(v[i].i, i);
+    }
+}
+
+TEST(relocate, derived_from_declared) {
+    ciel::vector<derived_from_declared> v;
+
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back();
+        v.back().l.push_back(i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(v[i].l.size(), 1);
+        ASSERT_EQ(v[i].l.front(), i);
+    }
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+TEST(relocate, exception_destroys_both_ranges) {
+    {
+        storage<throw_on_move, 8> s;
+        throw_on_move* p = s.data();
+
+        for (int i = 0; i < 4; ++i) {
+            ::new (p + i) throw_on_move(i);
+        }
+
+        ASSERT_THROW(ciel::uninitialized_relocate(p, p + 4, p + 4), int);
+        ASSERT_EQ(throw_on_move::alive, 0);
+    }
+    {
+        storage<throw_on_move, 8> s;
+        throw_on_move* p = s.data();
+
+        for (int i = 0; i < 4; ++i) {
+            ::new (p + i) throw_on_move(i);
+        }
+
+        ASSERT_THROW(ciel::uninitialized_relocate_backward(p, p + 4, p + 6), int);
+        ASSERT_EQ(throw_on_move::alive, 0);
+    }
+}
+#endif
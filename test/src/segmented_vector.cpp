@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <ciel/segmented_vector.hpp>
+#include <ciel/test/fancy_allocator.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/test/propagate_allocator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class C>
+void test_push_pop_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    C v;
+    ASSERT_TRUE(v.empty());
+
+    // Addresses of elements are stable across growth.
+    vector<const T*> addresses;
+    for (int i = 0; i < 100; ++i) {
+        addresses.emplace_back(std::addressof(v.emplace_back(i)));
+    }
+
+    ASSERT_EQ(v.size(), 100);
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i], static_cast<int>(i));
+        ASSERT_EQ(std::addressof(v[i]), addresses[i]);
+    }
+
+    // pop_front across several chunks.
+    for (size_t i = 0; i < 30; ++i) {
+        ASSERT_EQ(v.front(), static_cast<int>(i));
+        v.pop_front();
+    }
+
+    ASSERT_EQ(v.size(), 70);
+    ASSERT_EQ(v.front(), 30);
+    ASSERT_EQ(std::addressof(v.front()), addresses[30]);
+    ASSERT_EQ(std::addressof(v.back()), addresses[99]);
+
+    v.pop_back();
+    ASSERT_EQ(v.back(), 98);
+
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i);
+    }
+    ASSERT_EQ(v.size(), 169);
+    ASSERT_EQ(std::addressof(v.front()), addresses[30]);
+
+    while (!v.empty()) {
+        v.pop_front();
+    }
+
+    v.emplace_back(42);
+    ASSERT_EQ(v, std::initializer_list<T>({42}));
+}
+
+template<class C>
+void test_iterator_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    C v;
+    for (int i = 0; i < 50; ++i) {
+        v.emplace_back(i);
+    }
+    v.pop_front();
+    v.pop_front();
+
+    ASSERT_EQ(v.end() - v.begin(), 48);
+    ASSERT_EQ(*(v.begin() + 10), 12);
+    ASSERT_EQ(v.begin()[47], 49);
+    ASSERT_EQ(*(v.end() - 1), 49);
+    ASSERT_EQ(*v.rbegin(), 49);
+    ASSERT_TRUE(v.begin() < v.end());
+
+    typename C::const_iterator it = v.begin();
+    ASSERT_EQ(*it, 2);
+    ASSERT_EQ(std::distance(it, v.cend()), 48);
+
+    std::reverse(v.begin(), v.end());
+    ASSERT_EQ(v.front(), 49);
+    ASSERT_EQ(v.back(), 2);
+
+    std::sort(v.begin(), v.end());
+    ASSERT_TRUE(std::is_sorted(v.begin(), v.end()));
+
+    const C v2(v.begin(), v.begin() + 3);
+    ASSERT_EQ(v2, std::initializer_list<T>({2, 3, 4}));
+}
+
+template<class C>
+void test_copy_move_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    C v1{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    v1.pop_front();
+
+    C v2(v1);
+    ASSERT_EQ(v1, v2);
+
+    const T* front = std::addressof(v1.front());
+    C v3(std::move(v1));
+    ASSERT_TRUE(v1.empty());
+    ASSERT_EQ(v3, v2);
+    ASSERT_EQ(std::addressof(v3.front()), front);
+
+    v1 = v3;
+    ASSERT_EQ(v1, v2);
+
+    v1 = {1, 2, 3};
+    ASSERT_EQ(v1, std::initializer_list<T>({1, 2, 3}));
+
+    // Chunks are stolen unless the allocators are unequal.
+    v1 = std::move(v3);
+    ASSERT_EQ(v1, v2);
+    if (std::allocator_traits<typename C::allocator_type>::is_always_equal::value) {
+        ASSERT_EQ(std::addressof(v1.front()), front);
+    }
+
+    v1.clear();
+    ASSERT_TRUE(v1.empty());
+    v1.emplace_back(1);
+    ASSERT_EQ(v1, std::initializer_list<T>({1}));
+}
+
+} // namespace
+
+TEST(segmented_vector, push_pop) {
+    test_push_pop_impl<segmented_vector<int, 8>>(this);
+    test_push_pop_impl<segmented_vector<Int, 8>>(this);
+    test_push_pop_impl<segmented_vector<int, 1>>(this);
+    test_push_pop_impl<segmented_vector<Int, 7, fancy_allocator<Int>>>(this);
+    test_push_pop_impl<segmented_vector<int>>(this);
+}
+
+TEST(segmented_vector, iterator) {
+    test_iterator_impl<segmented_vector<int, 8>>(this);
+    test_iterator_impl<segmented_vector<Int, 8>>(this);
+    test_iterator_impl<segmented_vector<Int, 7, fancy_allocator<Int>>>(this);
+    test_iterator_impl<segmented_vector<int>>(this);
+}
+
+TEST(segmented_vector, copy_move) {
+    test_copy_move_impl<segmented_vector<int, 8>>(this);
+    test_copy_move_impl<segmented_vector<Int, 8>>(this);
+    test_copy_move_impl<segmented_vector<Int, 7, fancy_allocator<Int>>>(this);
+    test_copy_move_impl<segmented_vector<int>>(this);
+}
+
+TEST(segmented_vector, swap) {
+    segmented_vector<int, 4> v1{0, 1, 2, 3, 4, 5};
+    segmented_vector<int, 4> v2{6, 7};
+    v1.pop_front();
+
+    const int* p1 = std::addressof(v1.front());
+    const int* p2 = std::addressof(v2.front());
+
+    v1.swap(v2);
+    ASSERT_EQ(v1, std::initializer_list<int>({6, 7}));
+    ASSERT_EQ(v2, std::initializer_list<int>({1, 2, 3, 4, 5}));
+    ASSERT_EQ(std::addressof(v1.front()), p2);
+    ASSERT_EQ(std::addressof(v2.front()), p1);
+
+    std::swap(v1, v2);
+    ASSERT_EQ(v1, std::initializer_list<int>({1, 2, 3, 4, 5}));
+}
+
+TEST(segmented_vector, copy_assign_allocator) {
+    using C = segmented_vector<int, 4, pocca_allocator<int>>;
+
+    C v1({0, 1, 2, 3, 4, 5}, pocca_allocator<int>(1));
+    const C v2({6, 7, 8, 9, 10}, pocca_allocator<int>(2));
+
+    v1 = v2;
+    ASSERT_EQ(v1, std::initializer_list<int>({6, 7, 8, 9, 10}));
+    ASSERT_EQ(v1.get_allocator().id(), 2);
+
+    v1.push_back(11);
+    ASSERT_EQ(v1.size(), 6);
+}
+
+TEST(segmented_vector, capacity) {
+    segmented_vector<int, 16> v;
+    ASSERT_EQ(v.capacity(), 0);
+
+    v.reserve(40);
+    ASSERT_EQ(v.capacity(), 48);
+
+    v.emplace_back(1);
+    v.shrink_to_fit();
+    ASSERT_EQ(v.capacity(), 16);
+
+    v.pop_front();
+    ASSERT_EQ(v.capacity(), 15);
+    v.clear();
+    ASSERT_EQ(v.capacity(), 16);
+
+    const segmented_vector<int, 16> v2(100, 1);
+    ASSERT_EQ(v2.size(), 100);
+    ASSERT_EQ(std::count(v2.begin(), v2.end(), 1), 100);
+    ASSERT_EQ(v2.at(99), 1);
+#ifdef CIEL_HAS_EXCEPTIONS
+    ASSERT_THROW(CIEL_UNUSED(v2.at(100)), std::out_of_range);
+#endif
+}
+
+#if CIEL_STD_VER >= 20
+static_assert(std::random_access_iterator<segmented_vector<int>::iterator>);
+static_assert(std::random_access_iterator<segmented_vector<int>::const_iterator>);
+#endif
+
+TEST(segmented_vector, default_chunk_size) {
+    static_assert(segmented_vector<char>::chunk_size == 4096, "");
+    static_assert(segmented_vector<int>::chunk_size == 1024, "");
+    static_assert(segmented_vector<char[24]>::chunk_size == 128, "");
+    static_assert(segmented_vector<char[1000]>::chunk_size == 16, "");
+}
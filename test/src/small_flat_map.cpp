@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <ciel/small_flat_map.hpp>
+#include <ciel/test/int_wrapper.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class M>
+void test_insert_impl(::testing::Test*) {
+    M m;
+    ASSERT_TRUE(m.empty());
+    ASSERT_TRUE(m.is_inline());
+
+    ASSERT_TRUE(m.insert({3, 30}).second);
+    ASSERT_TRUE(m.emplace(1, 10).second);
+    ASSERT_TRUE(m.try_emplace(2, 20).second);
+    ASSERT_FALSE(m.try_emplace(2, 21).second);
+    ASSERT_FALSE(m.insert({1, 11}).second);
+    ASSERT_EQ(m.size(), 3);
+
+    ASSERT_FALSE(m.insert_or_assign(2, 22).second);
+    ASSERT_EQ(m.at(2), 22);
+    m[4] = 40;
+    ASSERT_EQ(m.size(), 4);
+    ASSERT_EQ(m[4], 40);
+
+    ASSERT_TRUE(m.contains(3));
+    ASSERT_FALSE(m.contains(5));
+    ASSERT_EQ(m.count(3), 1);
+    ASSERT_EQ(m.find(5), m.end());
+    ASSERT_EQ(m.find(3)->second, 30);
+
+    m.find(3)->second = 33;
+    ASSERT_EQ(m.at(3), 33);
+
+    ASSERT_EQ(m.erase(2), 1);
+    ASSERT_EQ(m.erase(2), 0);
+    ASSERT_EQ(m.size(), 3);
+    ASSERT_EQ(m.at(1), 10);
+    ASSERT_EQ(m.at(3), 33);
+    ASSERT_EQ(m.at(4), 40);
+    ASSERT_TRUE(m.is_inline());
+
+    m.clear();
+    ASSERT_TRUE(m.empty());
+}
+
+template<class M>
+void test_spill_impl(::testing::Test*) {
+    M m;
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(m.try_emplace(7 - i, i).second);
+    }
+    ASSERT_TRUE(m.is_inline());
+
+    // Inserting the fifth element moves all of them into a sorted flat_map.
+    ASSERT_TRUE(m.try_emplace(10, 4).second);
+    ASSERT_FALSE(m.is_inline());
+    ASSERT_EQ(m.size(), 5);
+    ASSERT_TRUE(std::is_sorted(m.begin(), m.end(), [](typename M::const_reference lhs,
+                                                      typename M::const_reference rhs) {
+        return lhs.first < rhs.first;
+    }));
+
+    ASSERT_FALSE(m.try_emplace(5, 0).second);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(m.at(7 - i), i);
+    }
+    ASSERT_EQ(m.at(10), 4);
+
+    // It stays spilled until it gets empty.
+    ASSERT_EQ(m.erase(10), 1);
+    ASSERT_EQ(m.erase(4), 1);
+    ASSERT_FALSE(m.is_inline());
+    ASSERT_EQ(m.size(), 3);
+
+    while (!m.empty()) {
+        m.erase(m.begin());
+    }
+    ASSERT_TRUE(m.is_inline());
+    ASSERT_EQ(m.begin(), m.end());
+
+    ASSERT_TRUE(m.try_emplace(1, 1).second);
+    ASSERT_TRUE(m.is_inline());
+}
+
+} // namespace
+
+TEST(small_flat_map, insert) {
+    test_insert_impl<small_flat_map<int, int, 8>>(this);
+    test_insert_impl<small_flat_map<Int, Int, 8>>(this);
+    test_insert_impl<small_flat_map<TRInt, TMInt, 8>>(this);
+}
+
+TEST(small_flat_map, spill) {
+    test_spill_impl<small_flat_map<int, int, 4>>(this);
+    test_spill_impl<small_flat_map<Int, Int, 4>>(this);
+    test_spill_impl<small_flat_map<TRInt, TMInt, 4>>(this);
+}
+
+TEST(small_flat_map, iterator) {
+    small_flat_map<std::string, std::string, 4> m{{"b", "2"}, {"a", "1"}, {"c", "3"}};
+
+    // Insertion order while inline.
+    ASSERT_EQ(std::distance(m.begin(), m.end()), 3);
+    ASSERT_EQ(m.begin()->first, "b");
+    ASSERT_EQ(m.rbegin()->first, "c");
+
+    std::string s;
+    for (auto p : m) {
+        s += p.second;
+        p.second += "!";
+    }
+    ASSERT_EQ(s, "213");
+    ASSERT_EQ(m.at("a"), "1!");
+
+    // Erase moves the last element into the hole.
+    ASSERT_EQ(m.erase(m.begin())->first, "c");
+    ASSERT_EQ(m.begin()->first, "c");
+
+    m["d"] = "4";
+    m["e"] = "5";
+    m["f"] = "6";
+    ASSERT_FALSE(m.is_inline());
+
+    s.clear();
+    for (auto p : m) {
+        s += p.first;
+    }
+    ASSERT_EQ(s, "acdef");
+
+    const small_flat_map<std::string, std::string, 4>& cm = m;
+    small_flat_map<std::string, std::string, 4>::const_iterator it = m.begin();
+    ASSERT_EQ(it, cm.begin());
+    ASSERT_EQ(cm.find("x"), cm.end());
+    static_assert(std::is_same<decltype(cm.begin()->second), const std::string&>::value, "");
+}
+
+TEST(small_flat_map, erase_if) {
+    small_flat_map<int, int, 8> m;
+    for (int i = 0; i < 8; ++i) {
+        m[i] = i;
+    }
+
+    const auto key_is_odd = [](std::pair<const int&, int&> p) {
+        return p.first % 2 == 1;
+    };
+    ASSERT_EQ(erase_if(m, key_is_odd), 4);
+    ASSERT_EQ(m.size(), 4);
+
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(m.contains(i), i % 2 == 0);
+    }
+}
+
+TEST(small_flat_map, swap) {
+    small_flat_map<int, int, 2> m1{{1, 1}};
+    small_flat_map<int, int, 2> m2{{1, 10}, {2, 20}, {3, 30}};
+    ASSERT_TRUE(m1.is_inline());
+    ASSERT_FALSE(m2.is_inline());
+
+    std::swap(m1, m2);
+    ASSERT_FALSE(m1.is_inline());
+    ASSERT_TRUE(m2.is_inline());
+    ASSERT_EQ(m1.size(), 3);
+    ASSERT_EQ(m1.at(3), 30);
+    ASSERT_EQ(m2.size(), 1);
+    ASSERT_EQ(m2.at(1), 1);
+
+    const small_flat_map<int, int, 2> m3(m1);
+    ASSERT_EQ(m3.at(2), 20);
+}
+
+TEST(small_flat_map, swap_inline_and_spilled) {
+    using M = small_flat_map<Int, Int, 2>;
+
+    M m1{{1, 1}};
+    M m2{{3, 30}, {1, 10}, {2, 20}};
+    ASSERT_TRUE(m1.is_inline());
+    ASSERT_FALSE(m2.is_inline());
+
+    m1.swap(m2);
+    ASSERT_FALSE(m1.is_inline());
+    ASSERT_TRUE(m2.is_inline());
+    ASSERT_EQ(m1.size(), 3);
+    ASSERT_EQ(m1.at(1), 10);
+    ASSERT_EQ(m1.at(2), 20);
+    ASSERT_EQ(m1.at(3), 30);
+    ASSERT_EQ(m2.size(), 1);
+    ASSERT_EQ(m2.at(1), 1);
+
+    std::swap(m1, m2);
+    ASSERT_TRUE(m1.is_inline());
+    ASSERT_EQ(m1.at(1), 1);
+    ASSERT_EQ(m2.size(), 3);
+
+    static_assert(noexcept(m1.swap(m2)), "");
+    static_assert(noexcept(std::swap(m1, m2)), "");
+
+    small_flat_map<TMInt, int, 2> m3;
+    small_flat_map<int, TMInt, 2> m4;
+    static_assert(!noexcept(m3.swap(m3)), "");
+    static_assert(!noexcept(std::swap(m4, m4)), "");
+}
+
+TEST(small_flat_map, trivially_relocatable) {
+    static_assert(is_trivially_relocatable<small_flat_map<int, int, 4>>::value, "");
+    static_assert(!is_trivially_relocatable<small_flat_map<int, Int, 4>>::value, "");
+}
+
+#ifdef CIEL_HAS_EXCEPTIONS
+namespace {
+
+// Its move may throw, so spilling copies it.
+struct throw_on_third_copy {
+    static size_t copies;
+
+    int i;
+
+    throw_on_third_copy(const int v) noexcept
+        : i(v) {}
+
+    throw_on_third_copy(const throw_on_third_copy& other)
+        : i(other.i) {
+        if (++copies == 3) {
+            throw 0;
+        }
+    }
+
+    throw_on_third_copy(throw_on_third_copy&& other)
+        : i(other.i) {}
+
+    throw_on_third_copy& operator=(const throw_on_third_copy&) = default;
+
+}; // struct throw_on_third_copy
+
+size_t throw_on_third_copy::copies = 0;
+
+} // namespace
+
+TEST(small_flat_map, spill_throws) {
+    small_flat_map<std::string, throw_on_third_copy, 4> m;
+    for (int i = 0; i < 4; ++i) {
+        m.try_emplace(std::string(20, static_cast<char>('a' + i)), i);
+    }
+
+    throw_on_third_copy::copies = 0;
+    ASSERT_THROW(m.try_emplace("e", 4), int);
+
+    // The keys weren't moved from.
+    ASSERT_TRUE(m.is_inline());
+    ASSERT_EQ(m.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(m.at(std::string(20, static_cast<char>('a' + i))).i, i);
+    }
+    ASSERT_FALSE(m.contains("e"));
+}
+
+TEST(small_flat_map, at_throws) {
+    small_flat_map<int, int, 4> m{{1, 1}};
+
+    ASSERT_THROW(CIEL_UNUSED(m.at(2)), std::out_of_range);
+}
+#endif
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <ciel/growth_policy.hpp>
+#include <ciel/small_vector.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/test/propagate_allocator.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class C>
+void test_spill_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    C v;
+    ASSERT_TRUE(v.is_inline());
+    ASSERT_EQ(v.capacity(), C::inline_capacity());
+
+    for (size_t i = 0; i < C::inline_capacity(); ++i) {
+        v.emplace_back(static_cast<int>(i));
+    }
+    ASSERT_TRUE(v.is_inline());
+
+    v.emplace_back(v.front());
+    ASSERT_FALSE(v.is_inline());
+    ASSERT_GT(v.capacity(), C::inline_capacity());
+    ASSERT_EQ(v, std::initializer_list<T>({0, 1, 2, 3, 0}));
+
+    v.insert(v.begin() + 1, 2, v.back());
+    ASSERT_EQ(v, std::initializer_list<T>({0, 0, 0, 1, 2, 3, 0}));
+
+    v.erase(v.begin(), v.begin() + 4);
+    ASSERT_EQ(v, std::initializer_list<T>({2, 3, 0}));
+
+    // Moving back to the inline buffer must not throw.
+    v.shrink_to_fit();
+    ASSERT_EQ(v.is_inline(), std::is_nothrow_move_constructible<T>::value || is_trivially_relocatable<T>::value);
+    ASSERT_EQ(v, std::initializer_list<T>({2, 3, 0}));
+}
+
+template<class C>
+void test_move_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    // inline
+    {
+        C v1{0, 1, 2};
+        C v2(std::move(v1));
+        ASSERT_TRUE(v1.empty());
+        ASSERT_TRUE(v2.is_inline());
+        ASSERT_EQ(v2, std::initializer_list<T>({0, 1, 2}));
+
+        v1 = std::move(v2);
+        ASSERT_TRUE(v2.empty());
+        ASSERT_EQ(v1, std::initializer_list<T>({0, 1, 2}));
+    }
+    // heap, the buffer is stolen
+    {
+        C v1{0, 1, 2, 3, 4, 5};
+        const auto data = v1.data();
+
+        C v2(std::move(v1));
+        ASSERT_TRUE(v1.empty());
+        ASSERT_TRUE(v1.is_inline());
+        ASSERT_EQ(v2.data(), data);
+        ASSERT_EQ(v2, std::initializer_list<T>({0, 1, 2, 3, 4, 5}));
+
+        C v3{7};
+        v3 = std::move(v2);
+        ASSERT_TRUE(v2.empty());
+        ASSERT_EQ(v3.data(), data);
+        ASSERT_EQ(v3, std::initializer_list<T>({0, 1, 2, 3, 4, 5}));
+    }
+}
+
+template<class C>
+void test_swap_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    {
+        C v1{0, 1, 2};
+        C v2{3, 4, 5, 6, 7, 8};
+
+        v1.swap(v2);
+        ASSERT_EQ(v1, std::initializer_list<T>({3, 4, 5, 6, 7, 8}));
+        ASSERT_EQ(v2, std::initializer_list<T>({0, 1, 2}));
+
+        v1.swap(v2);
+        ASSERT_EQ(v1, std::initializer_list<T>({0, 1, 2}));
+        ASSERT_EQ(v2, std::initializer_list<T>({3, 4, 5, 6, 7, 8}));
+    }
+    {
+        C v1{0, 1, 2, 3, 4};
+        C v2{5, 6, 7, 8, 9, 10};
+        const auto data1 = v1.data();
+        const auto data2 = v2.data();
+
+        std::swap(v1, v2);
+        ASSERT_EQ(v1.data(), data2);
+        ASSERT_EQ(v2.data(), data1);
+        ASSERT_EQ(v1, std::initializer_list<T>({5, 6, 7, 8, 9, 10}));
+        ASSERT_EQ(v2, std::initializer_list<T>({0, 1, 2, 3, 4}));
+    }
+}
+
+} // namespace
+
+TEST(small_vector, spill) {
+    test_spill_impl<small_vector<int, 4>>(this);
+    test_spill_impl<small_vector<Int, 4>>(this);
+    test_spill_impl<small_vector<TRInt, 4>>(this);
+    test_spill_impl<small_vector<TMInt, 4>>(this);
+}
+
+TEST(small_vector, move) {
+    test_move_impl<small_vector<int, 4>>(this);
+    test_move_impl<small_vector<Int, 4>>(this);
+    test_move_impl<small_vector<TRInt, 4>>(this);
+    test_move_impl<small_vector<TMInt, 4>>(this);
+}
+
+TEST(small_vector, swap) {
+    test_swap_impl<small_vector<int, 4>>(this);
+    test_swap_impl<small_vector<Int, 4>>(this);
+    test_swap_impl<small_vector<TRInt, 4>>(this);
+    test_swap_impl<small_vector<TMInt, 4>>(this);
+}
+
+TEST(small_vector, swap_allocator) {
+    using C = small_vector<int, 4, pocs_allocator<int>>;
+
+    C v1({0, 1, 2}, pocs_allocator<int>(1));
+    C v2({3, 4, 5, 6, 7, 8}, pocs_allocator<int>(2));
+
+    // One side inline, the allocators go with the elements.
+    v1.swap(v2);
+    ASSERT_EQ(v1, std::initializer_list<int>({3, 4, 5, 6, 7, 8}));
+    ASSERT_EQ(v1.get_allocator().id(), 2);
+    ASSERT_EQ(v2.get_allocator().id(), 1);
+
+    v1.swap(v2);
+    ASSERT_EQ(v1.get_allocator().id(), 1);
+    ASSERT_EQ(v2.get_allocator().id(), 2);
+
+    C v3({0, 1}, pocs_allocator<int>(3));
+    v1.swap(v3);
+    ASSERT_EQ(v1, std::initializer_list<int>({0, 1}));
+    ASSERT_EQ(v1.get_allocator().id(), 3);
+    ASSERT_EQ(v3.get_allocator().id(), 1);
+}
+
+TEST(small_vector, growth_policy) {
+    small_vector<int, 2> v1;
+    small_vector<Int, 2, std::allocator<Int>, growth_policy_1_5x> v2;
+
+    for (int i = 0; i < 20; ++i) {
+        v1.emplace_back(i);
+        v2.emplace_back(i);
+    }
+
+    // Past the inline buffer, the heap buffer grows just like vector's.
+    ASSERT_EQ(v1.capacity(), 32);
+    ASSERT_EQ(v2.capacity(), 28); // 2, 3, 4, 6, 9, 13, 19, 28
+    ASSERT_EQ(v1.size(), v2.size());
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(v1[i], v2[i]);
+    }
+}
+
+TEST(small_vector, constructor) {
+    {
+        const small_vector<int, 8> v(5, 1);
+        ASSERT_TRUE(v.is_inline());
+        ASSERT_EQ(v, std::initializer_list<int>({1, 1, 1, 1, 1}));
+    }
+    {
+        const small_vector<int, 2> v(5, 1);
+        ASSERT_FALSE(v.is_inline());
+        ASSERT_EQ(v, std::initializer_list<int>({1, 1, 1, 1, 1}));
+    }
+    {
+        const small_vector<Int, 2> v1{0, 1, 2};
+        const small_vector<Int, 2> v2(v1);
+        ASSERT_EQ(v1, v2);
+
+        small_vector<Int, 2> v3{3};
+        v3 = v1;
+        ASSERT_EQ(v1, v3);
+
+        v3 = {4, 5};
+        ASSERT_EQ(v3, std::initializer_list<Int>({4, 5}));
+    }
+}
+
+TEST(small_vector, unique_ptr) {
+    small_vector<std::unique_ptr<int>, 2> v;
+
+    for (int i = 0; i < 10; ++i) {
+        v.emplace_back(new int{i});
+    }
+
+    v.erase(v.begin() + 2, v.end());
+    v.shrink_to_fit();
+    ASSERT_TRUE(v.is_inline());
+    ASSERT_EQ(*v[0], 0);
+    ASSERT_EQ(*v[1], 1);
+}
+
+TEST(small_vector, erase_if) {
+    small_vector<int, 4> v{0, 1, 2, 3, 4, 5, 6, 7};
+
+    ASSERT_EQ(ciel::erase(v, 3), 1);
+    ASSERT_EQ(ciel::erase_if(v,
+                             [](int i) {
+                                 return i % 2 == 0;
+                             }),
+              4);
+    ASSERT_EQ(v, std::initializer_list<int>({1, 5, 7}));
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <ciel/core/span.hpp>
+#include <ciel/soa_vector.hpp>
+#include <ciel/test/int_wrapper.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+using namespace ciel;
+
+namespace {
+
+template<class C>
+void test_push_back_impl(::testing::Test*) {
+    C v;
+    ASSERT_TRUE(v.empty());
+
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(static_cast<double>(i), i, static_cast<char>(i));
+    }
+
+    ASSERT_EQ(v.size(), 100);
+    ASSERT_GE(v.capacity(), 100);
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(std::get<0>(v[i]), static_cast<double>(i));
+        ASSERT_EQ(std::get<1>(v[i]), static_cast<int>(i));
+        ASSERT_EQ(std::get<2>(v[i]), static_cast<char>(i));
+    }
+
+    // Each column is contiguous and aligned.
+    ASSERT_EQ(v.template column<1>().size(), 100);
+    ASSERT_EQ(&v.template column<1>()[99] - &v.template column<1>()[0], 99);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(v.template data<0>()) % alignof(double), 0);
+
+    // Referring to an element while expanding.
+    v.shrink_to_fit();
+    ASSERT_EQ(v.size(), v.capacity());
+    v.emplace_back(std::get<0>(v[0]), std::get<1>(v[1]), std::get<2>(v[2]));
+    ASSERT_EQ(std::get<0>(v.back()), 0);
+    ASSERT_EQ(std::get<1>(v.back()), 1);
+    ASSERT_EQ(std::get<2>(v.back()), 2);
+
+    v.pop_back();
+    ASSERT_EQ(v.size(), 100);
+    ASSERT_EQ(std::get<1>(v.back()), 99);
+
+    v.push_back(std::make_tuple(1.5, 42, 'a'));
+    ASSERT_EQ(std::get<1>(v.back()), 42);
+
+    std::get<1>(v.front()) = 7;
+    ASSERT_EQ(v.template column<1>().front(), 7);
+}
+
+template<class C>
+void test_copy_move_impl(::testing::Test*) {
+    C v1;
+    for (int i = 0; i < 10; ++i) {
+        v1.emplace_back(static_cast<double>(i), i, static_cast<char>(i));
+    }
+
+    C v2(v1);
+    ASSERT_EQ(v1, v2);
+
+    C v3(std::move(v1));
+    ASSERT_TRUE(v1.empty());
+    ASSERT_EQ(v2, v3);
+
+    v1 = v3;
+    ASSERT_EQ(v1, v2);
+
+    v1.resize(3);
+    ASSERT_EQ(v1.size(), 3);
+    v1.resize(5);
+    ASSERT_EQ(std::get<1>(v1[4]), 0);
+
+    v1 = std::move(v3);
+    ASSERT_EQ(v1, v2);
+
+    v1.swap(v3);
+    ASSERT_TRUE(v1.empty());
+    ASSERT_EQ(v2, v3);
+
+    v3.clear();
+    ASSERT_TRUE(v3.empty());
+    v3.shrink_to_fit();
+    ASSERT_EQ(v3.capacity(), 0);
+}
+
+} // namespace
+
+TEST(soa_vector, push_back) {
+    test_push_back_impl<soa_vector<double, int, char>>(this);
+    test_push_back_impl<soa_vector<double, Int, char>>(this);
+    test_push_back_impl<soa_vector<double, TMInt, char>>(this);
+}
+
+TEST(soa_vector, copy_move) {
+    test_copy_move_impl<soa_vector<double, int, char>>(this);
+    test_copy_move_impl<soa_vector<double, Int, char>>(this);
+    test_copy_move_impl<soa_vector<double, TMInt, char>>(this);
+}
+
+TEST(soa_vector, iterator) {
+    soa_vector<int, uint64_t> v;
+    for (int i = 0; i < 10; ++i) {
+        v.emplace_back(i, static_cast<uint64_t>(i * 10));
+    }
+
+    ASSERT_EQ(v.end() - v.begin(), 10);
+    ASSERT_EQ(std::get<0>(*(v.begin() + 3)), 3);
+    ASSERT_EQ(std::get<1>(v.begin()[3]), 30);
+    ASSERT_EQ(std::get<0>(*v.rbegin()), 9);
+    ASSERT_TRUE(v.begin() < v.end());
+
+    int sum = 0;
+    for (auto e : v) {
+        sum += std::get<0>(e);
+        std::get<1>(e) += 1;
+    }
+    ASSERT_EQ(sum, 45);
+    ASSERT_EQ(std::get<1>(v[9]), 91);
+
+    const soa_vector<int, uint64_t>& cv = v;
+    soa_vector<int, uint64_t>::const_iterator it = v.begin();
+    ASSERT_EQ(it, cv.begin());
+    ASSERT_EQ(std::distance(it, cv.end()), 10);
+
+    const auto found = std::find_if(cv.begin(), cv.end(), [](std::tuple<const int&, const uint64_t&> e) {
+        return std::get<1>(e) == 51;
+    });
+    ASSERT_EQ(found - cv.begin(), 5);
+
+    const span<const uint64_t> column = cv.column<1>();
+    ASSERT_EQ(std::accumulate(column.begin(), column.end(), uint64_t{0}), 460);
+}
+
+TEST(soa_vector, span) {
+    int arr[] = {0, 1, 2, 3, 4};
+
+    span<int> s(arr);
+    ASSERT_EQ(s.size(), 5);
+    ASSERT_EQ(s.size_bytes(), sizeof(arr));
+    ASSERT_EQ(s.back(), 4);
+
+    span<const int> cs = s;
+    ASSERT_EQ(cs.subspan(1, 3).front(), 1);
+    ASSERT_EQ(cs.first(2).back(), 1);
+    ASSERT_EQ(cs.last(2).front(), 3);
+    ASSERT_EQ(*cs.rbegin(), 4);
+    ASSERT_TRUE(span<int>().empty());
+
+    static_assert(!std::is_convertible<span<const int>, span<int>>::value, "");
+}
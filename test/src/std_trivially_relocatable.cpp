@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <ciel/core/std_trivially_relocatable.hpp>
+#include <ciel/experimental/list.hpp>
+#include <ciel/function.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if CIEL_STD_VER >= 17
+#  include <optional>
+#endif
+
+using namespace ciel;
+
+namespace {
+
+struct stateful_deleter {
+    stateful_deleter* self{this};
+
+    stateful_deleter() = default;
+
+    stateful_deleter(const stateful_deleter&) noexcept {}
+
+    void operator()(int* p) const noexcept {
+        delete p;
+    }
+
+}; // struct stateful_deleter
+
+} // namespace
+
+static_assert(is_trivially_relocatable<std::allocator<int>>::value, "");
+static_assert(is_trivially_relocatable<std::pair<int, std::allocator<int>>>::value, "");
+static_assert(!is_trivially_relocatable<std::tuple<int, Int>>::value, "");
+
+static_assert(is_trivially_relocatable<ciel::vector<int>>::value, "");
+static_assert(is_trivially_relocatable<ciel::vector<Int>>::value, "");
+static_assert(is_trivially_relocatable<ciel::function<void()>>::value, "");
+static_assert(!is_trivially_relocatable<ciel::list<int>>::value, "");
+
+#if defined(_GLIBCXX_RELEASE) || defined(_LIBCPP_VERSION)
+static_assert(is_trivially_relocatable<std::unique_ptr<int>>::value, "");
+static_assert(is_trivially_relocatable<std::unique_ptr<int[]>>::value, "");
+static_assert(!is_trivially_relocatable<std::unique_ptr<int, stateful_deleter>>::value, "");
+static_assert(is_trivially_relocatable<std::shared_ptr<int>>::value, "");
+static_assert(is_trivially_relocatable<std::weak_ptr<int>>::value, "");
+static_assert(is_trivially_relocatable<std::pair<std::unique_ptr<int>, std::shared_ptr<int>>>::value, "");
+
+#  if CIEL_STD_VER >= 17
+static_assert(is_trivially_relocatable<std::optional<std::unique_ptr<int>>>::value, "");
+static_assert(!is_trivially_relocatable<std::optional<Int>>::value, "");
+#  endif
+
+#  if !defined(_GLIBCXX_DEBUG) && !defined(_LIBCPP_ENABLE_DEBUG_MODE)
+static_assert(is_trivially_relocatable<std::vector<int>>::value, "");
+static_assert(is_trivially_relocatable<std::vector<Int>>::value, "");
+static_assert(is_trivially_relocatable<std::tuple<std::vector<int>, std::unique_ptr<int>>>::value, "");
+#  endif
+#endif
+
+#ifdef _GLIBCXX_RELEASE
+static_assert(is_trivially_relocatable<std::function<void()>>::value, "");
+static_assert(!is_trivially_relocatable<std::string>::value, "");
+#endif
+
+#ifdef _LIBCPP_VERSION
+static_assert(!is_trivially_relocatable<std::function<void()>>::value, "");
+#  ifndef _LIBCPP_ENABLE_DEBUG_MODE
+static_assert(is_trivially_relocatable<std::string>::value, "");
+#  endif
+#endif
+
+TEST(std_trivially_relocatable, vector_of_std_types) {
+    ciel::vector<std::vector<int>> v;
+    ciel::vector<std::unique_ptr<size_t>> u;
+
+    for (size_t i = 0; i < 100; ++i) {
+        v.emplace_back(i, 1);
+        u.emplace_back(new size_t{i});
+    }
+
+    v.insert(v.begin(), std::vector<int>(3, 2));
+    v.erase(v.begin() + 50);
+
+    ASSERT_EQ(v.size(), 100);
+    ASSERT_EQ(v[0], std::vector<int>(3, 2));
+    for (size_t i = 1; i < 50; ++i) {
+        ASSERT_EQ(v[i], std::vector<int>(i - 1, 1));
+    }
+    for (size_t i = 50; i < 100; ++i) {
+        ASSERT_EQ(v[i], std::vector<int>(i, 1));
+    }
+
+    for (size_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(*u[i], i);
+    }
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <ciel/core/is_trivially_relocatable.hpp>
+#include <ciel/string.hpp>
+#include <ciel/test/different_allocator.hpp>
+#include <ciel/test/propagate_allocator.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#if CIEL_STD_VER >= 17
+#  include <string_view>
+#endif
+
+using namespace ciel;
+
+static_assert(sizeof(ciel::string) == sizeof(void*) * 3, "");
+static_assert(is_trivially_relocatable<ciel::string>::value, "");
+static_assert(ciel::string::inline_capacity() == sizeof(void*) * 3 - 1, "");
+
+namespace {
+
+template<class S>
+void test_modifiers_impl(::testing::Test*) {
+    S s;
+    ASSERT_TRUE(s.empty());
+    ASSERT_TRUE(s.is_inline());
+    ASSERT_STREQ(s.c_str(), "");
+
+    // Fill the inline buffer exactly, where the last byte is the terminator.
+    const std::string full(S::inline_capacity(), 'a');
+    s.append(full.data(), full.size());
+    ASSERT_TRUE(s.is_inline());
+    ASSERT_EQ(s.str(), full);
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+
+    s.push_back('b');
+    ASSERT_FALSE(s.is_inline());
+    ASSERT_EQ(s.str(), full + 'b');
+    ASSERT_EQ(s.c_str()[s.size()], '\0');
+
+    // Append itself, which reallocates.
+    std::string expected = full + 'b';
+    for (int i = 0; i < 5; ++i) {
+        s.append(s.data(), s.size());
+        expected += expected;
+        ASSERT_EQ(s.str(), expected);
+    }
+
+    s.resize(3);
+    ASSERT_EQ(s, "aaa");
+    s.shrink_to_fit();
+    ASSERT_TRUE(s.is_inline());
+    ASSERT_EQ(s, "aaa");
+
+    s.pop_back();
+    s += ':';
+    s.append_to_chars(uint64_t{1234567890123});
+    ASSERT_EQ(s, "aa:1234567890123");
+
+    s.assign("x");
+    ASSERT_EQ(s, "x");
+    s.clear();
+    ASSERT_TRUE(s.empty());
+
+    s.reserve(100);
+    ASSERT_GE(s.capacity(), 100);
+    ASSERT_FALSE(s.is_inline());
+    s.append(3, 'c');
+    ASSERT_EQ(s, "ccc");
+}
+
+} // namespace
+
+TEST(string, modifiers) {
+    test_modifiers_impl<ciel::string>(this);
+    test_modifiers_impl<ciel::basic_string<different_allocator<char>>>(this);
+    test_modifiers_impl<ciel::basic_string<pocma_allocator<char>>>(this);
+}
+
+TEST(string, push_back) {
+    ciel::string s;
+    std::string expected;
+
+    // Through the last inline char, and every reallocation after it.
+    for (int i = 0; i < 200; ++i) {
+        const char c = static_cast<char>('a' + i % 26);
+        s.push_back(c);
+        expected.push_back(c);
+
+        ASSERT_EQ(s.str(), expected);
+        ASSERT_EQ(s.c_str()[s.size()], '\0');
+        ASSERT_EQ(s.is_inline(), s.size() <= ciel::string::inline_capacity());
+    }
+}
+
+TEST(string, copy_and_move) {
+    const ciel::string short_str("short");
+    const ciel::string long_str(100, 'l');
+
+    for (const ciel::string* p : {&short_str, &long_str}) {
+        ciel::string copy(*p);
+        ASSERT_EQ(copy, *p);
+
+        ciel::string moved(std::move(copy));
+        ASSERT_EQ(moved, *p);
+        ASSERT_TRUE(copy.empty());
+
+        ciel::string assigned("something longer than the inline capacity");
+        assigned = moved;
+        ASSERT_EQ(assigned, *p);
+
+        ciel::string move_assigned;
+        move_assigned = std::move(assigned);
+        ASSERT_EQ(move_assigned, *p);
+        ASSERT_TRUE(assigned.empty());
+
+        std::swap(move_assigned, assigned);
+        ASSERT_EQ(assigned, *p);
+        ASSERT_TRUE(move_assigned.empty());
+    }
+
+    ciel::basic_string<different_allocator<char>> a(50, 'a');
+    ciel::basic_string<different_allocator<char>> b;
+    b = std::move(a);
+    ASSERT_EQ(b.str(), std::string(50, 'a'));
+}
+
+TEST(string, compare_and_find) {
+    const ciel::string a("abc");
+    const ciel::string b("abd");
+
+    ASSERT_TRUE(a < b);
+    ASSERT_TRUE(a != b);
+    ASSERT_TRUE(a == "abc");
+    ASSERT_TRUE("ab" < a);
+    ASSERT_TRUE(a < ciel::string("\xff"));
+    ASSERT_EQ(a.compare("abcd"), -1);
+
+    ASSERT_EQ(a.find('c'), 2);
+    ASSERT_EQ(a.find("bc"), 1);
+    ASSERT_EQ(a.find("x"), ciel::string::npos);
+    ASSERT_TRUE(a.starts_with("ab"));
+    ASSERT_TRUE(a.ends_with("bc"));
+
+    ASSERT_EQ(std::hash<ciel::string>{}(a), std::hash<ciel::string>{}(ciel::string("abc")));
+
+    std::ostringstream out;
+    out << a;
+    ASSERT_EQ(out.str(), "abc");
+
+#if CIEL_STD_VER >= 17
+    const std::string_view sv = a;
+    ASSERT_EQ(sv, "abc");
+    ASSERT_EQ(std::hash<ciel::string>{}(a), std::hash<std::string>{}("abc"));
+#endif
+}
+
+TEST(string, vector_of_strings) {
+    ciel::vector<ciel::string> v;
+
+    for (size_t i = 0; i < 100; ++i) {
+        ciel::string s(i % 2 == 0 ? "short" : "a string that doesn't fit in the inline buffer");
+        s.append_to_chars(i);
+        v.emplace_back(std::move(s));
+    }
+
+    v.insert(v.begin(), ciel::string("front"));
+    v.erase(v.begin() + 10, v.begin() + 20);
+
+    ASSERT_EQ(v.size(), 91);
+    ASSERT_EQ(v[0], "front");
+    ASSERT_EQ(v[1], "short0");
+    ASSERT_EQ(v[2], "a string that doesn't fit in the inline buffer1");
+    ASSERT_EQ(v[10], "a string that doesn't fit in the inline buffer19");
+}
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <ciel/inplace_vector.hpp>
 #include <ciel/test/int_wrapper.hpp>
 #include <ciel/vector.hpp>
 
+#include <cstddef>
+#include <cstdint>
+
 using namespace ciel;
 
 TEST(vector, equal) {
@@ -36,3 +40,42 @@ TEST(vector, less) {
         ASSERT_GE(v2, v1);
     }
 }
+
+TEST(vector, compare_bytewise) {
+    static_assert(is_trivially_equality_comparable<int>::value, "");
+    static_assert(!is_trivially_equality_comparable<double>::value, "");
+    static_assert(detail::is_bytewise_comparable<vector<int>, inplace_vector<int, 100>>::value, "");
+    static_assert(!detail::is_bytewise_comparable<vector<int>, vector<long long>>::value, "");
+    static_assert(!detail::is_bytewise_comparable<vector<Int>, vector<Int>>::value, "");
+
+    // Mismatches at every position of the SIMD blocks and the tail.
+    for (size_t i = 0; i < 100; ++i) {
+        vector<int> v1(100, -1);
+        vector<int> v2(100, -1);
+        ASSERT_EQ(v1, v2);
+
+        // Lexicographic order is decided by the elements, not by their bytes.
+        v2[i] = 256;
+        ASSERT_NE(v1, v2);
+        ASSERT_LT(v1, v2);
+
+        v1[i] = -2;
+        ASSERT_LT(v1, v2);
+        ASSERT_GT(v2, v1);
+
+        const inplace_vector<int, 100> v3(v2.begin(), v2.end());
+        ASSERT_EQ(v2, v3);
+        ASSERT_LE(v1, v3);
+    }
+
+    {
+        const vector<uint8_t> v1{1, 2, 3};
+        const vector<uint8_t> v2{1, 2, 3, 0};
+        const vector<uint8_t> v3;
+
+        ASSERT_LT(v1, v2);
+        ASSERT_LT(v3, v1);
+        ASSERT_EQ(v3, vector<uint8_t>());
+        ASSERT_GE(v3, vector<uint8_t>());
+    }
+}
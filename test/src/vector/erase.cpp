@@ -53,8 +53,86 @@ void test_erase_impl(::testing::Test*) {
     }
 }
 
+template<class T>
+void test_unstable_erase_impl(::testing::Test*) {
+    vector<T> v{0, 1, 2, 3, 4};
+    {
+        auto it = v.unstable_erase(v.begin());
+        ASSERT_EQ(it, v.begin());
+        ASSERT_EQ(v, std::initializer_list<T>({4, 1, 2, 3}));
+    }
+    {
+        auto it = v.unstable_erase(v.end() - 1);
+        ASSERT_EQ(it, v.end());
+        ASSERT_EQ(v, std::initializer_list<T>({4, 1, 2}));
+    }
+    {
+        auto it = v.unstable_erase(v.begin() + 1);
+        ASSERT_EQ(it, v.begin() + 1);
+        ASSERT_EQ(v, std::initializer_list<T>({4, 2}));
+    }
+}
+
+bool is_odd(int i) noexcept {
+    return i % 2 != 0;
+}
+
+template<class T>
+void test_unstable_erase_if_impl(::testing::Test*) {
+    {
+        vector<T> v{0, 1, 2, 3, 4, 5, 6, 7, 9};
+        ASSERT_EQ(v.unstable_erase_if(is_odd), 5);
+        ASSERT_EQ(v, std::initializer_list<T>({0, 6, 2, 4}));
+    }
+    {
+        vector<T> v{1, 3, 5};
+        ASSERT_EQ(v.unstable_erase_if(is_odd), 3);
+        ASSERT_TRUE(v.empty());
+    }
+}
+
+template<class T>
+void test_erase_if_impl(::testing::Test*) {
+    {
+        vector<T> v{0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 13, 14};
+        ASSERT_EQ(ciel::erase_if(v, is_odd), 7);
+        ASSERT_EQ(v, std::initializer_list<T>({0, 2, 4, 6, 10, 14}));
+    }
+    {
+        vector<T> v{1, 3, 5};
+        ASSERT_EQ(ciel::erase_if(v, is_odd), 3);
+        ASSERT_TRUE(v.empty());
+    }
+    {
+        vector<T> v{0, 2, 4};
+        ASSERT_EQ(ciel::erase_if(v, is_odd), 0);
+        ASSERT_EQ(v, std::initializer_list<T>({0, 2, 4}));
+    }
+}
+
 } // namespace
 
+TEST(vector, unstable_erase) {
+    test_unstable_erase_impl<int>(this);
+    test_unstable_erase_impl<Int>(this);
+    test_unstable_erase_impl<TRInt>(this);
+    test_unstable_erase_impl<TMInt>(this);
+}
+
+TEST(vector, unstable_erase_if) {
+    test_unstable_erase_if_impl<int>(this);
+    test_unstable_erase_if_impl<Int>(this);
+    test_unstable_erase_if_impl<TRInt>(this);
+    test_unstable_erase_if_impl<TMInt>(this);
+}
+
+TEST(vector, erase_if) {
+    test_erase_if_impl<int>(this);
+    test_erase_if_impl<Int>(this);
+    test_erase_if_impl<TRInt>(this);
+    test_erase_if_impl<TMInt>(this);
+}
+
 TEST(vector, erase) {
     test_erase_impl<int>(this);
     test_erase_impl<Int>(this);
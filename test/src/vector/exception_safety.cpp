@@ -3,9 +3,11 @@
 #  include <gtest/gtest.h>
 
 #  include <ciel/test/exception_generator.hpp>
+#  include <ciel/test/int_wrapper.hpp>
 #  include <ciel/vector.hpp>
 
 #  include <cstddef>
+#  include <initializer_list>
 
 using namespace ciel;
 
@@ -574,4 +576,25 @@ TEST(vector_exception_safety, resize_N_gt_capacity) {
     } catch (...) {}
 }
 
+TEST(vector_exception_safety, erase_if_predicate_throws) {
+    vector<TRInt> v{0, 1, 2, 3, 4, 5, 6, 7};
+    size_t calls = 0;
+
+    try {
+        ciel::erase_if(v, [&calls](const TRInt& i) {
+            if (++calls == 6) {
+                throw 1;
+            }
+
+            return i == 1 || i == 2 || i == 4;
+        });
+
+        ASSERT_TRUE(false);
+
+    } catch (...) {
+        // Erased elements before the throw are gone, others are kept in order.
+        ASSERT_EQ(v, std::initializer_list<TRInt>({0, 3, 5, 6, 7}));
+    }
+}
+
 #endif
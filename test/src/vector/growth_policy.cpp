@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <ciel/growth_policy.hpp>
+#include <ciel/test/int_wrapper.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+
+using namespace ciel;
+
+namespace {
+
+template<class C>
+void test_growth_policy_capacities_impl(::testing::Test*, std::initializer_list<size_t> expected) {
+    C v;
+    size_t cap = v.capacity();
+    auto it    = expected.begin();
+
+    for (int i = 0; i < 100 && it != expected.end(); ++i) {
+        v.emplace_back(i);
+
+        if (v.capacity() != cap) {
+            cap = v.capacity();
+            ASSERT_EQ(cap, *it);
+            ++it;
+        }
+    }
+
+    ASSERT_EQ(it, expected.end());
+
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) {
+        ASSERT_EQ(v[i], i);
+    }
+}
+
+} // namespace
+
+TEST(vector, growth_policy_2x) {
+    ASSERT_EQ(growth_policy_2x::recommend(0, 1, 100, 4), 1);
+    ASSERT_EQ(growth_policy_2x::recommend(4, 5, 100, 4), 8);
+    ASSERT_EQ(growth_policy_2x::recommend(4, 20, 100, 4), 20);
+    ASSERT_EQ(growth_policy_2x::recommend(60, 61, 100, 4), 100);
+
+    test_growth_policy_capacities_impl<vector<int>>(this, {1, 2, 4, 8, 16, 32});
+    test_growth_policy_capacities_impl<vector<TRInt, std::allocator<TRInt>, growth_policy_2x>>(this,
+                                                                                              {1, 2, 4, 8, 16, 32});
+}
+
+TEST(vector, growth_policy_1_5x) {
+    ASSERT_EQ(growth_policy_1_5x::recommend(0, 1, 100, 4), 1);
+    ASSERT_EQ(growth_policy_1_5x::recommend(1, 2, 100, 4), 2);
+    ASSERT_EQ(growth_policy_1_5x::recommend(4, 5, 100, 4), 6);
+    ASSERT_EQ(growth_policy_1_5x::recommend(4, 20, 100, 4), 20);
+    ASSERT_EQ(growth_policy_1_5x::recommend(66, 67, 100, 4), 100);
+
+    test_growth_policy_capacities_impl<vector<int, std::allocator<int>, growth_policy_1_5x>>(
+        this, {1, 2, 3, 4, 6, 9, 13, 19, 28});
+    test_growth_policy_capacities_impl<vector<Int, std::allocator<Int>, growth_policy_1_5x>>(
+        this, {1, 2, 3, 4, 6, 9, 13, 19, 28});
+}
+
+TEST(vector, growth_policy_size_class) {
+    ASSERT_EQ(growth_policy_size_class::round_up(1), 16);
+    ASSERT_EQ(growth_policy_size_class::round_up(16), 16);
+    ASSERT_EQ(growth_policy_size_class::round_up(17), 32);
+    ASSERT_EQ(growth_policy_size_class::round_up(128), 128);
+    ASSERT_EQ(growth_policy_size_class::round_up(129), 160);
+    ASSERT_EQ(growth_policy_size_class::round_up(256), 256);
+    ASSERT_EQ(growth_policy_size_class::round_up(257), 320);
+    ASSERT_EQ(growth_policy_size_class::round_up(4097), 5120);
+
+    // 1.5x of 40 ints is 240 bytes, which is rounded up to the 256 bytes size class.
+    ASSERT_EQ(growth_policy_size_class::recommend(40, 41, 1000, 4), 64);
+    // Never go beyond max_size.
+    ASSERT_EQ(growth_policy_size_class::recommend(40, 41, 62, 4), 62);
+    // Never go below new_size.
+    ASSERT_EQ(growth_policy_size_class::recommend(0, 3, 1000, 24), 3);
+
+    test_growth_policy_capacities_impl<vector<int, std::allocator<int>, growth_policy_size_class>>(
+        this, {4, 8, 12, 20, 32, 48, 80, 128});
+}
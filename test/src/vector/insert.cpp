@@ -400,6 +400,68 @@ void test_insert_iterator_range_impl(::testing::Test*) {
     }
 }
 
+template<class C>
+void test_insert_batch_impl(::testing::Test*) {
+    using T = typename C::value_type;
+
+    // expansion, duplicate positions, at begin() and end()
+    {
+        C v{0, 1, 2, 3, 4};
+        v.shrink_to_fit();
+
+        const vector<size_t> positions{0, 2, 2, 5};
+        const vector<T> values{T(10), T(11), T(12), T(13)};
+
+        v.insert_batch(positions, values);
+        ASSERT_EQ(v, std::initializer_list<T>({10, 0, 1, 11, 12, 2, 3, 4, 13}));
+    }
+    // no expansion
+    {
+        C v{0, 1, 2, 3, 4};
+        v.reserve(10);
+        const auto old_data = v.data();
+
+        const std::array<size_t, 3> positions{1, 3, 4};
+        std::array<T, 3> values{T(10), T(11), T(12)};
+
+        v.insert_batch(positions, std::move(values));
+        ASSERT_EQ(v, std::initializer_list<T>({0, 10, 1, 2, 11, 3, 12, 4}));
+        ASSERT_EQ(v.data(), old_data);
+    }
+    // empty
+    {
+        C v;
+        v.insert_batch(vector<size_t>{0, 0}, std::initializer_list<T>({T(1), T(2)}));
+        ASSERT_EQ(v, std::initializer_list<T>({1, 2}));
+
+        v.insert_batch(vector<size_t>{}, std::initializer_list<T>({}));
+        ASSERT_EQ(v, std::initializer_list<T>({1, 2}));
+    }
+    // same as inserting one by one
+    {
+        C v;
+        C expected;
+        for (int i = 0; i < 100; ++i) {
+            v.emplace_back(i);
+            expected.emplace_back(i);
+        }
+
+        vector<size_t> positions;
+        vector<T> values;
+        for (size_t i = 0; i <= 100; i += 7) {
+            positions.emplace_back(i);
+            values.emplace_back(static_cast<int>(1000 + i));
+        }
+
+        for (size_t i = positions.size(); i > 0; --i) {
+            expected.insert(expected.begin() + positions[i - 1], values[i - 1]);
+        }
+
+        v.insert_batch(positions, values);
+        ASSERT_EQ(v, expected);
+    }
+}
+
 } // namespace
 
 TEST(vector, insert_size_value) {
@@ -515,3 +577,15 @@ TEST(vector, insert_iterator_range) {
     test_insert_iterator_range_impl<vector<TRInt, fancy_allocator<TRInt>>, TRInt*>(this);
     test_insert_iterator_range_impl<vector<TMInt, fancy_allocator<TMInt>>, TMInt*>(this);
 }
+
+TEST(vector, insert_batch) {
+    test_insert_batch_impl<vector<int>>(this);
+    test_insert_batch_impl<vector<Int>>(this);
+    test_insert_batch_impl<vector<TRInt>>(this);
+    test_insert_batch_impl<vector<TMInt>>(this);
+
+    test_insert_batch_impl<vector<int, fancy_allocator<int>>>(this);
+    test_insert_batch_impl<vector<Int, fancy_allocator<Int>>>(this);
+    test_insert_batch_impl<vector<TRInt, fancy_allocator<TRInt>>>(this);
+    test_insert_batch_impl<vector<TMInt, fancy_allocator<TMInt>>>(this);
+}
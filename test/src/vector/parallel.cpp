@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <ciel/parallel_policy.hpp>
+#include <ciel/vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+using namespace ciel;
+
+namespace {
+
+// Large enough to be split across threads.
+constexpr size_t N = (size_t{1} << 20) + 123;
+
+struct Pod {
+    uint32_t a;
+    uint16_t b;
+};
+
+} // namespace
+
+TEST(vector, parallel_construct) {
+    for (size_t threads = 0; threads < 5; ++threads) {
+        {
+            const vector<uint64_t> v(parallel_policy{threads}, N, 42);
+            ASSERT_EQ(v.size(), N);
+            for (size_t i = 0; i < N; ++i) {
+                ASSERT_EQ(v[i], 42);
+            }
+        }
+        {
+            vector<uint32_t> v1(N);
+            for (size_t i = 0; i < N; ++i) {
+                v1[i] = static_cast<uint32_t>(i);
+            }
+
+            const vector<uint32_t> v2(parallel_policy{threads}, v1);
+            ASSERT_EQ(v1, v2);
+        }
+        {
+            const vector<Pod> v(parallel_policy{threads}, 1000, Pod{1, 2});
+            ASSERT_EQ(v.size(), 1000);
+            ASSERT_EQ(v.back().a, 1);
+            ASSERT_EQ(v.back().b, 2);
+        }
+    }
+
+    const vector<int> v(parallel_policy{4}, 0, 1);
+    ASSERT_TRUE(v.empty());
+}
+
+TEST(vector, parallel_assign) {
+    vector<uint64_t> v{1, 2, 3};
+
+    v.assign(parallel_policy{4}, N, v[1]);
+    ASSERT_EQ(v.size(), N);
+    for (size_t i = 0; i < N; ++i) {
+        ASSERT_EQ(v[i], 2);
+    }
+
+    v.assign(parallel_policy{4}, 5, 7);
+    ASSERT_EQ(v, std::initializer_list<uint64_t>({7, 7, 7, 7, 7}));
+
+    vector<uint64_t> src(N);
+    for (size_t i = 0; i < N; ++i) {
+        src[i] = i;
+    }
+
+    v.assign(parallel_policy{4}, src.data(), src.data() + src.size());
+    ASSERT_EQ(v, src);
+
+    // Overlapping with itself.
+    v.assign(parallel_policy{4}, v.data() + 1, v.data() + 4);
+    ASSERT_EQ(v, std::initializer_list<uint64_t>({1, 2, 3}));
+}
@@ -4,6 +4,9 @@
 #include <ciel/test/int_wrapper.hpp>
 #include <ciel/vector.hpp>
 
+#include <cstddef>
+#include <initializer_list>
+
 using namespace ciel;
 
 namespace {
@@ -111,3 +114,40 @@ TEST(vector, resize_self_value) {
     test_resize_self_value_impl<vector<TRInt, fancy_allocator<TRInt>>>(this);
     test_resize_self_value_impl<vector<TMInt, fancy_allocator<TMInt>>>(this);
 }
+
+TEST(vector, resize_default_init) {
+    vector<int> v{0, 1, 2};
+
+    v.resize(100, default_init);
+    ASSERT_EQ(v.size(), 100);
+    ASSERT_EQ(v[0], 0);
+    ASSERT_EQ(v[1], 1);
+    ASSERT_EQ(v[2], 2);
+
+    v.resize(2, default_init);
+    ASSERT_EQ(v, std::initializer_list<int>({0, 1}));
+}
+
+TEST(vector, resize_and_overwrite) {
+    vector<char> v{'a', 'b'};
+
+    v.resize_and_overwrite(100, [](char* p, size_t n) {
+        EXPECT_EQ(n, 100);
+        EXPECT_EQ(p[0], 'a');
+        EXPECT_EQ(p[1], 'b');
+
+        p[2] = 'c';
+        p[3] = 'd';
+        return 4;
+    });
+    ASSERT_EQ(v, std::initializer_list<char>({'a', 'b', 'c', 'd'}));
+    ASSERT_GE(v.capacity(), 100);
+
+    v.resize_and_overwrite(3, [](char* p, size_t n) {
+        EXPECT_EQ(n, 3);
+
+        p[0] = 'x';
+        return n;
+    });
+    ASSERT_EQ(v, std::initializer_list<char>({'x', 'b', 'c'}));
+}